@@ -1,5 +1,6 @@
 #include "../panel/backends/ilxqttaskbarabstractbackend.h"
 
+#include <QImage>
 
 ILXQtTaskbarAbstractBackend::ILXQtTaskbarAbstractBackend(QObject *parent)
     : QObject(parent)
@@ -7,6 +8,25 @@ ILXQtTaskbarAbstractBackend::ILXQtTaskbarAbstractBackend(QObject *parent)
 
 }
 
+QByteArray ILXQtTaskbarAbstractBackend::getApplicationIconData(WId) const
+{
+    return QByteArray();
+}
+
+bool ILXQtTaskbarAbstractBackend::supportsWindowThumbnails() const
+{
+    return false;
+}
+
+void ILXQtTaskbarAbstractBackend::watchWindowThumbnail(WId, bool)
+{
+}
+
+QImage ILXQtTaskbarAbstractBackend::getWindowThumbnail(WId, const QSize &)
+{
+    return QImage();
+}
+
 void ILXQtTaskbarAbstractBackend::moveApplicationToPrevNextDesktop(WId windowId, bool next)
 {
     int count = getWorkspacesCount();
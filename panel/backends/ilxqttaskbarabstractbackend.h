@@ -6,6 +6,8 @@
 #include "lxqttaskbartypes.h"
 
 class QIcon;
+class QImage;
+class QSize;
 class QScreen;
 
 class ILXQtTaskbarAbstractBackend : public QObject
@@ -79,6 +81,22 @@ public:
     virtual bool isShowingDesktop() const = 0;
     virtual bool showDesktop(bool value) = 0;
 
+    // Optional, declared after the others to keep the vtable layout of the
+    // existing backends
+
+    // Undecoded icon of the window in the _NET_WM_ICON layout (width, height and
+    // width * height ARGB32 pixels, repeated for every size), so that it can be
+    // decoded on a worker thread. Empty if only getApplicationIcon() is supported.
+    virtual QByteArray getApplicationIconData(WId windowId) const;
+
+    // Window thumbnails, optional. Only watched windows are captured, and
+    // windowThumbnailChanged() is emitted (at a bounded rate) when their
+    // contents change. Calls to watchWindowThumbnail() can be nested.
+    virtual bool supportsWindowThumbnails() const;
+    virtual void watchWindowThumbnail(WId windowId, bool watch);
+    // Scaled to fit maxSize (device pixels). May be null, e.g. for a window never mapped.
+    virtual QImage getWindowThumbnail(WId windowId, const QSize &maxSize);
+
 signals:
     void reloaded();
 
@@ -86,6 +104,9 @@ signals:
     void windowAdded(WId windowId);
     void windowRemoved(WId windowId);
     void windowPropertyChanged(WId windowId, int prop);
+    // All the properties changed in an event loop iteration, as a mask of
+    // windowPropertyFlag(), see LXQtTaskBarPendingProperties
+    void windowPropertiesChanged(WId windowId, int props);
 
     // Workspaces
     void workspacesCountChanged();
@@ -94,6 +115,8 @@ signals:
 
     // TODO: needed?
     void activeWindowChanged(WId windowId);
+
+    void windowThumbnailChanged(WId windowId);
 };
 
 #endif // ILXQTTASKBARABSTRACTBACKEND_H
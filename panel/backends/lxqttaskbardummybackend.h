@@ -67,22 +67,6 @@ public:
     // Show Destop
     bool isShowingDesktop() const override;
     bool showDesktop(bool value) override;
-
-signals:
-    void reloaded();
-
-    // Windows
-    void windowAdded(WId windowId);
-    void windowRemoved(WId windowId);
-    void windowPropertyChanged(WId windowId, int prop);
-
-    // Workspaces
-    void workspacesCountChanged();
-    void workspaceNameChanged(int idx);
-    void currentWorkspaceChanged(int idx);
-
-    // TODO: needed?
-    void activeWindowChanged(WId windowId);
 };
 
 #endif // LXQTTASKBARDUMMYBACKEND_H
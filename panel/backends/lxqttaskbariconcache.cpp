@@ -0,0 +1,183 @@
+#include "lxqttaskbariconcache.h"
+
+#include "ilxqttaskbarabstractbackend.h"
+
+#include <LXQt/Settings>
+#include <XdgIcon>
+
+#include <QPixmap>
+
+#include <cstring>
+#include <utility>
+
+namespace
+{
+// Picks the smallest image not smaller than devicePixels (the largest one
+// otherwise) out of the _NET_WM_ICON data and scales it to devicePixels.
+// Runs on the worker thread: QImage only, no QPixmap.
+QImage decodeIcon(const QByteArray &data, int devicePixels)
+{
+    const quint32 *words = reinterpret_cast<const quint32 *>(data.constData());
+    const qint64 count = data.size() / qint64(sizeof(quint32));
+
+    const quint32 *best = nullptr;
+    qint64 bestWidth = 0;
+    qint64 bestHeight = 0;
+    for (qint64 i = 0; i + 2 <= count; )
+    {
+        const qint64 width = words[i];
+        const qint64 height = words[i + 1];
+        if (width == 0 || height == 0 || width * height > count - i - 2)
+            break; // malformed
+
+        const bool better = !best
+                            || (bestWidth < devicePixels ? width > bestWidth
+                                                         : width >= devicePixels && width < bestWidth);
+        if (better)
+        {
+            best = words + i + 2;
+            bestWidth = width;
+            bestHeight = height;
+        }
+        i += 2 + width * height;
+    }
+    if (!best)
+        return QImage();
+
+    QImage image(bestWidth, bestHeight, QImage::Format_ARGB32);
+    if (image.isNull())
+        return QImage();
+    for (qint64 y = 0; y < bestHeight; ++y)
+        std::memcpy(image.scanLine(y), best + y * bestWidth, bestWidth * sizeof(quint32));
+
+    if (bestWidth != devicePixels || bestHeight != devicePixels)
+        image = image.scaled(devicePixels, devicePixels, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    return image;
+}
+}
+
+LXQtTaskBarIconCache::LXQtTaskBarIconCache(ILXQtTaskbarAbstractBackend *backend, QObject *parent)
+    : QObject(parent)
+    , m_backend(backend)
+{
+    // decoding is cheap, one thread keeps the order of the updates
+    m_pool.setMaxThreadCount(1);
+
+    // connected before the buttons are created, so it's cleared before they update
+    connect(LXQt::Settings::globalSettings(), &LXQt::GlobalSettings::iconThemeChanged, this, [this] {
+        m_classIcons.clear();
+    });
+}
+
+LXQtTaskBarIconCache::~LXQtTaskBarIconCache()
+{
+    // the jobs post their results to this object
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+QIcon LXQtTaskBarIconCache::windowIcon(WId windowId, int devicePixels, bool byClass)
+{
+    if (byClass)
+    {
+        const QString windowClass = m_backend->getWindowClass(windowId).toLower();
+        auto it = m_classIcons.find(windowClass);
+        if (it == m_classIcons.end())
+            it = m_classIcons.insert(windowClass, XdgIcon::fromTheme(windowClass));
+        if (!it->isNull())
+            return *it;
+    }
+
+    WindowIcon &entry = m_windows[windowId];
+    if (entry.upToDate && entry.devicePixels == devicePixels)
+        return entry.icon;
+
+    entry.upToDate = true;
+    entry.devicePixels = devicePixels;
+
+    const QByteArray data = m_backend->getApplicationIconData(windowId);
+    if (data.isEmpty())
+    {
+        // the backend can't provide the raw data, ask for the icon itself
+        releaseKey(std::exchange(entry.key, IconKey()));
+        entry.icon = m_backend->getApplicationIcon(windowId, devicePixels);
+        return entry.icon;
+    }
+
+    const IconKey key(data, devicePixels);
+    if (key == entry.key)
+        return entry.icon; // the same icon was set again
+
+    const IconKey oldKey = std::exchange(entry.key, key);
+    releaseKey(oldKey);
+
+    auto decoded = m_decoded.constFind(key);
+    if (decoded != m_decoded.cend())
+    {
+        entry.icon = *decoded;
+        return entry.icon;
+    }
+
+    if (!m_pending.contains(key))
+    {
+        m_pending.insert(key);
+        m_pool.start([this, key, data] {
+            const QImage image = decodeIcon(data, key.second);
+            QMetaObject::invokeMethod(this, [this, key, image] { iconDecoded(key, image); }, Qt::QueuedConnection);
+        });
+    }
+    // keep the previous icon until the new one is ready
+    return entry.icon;
+}
+
+void LXQtTaskBarIconCache::invalidate(WId windowId)
+{
+    auto it = m_windows.find(windowId);
+    if (it != m_windows.end())
+        it->upToDate = false;
+}
+
+void LXQtTaskBarIconCache::removeWindow(WId windowId)
+{
+    auto it = m_windows.find(windowId);
+    if (it == m_windows.end())
+        return;
+    const IconKey key = it->key;
+    m_windows.erase(it);
+    releaseKey(key);
+}
+
+void LXQtTaskBarIconCache::iconDecoded(IconKey key, const QImage &image)
+{
+    m_pending.remove(key);
+
+    QList<WId> windows;
+    for (auto it = m_windows.cbegin(), it_end = m_windows.cend(); it != it_end; ++it)
+    {
+        if (it->key == key)
+            windows.append(it.key());
+    }
+    if (windows.isEmpty())
+        return; // the icon changed again meanwhile
+
+    // QPixmap can be created only on the GUI thread
+    const QIcon icon = image.isNull() ? QIcon() : QIcon(QPixmap::fromImage(image));
+    m_decoded.insert(key, icon);
+    for (const WId windowId : std::as_const(windows))
+    {
+        WindowIcon &entry = m_windows[windowId];
+        entry.icon = icon.isNull() ? m_backend->getApplicationIcon(windowId, key.second) : icon;
+        emit iconChanged(windowId);
+    }
+}
+
+void LXQtTaskBarIconCache::releaseKey(IconKey key)
+{
+    // drop the pixmap once no window uses it
+    for (const WindowIcon &entry : std::as_const(m_windows))
+    {
+        if (entry.key == key)
+            return;
+    }
+    m_decoded.remove(key);
+}
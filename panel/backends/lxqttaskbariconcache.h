@@ -0,0 +1,73 @@
+#ifndef LXQTTASKBARICONCACHE_H
+#define LXQTTASKBARICONCACHE_H
+
+#include <QObject>
+#include <QHash>
+#include <QIcon>
+#include <QImage>
+#include <QSet>
+#include <QThreadPool>
+
+#include "lxqttaskbartypes.h"
+
+class ILXQtTaskbarAbstractBackend;
+
+/**
+ * \brief Window icons shared by all the buttons of the taskbar.
+ *
+ * The icon of a window is identified by its undecoded data
+ * (ILXQtTaskbarAbstractBackend::getApplicationIconData()) and the requested
+ * device pixels: windows with the same icon, e.g. all the buttons of a group,
+ * share one pixmap, and an application re-setting the same icon costs just
+ * a comparison. The data is decoded and scaled on a worker thread; meanwhile the
+ * previous icon of the window is returned and iconChanged() is emitted once
+ * the new one is ready.
+ */
+class LXQtTaskBarIconCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit LXQtTaskBarIconCache(ILXQtTaskbarAbstractBackend *backend, QObject *parent = nullptr);
+    ~LXQtTaskBarIconCache();
+
+    /**
+     * \brief Returns the icon of the window, the theme icon of its class first
+     * if \p byClass is set. May be null (no icon or still being decoded).
+     */
+    QIcon windowIcon(WId windowId, int devicePixels, bool byClass);
+
+    // The icon or the class of the window changed
+    void invalidate(WId windowId);
+    void removeWindow(WId windowId);
+
+signals:
+    void iconChanged(WId windowId);
+
+private:
+    // icon data (shared, not copied), device pixels
+    typedef QPair<QByteArray, int> IconKey;
+
+    struct WindowIcon
+    {
+        IconKey key;
+        int devicePixels = 0;
+        bool upToDate = false;
+        QIcon icon; //!< the previous icon while the current one is decoded
+    };
+
+    void iconDecoded(IconKey key, const QImage &image);
+    void releaseKey(IconKey key);
+
+private:
+    ILXQtTaskbarAbstractBackend *m_backend;
+
+    QHash<WId, WindowIcon> m_windows;
+    QHash<IconKey, QIcon> m_decoded;
+    QSet<IconKey> m_pending;
+    QHash<QString, QIcon> m_classIcons;
+
+    QThreadPool m_pool;
+};
+
+#endif // LXQTTASKBARICONCACHE_H
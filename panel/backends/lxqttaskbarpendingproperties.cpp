@@ -0,0 +1,30 @@
+#include "lxqttaskbarpendingproperties.h"
+#include "ilxqttaskbarabstractbackend.h"
+
+#include <QTimer>
+
+LXQtTaskBarPendingProperties::LXQtTaskBarPendingProperties(ILXQtTaskbarAbstractBackend *backend)
+    : m_backend(backend)
+{
+    // no changes of a removed window
+    QObject::connect(m_backend, &ILXQtTaskbarAbstractBackend::windowRemoved, m_backend, [this] (WId windowId) {
+        m_properties.remove(windowId);
+    });
+}
+
+void LXQtTaskBarPendingProperties::notify(WId windowId, LXQtTaskBarWindowProperty prop)
+{
+    emit m_backend->windowPropertyChanged(windowId, int(prop));
+
+    // merge the changes of the window until the next event loop iteration
+    if (m_properties.isEmpty())
+        QTimer::singleShot(0, m_backend, [this] { flush(); });
+    m_properties[windowId] |= windowPropertyFlag(prop);
+}
+
+void LXQtTaskBarPendingProperties::flush()
+{
+    const QHash<WId, int> pending = std::exchange(m_properties, {});
+    for (auto it = pending.cbegin(), it_end = pending.cend(); it != it_end; ++it)
+        emit m_backend->windowPropertiesChanged(it.key(), it.value());
+}
@@ -0,0 +1,33 @@
+#ifndef LXQTTASKBARPENDINGPROPERTIES_H
+#define LXQTTASKBARPENDINGPROPERTIES_H
+
+#include <QHash>
+
+#include "lxqttaskbartypes.h"
+
+class ILXQtTaskbarAbstractBackend;
+
+/**
+ * \brief Merges the property changes of the windows of a backend until the
+ * next event loop iteration, then emits
+ * ILXQtTaskbarAbstractBackend::windowPropertiesChanged() once per window.
+ *
+ * A member of the backends rather than of ILXQtTaskbarAbstractBackend, whose
+ * header is installed: its layout doesn't change.
+ */
+class LXQtTaskBarPendingProperties
+{
+public:
+    explicit LXQtTaskBarPendingProperties(ILXQtTaskbarAbstractBackend *backend);
+
+    // Emits windowPropertyChanged() and queues the property for windowPropertiesChanged()
+    void notify(WId windowId, LXQtTaskBarWindowProperty prop);
+
+private:
+    void flush();
+
+    ILXQtTaskbarAbstractBackend *m_backend;
+    QHash<WId, int> m_properties;
+};
+
+#endif // LXQTTASKBARPENDINGPROPERTIES_H
@@ -0,0 +1,252 @@
+#include "lxqttaskbarsyntheticbackend.h"
+
+LXQtTaskBarSyntheticBackend::LXQtTaskBarSyntheticBackend(QObject *parent)
+    : LXQtTaskBarDummyBackend(parent)
+    , m_nextWindowId(1)
+    , m_activeWindow(0)
+    , m_workspacesCount(1) // Fake 1 workspace
+    , m_currentWorkspace(1)
+    , m_pendingProperties(this)
+{
+
+}
+
+
+/************************************************
+ *   Synthetic windows
+ ************************************************/
+WId LXQtTaskBarSyntheticBackend::addWindow(const QString &windowClass, const QString &title, const QByteArray &iconData)
+{
+    const WId windowId = m_nextWindowId++;
+
+    Window &window = m_windowInfo[windowId];
+    window.title = title;
+    window.windowClass = windowClass;
+    window.iconData = iconData;
+    window.workspace = m_currentWorkspace;
+    m_windows.append(windowId);
+
+    emit windowAdded(windowId);
+    return windowId;
+}
+
+void LXQtTaskBarSyntheticBackend::removeWindow(WId windowId)
+{
+    if (!m_windowInfo.remove(windowId))
+        return;
+    m_windows.removeOne(windowId);
+
+    if (m_activeWindow == windowId)
+    {
+        m_activeWindow = 0;
+        emit activeWindowChanged(m_activeWindow);
+    }
+    emit windowRemoved(windowId);
+}
+
+void LXQtTaskBarSyntheticBackend::setWindowTitle(WId windowId, const QString &title)
+{
+    auto it = m_windowInfo.find(windowId);
+    if (it == m_windowInfo.end() || it->title == title)
+        return;
+    it->title = title;
+    m_pendingProperties.notify(windowId, LXQtTaskBarWindowProperty::Title);
+}
+
+void LXQtTaskBarSyntheticBackend::setWindowClass(WId windowId, const QString &windowClass)
+{
+    auto it = m_windowInfo.find(windowId);
+    if (it == m_windowInfo.end() || it->windowClass == windowClass)
+        return;
+    it->windowClass = windowClass;
+    m_pendingProperties.notify(windowId, LXQtTaskBarWindowProperty::WindowClass);
+}
+
+void LXQtTaskBarSyntheticBackend::setWindowIconData(WId windowId, const QByteArray &iconData)
+{
+    auto it = m_windowInfo.find(windowId);
+    if (it == m_windowInfo.end())
+        return;
+    it->iconData = iconData;
+    m_pendingProperties.notify(windowId, LXQtTaskBarWindowProperty::Icon);
+}
+
+void LXQtTaskBarSyntheticBackend::setWindowUrgency(WId windowId, bool urgency)
+{
+    auto it = m_windowInfo.find(windowId);
+    if (it == m_windowInfo.end() || it->urgency == urgency)
+        return;
+    it->urgency = urgency;
+    m_pendingProperties.notify(windowId, LXQtTaskBarWindowProperty::Urgency);
+}
+
+void LXQtTaskBarSyntheticBackend::setWorkspacesCount(int count)
+{
+    count = qMax(1, count);
+    if (count == m_workspacesCount)
+        return;
+    m_workspacesCount = count;
+    m_currentWorkspace = qMin(m_currentWorkspace, count);
+    emit workspacesCountChanged();
+}
+
+
+/************************************************
+ *   Windows function
+ ************************************************/
+bool LXQtTaskBarSyntheticBackend::reloadWindows()
+{
+    // the windows are known already
+    emit reloaded();
+    return true;
+}
+
+QVector<WId> LXQtTaskBarSyntheticBackend::getCurrentWindows() const
+{
+    return m_windows;
+}
+
+QString LXQtTaskBarSyntheticBackend::getWindowTitle(WId windowId) const
+{
+    return m_windowInfo.value(windowId).title;
+}
+
+bool LXQtTaskBarSyntheticBackend::applicationDemandsAttention(WId windowId) const
+{
+    return m_windowInfo.value(windowId).urgency;
+}
+
+QByteArray LXQtTaskBarSyntheticBackend::getApplicationIconData(WId windowId) const
+{
+    return m_windowInfo.value(windowId).iconData;
+}
+
+QString LXQtTaskBarSyntheticBackend::getWindowClass(WId windowId) const
+{
+    return m_windowInfo.value(windowId).windowClass;
+}
+
+LXQtTaskBarWindowLayer LXQtTaskBarSyntheticBackend::getWindowLayer(WId windowId) const
+{
+    return m_windowInfo.value(windowId).layer;
+}
+
+bool LXQtTaskBarSyntheticBackend::setWindowLayer(WId windowId, LXQtTaskBarWindowLayer layer)
+{
+    auto it = m_windowInfo.find(windowId);
+    if (it == m_windowInfo.end())
+        return false;
+    it->layer = layer;
+    return true;
+}
+
+LXQtTaskBarWindowState LXQtTaskBarSyntheticBackend::getWindowState(WId windowId) const
+{
+    return m_windowInfo.value(windowId).state;
+}
+
+bool LXQtTaskBarSyntheticBackend::setWindowState(WId windowId, LXQtTaskBarWindowState state, bool set)
+{
+    auto it = m_windowInfo.find(windowId);
+    if (it == m_windowInfo.end())
+        return false;
+
+    const LXQtTaskBarWindowState newState = set ? state : LXQtTaskBarWindowState::Normal;
+    if (it->state != newState)
+    {
+        it->state = newState;
+        m_pendingProperties.notify(windowId, LXQtTaskBarWindowProperty::State);
+    }
+    return true;
+}
+
+bool LXQtTaskBarSyntheticBackend::isWindowActive(WId windowId) const
+{
+    return windowId != 0 && windowId == m_activeWindow;
+}
+
+bool LXQtTaskBarSyntheticBackend::raiseWindow(WId windowId, bool onCurrentWorkSpace)
+{
+    auto it = m_windowInfo.find(windowId);
+    if (it == m_windowInfo.end())
+        return false;
+
+    if (onCurrentWorkSpace && it->workspace != m_currentWorkspace)
+        setWindowOnWorkspace(windowId, m_currentWorkspace);
+    setWindowState(windowId, LXQtTaskBarWindowState::Minimized, false);
+
+    // on top of the stacking order
+    m_windows.removeOne(windowId);
+    m_windows.append(windowId);
+
+    if (m_activeWindow != windowId)
+    {
+        m_activeWindow = windowId;
+        emit activeWindowChanged(m_activeWindow);
+    }
+    return true;
+}
+
+bool LXQtTaskBarSyntheticBackend::closeWindow(WId windowId)
+{
+    if (!m_windowInfo.contains(windowId))
+        return false;
+    removeWindow(windowId);
+    return true;
+}
+
+WId LXQtTaskBarSyntheticBackend::getActiveWindow() const
+{
+    return m_activeWindow;
+}
+
+
+/************************************************
+ *   Workspaces
+ ************************************************/
+int LXQtTaskBarSyntheticBackend::getWorkspacesCount() const
+{
+    return m_workspacesCount;
+}
+
+int LXQtTaskBarSyntheticBackend::getCurrentWorkspace() const
+{
+    return m_currentWorkspace;
+}
+
+bool LXQtTaskBarSyntheticBackend::setCurrentWorkspace(int idx)
+{
+    if (idx < 1 || idx > m_workspacesCount)
+        return false;
+    if (idx != m_currentWorkspace)
+    {
+        m_currentWorkspace = idx;
+        emit currentWorkspaceChanged(m_currentWorkspace);
+    }
+    return true;
+}
+
+int LXQtTaskBarSyntheticBackend::getWindowWorkspace(WId windowId) const
+{
+    auto it = m_windowInfo.constFind(windowId);
+    return it == m_windowInfo.cend() ? 0 : it->workspace;
+}
+
+bool LXQtTaskBarSyntheticBackend::setWindowOnWorkspace(WId windowId, int idx)
+{
+    auto it = m_windowInfo.find(windowId);
+    if (it == m_windowInfo.end() || idx < int(LXQtTaskBarWorkspace::ShowOnAll) || idx > m_workspacesCount)
+        return false;
+    if (it->workspace != idx)
+    {
+        it->workspace = idx;
+        m_pendingProperties.notify(windowId, LXQtTaskBarWindowProperty::Workspace);
+    }
+    return true;
+}
+
+bool LXQtTaskBarSyntheticBackend::isWindowOnScreen(QScreen *, WId windowId) const
+{
+    // synthetic windows are everywhere
+    return m_windowInfo.contains(windowId);
+}
@@ -0,0 +1,92 @@
+#ifndef LXQTTASKBARSYNTHETICBACKEND_H
+#define LXQTTASKBARSYNTHETICBACKEND_H
+
+#include "lxqttaskbardummybackend.h"
+#include "lxqttaskbarpendingproperties.h"
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+/**
+ * \brief Scriptable synthetic window manager, for lxqt-panel-taskbar-bench
+ * and the taskbar tests.
+ *
+ * The windows created with addWindow() behave like real ones and every change
+ * is announced like the real backends do (see TaskBarBenchmark).
+ */
+class LXQtTaskBarSyntheticBackend : public LXQtTaskBarDummyBackend
+{
+    Q_OBJECT
+
+public:
+    explicit LXQtTaskBarSyntheticBackend(QObject *parent = nullptr);
+
+    // Synthetic windows
+    WId addWindow(const QString &windowClass, const QString &title, const QByteArray &iconData = QByteArray());
+    void removeWindow(WId windowId);
+    void setWindowTitle(WId windowId, const QString &title);
+    void setWindowClass(WId windowId, const QString &windowClass);
+    void setWindowIconData(WId windowId, const QByteArray &iconData);
+    void setWindowUrgency(WId windowId, bool urgency);
+    void setWorkspacesCount(int count);
+
+    // Windows
+    bool reloadWindows() override;
+
+    QVector<WId> getCurrentWindows() const override;
+
+    QString getWindowTitle(WId windowId) const override;
+
+    bool applicationDemandsAttention(WId windowId) const override;
+
+    QByteArray getApplicationIconData(WId windowId) const override;
+
+    QString getWindowClass(WId windowId) const override;
+
+    LXQtTaskBarWindowLayer getWindowLayer(WId windowId) const override;
+    bool setWindowLayer(WId windowId, LXQtTaskBarWindowLayer layer) override;
+
+    LXQtTaskBarWindowState getWindowState(WId windowId) const override;
+    bool setWindowState(WId windowId, LXQtTaskBarWindowState state, bool set = true) override;
+
+    bool isWindowActive(WId windowId) const override;
+    bool raiseWindow(WId windowId, bool onCurrentWorkSpace) override;
+
+    bool closeWindow(WId windowId) override;
+
+    WId getActiveWindow() const override;
+
+    // Workspaces
+    int getWorkspacesCount() const override;
+
+    int getCurrentWorkspace() const override;
+    bool setCurrentWorkspace(int idx) override;
+
+    int getWindowWorkspace(WId windowId) const override;
+    bool setWindowOnWorkspace(WId windowId, int idx) override;
+
+    bool isWindowOnScreen(QScreen *screen, WId windowId) const override;
+
+private:
+    struct Window
+    {
+        QString title;
+        QString windowClass;
+        QByteArray iconData;
+        LXQtTaskBarWindowState state = LXQtTaskBarWindowState::Normal;
+        LXQtTaskBarWindowLayer layer = LXQtTaskBarWindowLayer::Normal;
+        int workspace = 1;
+        bool urgency = false;
+    };
+
+    QVector<WId> m_windows; //!< in stacking order
+    QHash<WId, Window> m_windowInfo;
+    WId m_nextWindowId;
+    WId m_activeWindow;
+    int m_workspacesCount;
+    int m_currentWorkspace;
+    LXQtTaskBarPendingProperties m_pendingProperties;
+};
+
+#endif // LXQTTASKBARSYNTHETICBACKEND_H
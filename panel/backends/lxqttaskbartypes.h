@@ -29,6 +29,12 @@ enum class LXQtTaskBarWindowProperty
     Workspace
 };
 
+// Bit of a property in the mask of ILXQtTaskbarAbstractBackend::windowPropertiesChanged()
+constexpr int windowPropertyFlag(LXQtTaskBarWindowProperty prop)
+{
+    return 1 << int(prop);
+}
+
 enum class LXQtTaskBarWindowState
 {
     Hidden = 0,
@@ -0,0 +1,129 @@
+#include "lxqttaskmodel.h"
+
+#include "ilxqttaskbarabstractbackend.h"
+#include "lxqttaskbariconcache.h"
+
+namespace
+{
+constexpr int AllProperties = windowPropertyFlag(LXQtTaskBarWindowProperty::Title)
+                              | windowPropertyFlag(LXQtTaskBarWindowProperty::WindowClass)
+                              | windowPropertyFlag(LXQtTaskBarWindowProperty::State)
+                              | windowPropertyFlag(LXQtTaskBarWindowProperty::Urgency)
+                              | windowPropertyFlag(LXQtTaskBarWindowProperty::Workspace);
+}
+
+LXQtTaskModel::LXQtTaskModel(ILXQtTaskbarAbstractBackend *backend, QObject *parent)
+    : QObject(parent)
+    , m_backend(backend)
+    , m_iconCache(new LXQtTaskBarIconCache(backend, this))
+{
+    Q_ASSERT(m_backend);
+
+    connect(m_backend, &ILXQtTaskbarAbstractBackend::windowAdded, this, &LXQtTaskModel::onWindowAdded);
+    connect(m_backend, &ILXQtTaskbarAbstractBackend::windowRemoved, this, &LXQtTaskModel::onWindowRemoved);
+    connect(m_backend, &ILXQtTaskbarAbstractBackend::windowPropertiesChanged, this, &LXQtTaskModel::onWindowPropertiesChanged);
+
+    const QVector<WId> windows = m_backend->getCurrentWindows();
+    m_windows.reserve(windows.size());
+    for (const WId windowId : windows)
+    {
+        m_windows.append(windowId);
+        update(windowId, m_records[windowId], AllProperties);
+    }
+}
+
+LXQtTaskModel::~LXQtTaskModel() = default;
+
+QString LXQtTaskModel::title(WId windowId) const
+{
+    return m_records.value(windowId).title;
+}
+
+QString LXQtTaskModel::windowClass(WId windowId) const
+{
+    return m_records.value(windowId).windowClass;
+}
+
+bool LXQtTaskModel::demandsAttention(WId windowId) const
+{
+    return m_records.value(windowId).demandsAttention;
+}
+
+int LXQtTaskModel::workspace(WId windowId) const
+{
+    return m_records.value(windowId).workspace;
+}
+
+bool LXQtTaskModel::isMinimized(WId windowId) const
+{
+    return m_records.value(windowId).minimized;
+}
+
+bool LXQtTaskModel::matches(WId windowId, const Filter &filter) const
+{
+    auto it = m_records.constFind(windowId);
+    if (it == m_records.cend())
+        return false;
+
+    if (filter.workspaceOnly
+        && it->workspace != (0 == filter.workspace ? m_backend->getCurrentWorkspace() : filter.workspace))
+    {
+        return false;
+    }
+    if (filter.minimizedOnly && !it->minimized)
+        return false;
+    // depends on the geometry, which is not kept here
+    if (filter.screen && !m_backend->isWindowOnScreen(filter.screen, windowId))
+        return false;
+    return true;
+}
+
+void LXQtTaskModel::onWindowAdded(WId windowId)
+{
+    if (m_records.contains(windowId))
+        return;
+
+    m_windows.append(windowId);
+    update(windowId, m_records[windowId], AllProperties);
+    emit windowAdded(windowId);
+}
+
+void LXQtTaskModel::onWindowRemoved(WId windowId)
+{
+    if (!m_records.remove(windowId))
+        return;
+
+    m_windows.removeOne(windowId);
+    m_iconCache->removeWindow(windowId);
+    emit windowRemoved(windowId);
+}
+
+void LXQtTaskModel::onWindowPropertiesChanged(WId windowId, int props)
+{
+    auto it = m_records.find(windowId);
+    if (it == m_records.end())
+        return;
+
+    update(windowId, *it, props);
+
+    // Icon of the button can be based on windowClass
+    if (props & (windowPropertyFlag(LXQtTaskBarWindowProperty::Icon) | windowPropertyFlag(LXQtTaskBarWindowProperty::WindowClass)))
+        m_iconCache->invalidate(windowId);
+
+    emit windowChanged(windowId, props);
+}
+
+void LXQtTaskModel::update(WId windowId, Record &record, int props) const
+{
+    if (props & windowPropertyFlag(LXQtTaskBarWindowProperty::Title))
+        record.title = m_backend->getWindowTitle(windowId);
+    if (props & windowPropertyFlag(LXQtTaskBarWindowProperty::WindowClass))
+        record.windowClass = m_backend->getWindowClass(windowId);
+    if (props & (windowPropertyFlag(LXQtTaskBarWindowProperty::State) | windowPropertyFlag(LXQtTaskBarWindowProperty::Urgency)))
+    {
+        record.demandsAttention = m_backend->applicationDemandsAttention(windowId);
+        record.minimized = m_backend->getWindowState(windowId) == LXQtTaskBarWindowState::Minimized;
+    }
+    if (props & windowPropertyFlag(LXQtTaskBarWindowProperty::Workspace))
+        record.workspace = m_backend->getWindowWorkspace(windowId);
+}
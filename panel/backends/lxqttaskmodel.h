@@ -0,0 +1,91 @@
+#ifndef LXQTTASKMODEL_H
+#define LXQTTASKMODEL_H
+
+#include <QObject>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include "lxqttaskbartypes.h"
+
+class QScreen;
+class ILXQtTaskbarAbstractBackend;
+class LXQtTaskBarIconCache;
+
+/**
+ * \brief The windows shown by the taskbars, shared by all the panels.
+ *
+ * It subscribes once to the window signals of the backend and keeps the
+ * properties the taskbars read most (title, class, urgency, workspace,
+ * minimized state) and the window icons (LXQtTaskBarIconCache), so that the
+ * taskbar instances read them from here instead of querying and decoding
+ * them each on its own. Each taskbar is a filtered view of the model (see
+ * Filter and matches()).
+ *
+ * The properties are refreshed and the icon is invalidated before
+ * windowChanged() is emitted.
+ */
+class LXQtTaskModel : public QObject
+{
+    Q_OBJECT
+
+public:
+    //! Which windows a taskbar shows
+    struct Filter
+    {
+        bool workspaceOnly = false;
+        int workspace = 0; //!< 0 means the current one
+        QScreen *screen = nullptr; //!< only the windows on this screen, if set
+        bool minimizedOnly = false;
+    };
+
+    explicit LXQtTaskModel(ILXQtTaskbarAbstractBackend *backend, QObject *parent = nullptr);
+    ~LXQtTaskModel();
+
+    ILXQtTaskbarAbstractBackend *backend() const { return m_backend; }
+    LXQtTaskBarIconCache *iconCache() const { return m_iconCache; }
+
+    //! In the order they were added
+    const QVector<WId> &windows() const { return m_windows; }
+    bool contains(WId windowId) const { return m_records.contains(windowId); }
+
+    QString title(WId windowId) const;
+    QString windowClass(WId windowId) const;
+    bool demandsAttention(WId windowId) const;
+    int workspace(WId windowId) const;
+    bool isMinimized(WId windowId) const;
+
+    bool matches(WId windowId, const Filter &filter) const;
+
+signals:
+    void windowAdded(WId windowId);
+    void windowRemoved(WId windowId);
+    //! \param props mask of windowPropertyFlag()
+    void windowChanged(WId windowId, int props);
+
+private slots:
+    void onWindowAdded(WId windowId);
+    void onWindowRemoved(WId windowId);
+    void onWindowPropertiesChanged(WId windowId, int props);
+
+private:
+    struct Record
+    {
+        QString title;
+        QString windowClass;
+        int workspace = 0;
+        bool demandsAttention = false;
+        bool minimized = false;
+    };
+
+    void update(WId windowId, Record &record, int props) const;
+
+private:
+    ILXQtTaskbarAbstractBackend *m_backend;
+    LXQtTaskBarIconCache *m_iconCache;
+
+    QVector<WId> m_windows;
+    QHash<WId, Record> m_records;
+};
+
+#endif // LXQTTASKMODEL_H
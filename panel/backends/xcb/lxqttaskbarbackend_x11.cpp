@@ -18,11 +18,15 @@
 
 LXQtTaskbarX11Backend::LXQtTaskbarX11Backend(QObject *parent)
     : ILXQtTaskbarAbstractBackend(parent)
+    , m_overlapIndexValid(false)
+    , m_iconGeometriesQueued(false)
+    , m_pendingProperties(this)
 {
     auto *x11Application = qGuiApp->nativeInterface<QNativeInterface::QX11Application>();
     Q_ASSERT_X(x11Application, "LXQtTaskbarX11Backend", "Constructed without X11 connection");
     m_X11Display = x11Application->display();
     m_xcbConnection = x11Application->connection();
+    m_windowCache.reset(new LXQtX11WindowCache(m_xcbConnection));
 
     connect(KX11Extras::self(), &KX11Extras::windowChanged, this, &LXQtTaskbarX11Backend::onWindowChanged);
     connect(KX11Extras::self(), &KX11Extras::windowAdded, this, &LXQtTaskbarX11Backend::onWindowAdded);
@@ -39,7 +43,19 @@ LXQtTaskbarX11Backend::LXQtTaskbarX11Backend(QObject *parent)
  ************************************************/
 void LXQtTaskbarX11Backend::onWindowChanged(WId windowId, NET::Properties prop, NET::Properties2 prop2)
 {
-    if(!m_windows.contains(windowId))
+    // drop the stale properties before anyone reads them again
+    m_windowCache->invalidate(windowId, LXQtX11WindowCache::changedProperties(prop, prop2));
+    if ((prop & (NET::WMWindowType | NET::WMState)) || (prop2 & NET::WM2TransientFor))
+        m_acceptedWindows.remove(windowId);
+    // keep the overlap index up to date (only once it's used), before the
+    // signals below make the taskbar ask about the overlaps
+    if (m_overlapIndexValid
+        && (prop & (NET::WMGeometry | NET::WMFrameExtents | NET::WMDesktop | NET::WMState | NET::WMWindowType)))
+    {
+        updateOverlapInfo(windowId);
+    }
+
+    if(!m_windowSet.contains(windowId))
     {
         // If already known window changes its property in a way
         // it's now acceptable, add it again to taskbar
@@ -58,27 +74,27 @@ void LXQtTaskbarX11Backend::onWindowChanged(WId windowId, NET::Properties prop,
 
     if (prop.testFlag(NET::WMGeometry))
     {
-        emit windowPropertyChanged(windowId, int(LXQtTaskBarWindowProperty::Geometry));
+        m_pendingProperties.notify(windowId, LXQtTaskBarWindowProperty::Geometry);
     }
 
     if (prop2.testFlag(NET::WM2WindowClass))
     {
-        emit windowPropertyChanged(windowId, int(LXQtTaskBarWindowProperty::WindowClass));
+        m_pendingProperties.notify(windowId, LXQtTaskBarWindowProperty::WindowClass);
     }
 
     // window changed virtual desktop
     if (prop.testFlag(NET::WMDesktop) || prop.testFlag(NET::WMGeometry))
     {
-        emit windowPropertyChanged(windowId, int(LXQtTaskBarWindowProperty::Workspace));
+        m_pendingProperties.notify(windowId, LXQtTaskBarWindowProperty::Workspace);
     }
 
     if (prop.testFlag(NET::WMVisibleName) || prop.testFlag(NET::WMName))
-        emit windowPropertyChanged(windowId, int(LXQtTaskBarWindowProperty::Title));
+        m_pendingProperties.notify(windowId, LXQtTaskBarWindowProperty::Title);
 
     // XXX: we are setting window icon geometry -> don't need to handle NET::WMIconGeometry
     // Icon of the button can be based on windowClass
     if (prop.testFlag(NET::WMIcon) || prop2.testFlag(NET::WM2WindowClass))
-        emit windowPropertyChanged(windowId, int(LXQtTaskBarWindowProperty::Icon));
+        m_pendingProperties.notify(windowId, LXQtTaskBarWindowProperty::Icon);
 
     bool update_urgency = false;
     if (prop2.testFlag(NET::WM2Urgency))
@@ -90,31 +106,46 @@ void LXQtTaskbarX11Backend::onWindowChanged(WId windowId, NET::Properties prop,
     {
         update_urgency = true;
 
-        emit windowPropertyChanged(windowId, int(LXQtTaskBarWindowProperty::State));
+        m_pendingProperties.notify(windowId, LXQtTaskBarWindowProperty::State);
     }
 
     if (update_urgency)
-        emit windowPropertyChanged(windowId, int(LXQtTaskBarWindowProperty::Urgency));
+        m_pendingProperties.notify(windowId, LXQtTaskBarWindowProperty::Urgency);
 }
 
 void LXQtTaskbarX11Backend::onWindowAdded(WId windowId)
 {
-    if(m_windows.contains(windowId))
+    if (m_overlapIndexValid)
+        updateOverlapInfo(windowId);
+
+    if(m_windowSet.contains(windowId))
         return;
 
     if (!acceptWindow(windowId))
         return;
 
+    // the taskbar reads most of them right away, get them with a single round-trip
+    m_windowCache->fetch({windowId});
     addWindow_internal(windowId);
 }
 
 void LXQtTaskbarX11Backend::onWindowRemoved(WId windowId)
 {
-    const int row = m_windows.indexOf(windowId);
-    if(row == -1)
+    // the window is gone (not just unaccepted): forget it before the signal
+    // below makes the taskbar ask about the overlaps
+    if (!KX11Extras::hasWId(windowId))
+    {
+        m_overlapIndex.remove(windowId);
+        m_windowCache->remove(windowId);
+        m_acceptedWindows.remove(windowId);
+        if (m_thumbnailer)
+            m_thumbnailer->remove(windowId);
+    }
+
+    if(!m_windowSet.remove(windowId))
         return;
 
-    m_windows.removeAt(row);
+    m_windows.removeOne(windowId);
 
     emit windowRemoved(windowId);
 }
@@ -123,6 +154,14 @@ void LXQtTaskbarX11Backend::onWindowRemoved(WId windowId)
  *   Model private functions
  ************************************************/
 bool LXQtTaskbarX11Backend::acceptWindow(WId windowId) const
+{
+    auto it = m_acceptedWindows.constFind(windowId);
+    if (it == m_acceptedWindows.cend())
+        it = m_acceptedWindows.insert(windowId, isWindowAcceptable(windowId));
+    return *it;
+}
+
+bool LXQtTaskbarX11Backend::isWindowAcceptable(WId windowId) const
 {
     QFlags<NET::WindowTypeMask> ignoreList;
     ignoreList |= NET::DesktopMask;
@@ -164,10 +203,57 @@ bool LXQtTaskbarX11Backend::acceptWindow(WId windowId) const
 void LXQtTaskbarX11Backend::addWindow_internal(WId windowId, bool emitAdded)
 {
     m_windows.append(windowId);
+    m_windowSet.insert(windowId);
     if(emitAdded)
         emit windowAdded(windowId);
 }
 
+void LXQtTaskbarX11Backend::buildOverlapIndex() const
+{
+    m_overlapIndex.clear();
+    const auto wIds = KX11Extras::windows();
+    for (auto const wId : wIds)
+        updateOverlapInfo(wId);
+    m_overlapIndexValid = true;
+}
+
+void LXQtTaskbarX11Backend::updateOverlapInfo(WId windowId) const
+{
+    QFlags<NET::WindowTypeMask> ignoreList;
+    ignoreList |= NET::DesktopMask;
+    ignoreList |= NET::DockMask;
+    ignoreList |= NET::SplashMask;
+    ignoreList |= NET::MenuMask;
+    ignoreList |= NET::PopupMenuMask;
+    ignoreList |= NET::DropdownMenuMask;
+    ignoreList |= NET::TopMenuMask;
+    ignoreList |= NET::NotificationMask;
+
+    KWindowInfo info(windowId, NET::WMWindowType | NET::WMState | NET::WMFrameExtents | NET::WMDesktop);
+    if (!info.valid())
+    {
+        m_overlapIndex.remove(windowId);
+        return;
+    }
+
+    OverlapInfo &entry = m_overlapIndex[windowId];
+    entry.frameGeometry = info.frameGeometry();
+    entry.desktop = info.desktop();
+    entry.ignored = (info.state() & (NET::Shaded | NET::Hidden))
+                    || NET::typeMatchesMask(info.windowType(NET::AllTypesMask), ignoreList);
+}
+
+LXQtX11WindowThumbnailer *LXQtTaskbarX11Backend::thumbnailer() const
+{
+    if (!m_thumbnailer)
+    {
+        m_thumbnailer.reset(new LXQtX11WindowThumbnailer(m_xcbConnection));
+        connect(m_thumbnailer.get(), &LXQtX11WindowThumbnailer::thumbnailChanged,
+                this, &ILXQtTaskbarAbstractBackend::windowThumbnailChanged);
+    }
+    return m_thumbnailer.get();
+}
+
 
 /************************************************
  *   Windows function
@@ -225,27 +311,42 @@ bool LXQtTaskbarX11Backend::reloadWindows()
 {
     QVector<WId> oldWindows;
     qSwap(oldWindows, m_windows);
+    QSet<WId> oldWindowSet;
+    qSwap(oldWindowSet, m_windowSet);
 
-    // Just add new windows to groups, deleting is up to the groups
+    // Only the windows never seen before are queried, the decisions
+    // about the others are still valid (see onWindowChanged())
+    QVector<WId> accepted;
     const auto x11windows = KX11Extras::stackingOrder();
+    const QSet<WId> stackedWindows(x11windows.cbegin(), x11windows.cend());
     for (auto const windowId: x11windows)
     {
         if (acceptWindow(windowId))
-        {
-            bool emitAdded = !oldWindows.contains(windowId);
-            addWindow_internal(windowId, emitAdded);
-        }
+            accepted.append(windowId);
+    }
+
+    // forget the windows which disappeared without windowRemoved()
+    m_acceptedWindows.removeIf([&stackedWindows] (const QHash<WId, bool>::iterator it) {
+        return !stackedWindows.contains(it.key());
+    });
+
+    // Load the properties of all windows at once, instead of
+    // a round-trip per property when the buttons are created
+    m_windowCache->fetch(accepted);
+
+    // Just add new windows to groups, deleting is up to the groups
+    for (auto const windowId: std::as_const(accepted))
+    {
+        bool emitAdded = !oldWindowSet.contains(windowId);
+        addWindow_internal(windowId, emitAdded);
     }
 
     //emulate windowRemoved if known window not reported by KWindowSystem
     for (auto i = oldWindows.begin(), i_e = oldWindows.end(); i != i_e; i++)
     {
         WId windowId = *i;
-        if (!m_windows.contains(windowId))
-        {
-            //TODO: more efficient method?
+        if (!m_windowSet.contains(windowId))
             emit windowRemoved(windowId);
-        }
     }
 
     //TODO: refreshPlaceholderVisibility()
@@ -261,16 +362,13 @@ QVector<WId> LXQtTaskbarX11Backend::getCurrentWindows() const
 
 QString LXQtTaskbarX11Backend::getWindowTitle(WId windowId) const
 {
-    KWindowInfo info(windowId, NET::WMVisibleName | NET::WMName);
-    QString title = info.visibleName().isEmpty() ? info.name() : info.visibleName();
-    return title;
+    return m_windowCache->title(windowId);
 }
 
 bool LXQtTaskbarX11Backend::applicationDemandsAttention(WId windowId) const
 {
-    WId appRootWindow = XDefaultRootWindow(m_X11Display);
-    return NETWinInfo(m_xcbConnection, windowId, appRootWindow, NET::Properties{}, NET::WM2Urgency).urgency()
-           || KWindowInfo{windowId, NET::WMState}.hasState(NET::DemandsAttention);
+    return m_windowCache->urgency(windowId)
+           || m_windowCache->state(windowId).testFlag(NET::DemandsAttention);
 }
 
 QIcon LXQtTaskbarX11Backend::getApplicationIcon(WId windowId, int devicePixels) const
@@ -278,15 +376,34 @@ QIcon LXQtTaskbarX11Backend::getApplicationIcon(WId windowId, int devicePixels)
     return KX11Extras::icon(windowId, devicePixels, devicePixels);
 }
 
+QByteArray LXQtTaskbarX11Backend::getApplicationIconData(WId windowId) const
+{
+    return m_windowCache->iconData(windowId);
+}
+
+bool LXQtTaskbarX11Backend::supportsWindowThumbnails() const
+{
+    return thumbnailer()->isSupported();
+}
+
+void LXQtTaskbarX11Backend::watchWindowThumbnail(WId windowId, bool watch)
+{
+    thumbnailer()->watch(windowId, watch);
+}
+
+QImage LXQtTaskbarX11Backend::getWindowThumbnail(WId windowId, const QSize &maxSize)
+{
+    return thumbnailer()->thumbnail(windowId, maxSize);
+}
+
 QString LXQtTaskbarX11Backend::getWindowClass(WId windowId) const
 {
-    KWindowInfo info(windowId, NET::Properties(), NET::WM2WindowClass);
-    return QString::fromUtf8(info.windowClassClass());
+    return m_windowCache->windowClass(windowId);
 }
 
 LXQtTaskBarWindowLayer LXQtTaskbarX11Backend::getWindowLayer(WId windowId) const
 {
-    NET::States state = KWindowInfo(windowId, NET::WMState).state();
+    NET::States state = m_windowCache->state(windowId);
     if(state.testFlag(NET::KeepAbove))
         return LXQtTaskBarWindowLayer::KeepAbove;
     else if(state.testFlag(NET::KeepBelow))
@@ -319,11 +436,10 @@ bool LXQtTaskbarX11Backend::setWindowLayer(WId windowId, LXQtTaskBarWindowLayer
 
 LXQtTaskBarWindowState LXQtTaskbarX11Backend::getWindowState(WId windowId) const
 {
-    KWindowInfo info(windowId,NET::WMState | NET::XAWMState);
-    if(info.isMinimized())
+    if(m_windowCache->isMinimized(windowId))
         return LXQtTaskBarWindowState::Minimized;
 
-    NET::States state = info.state();
+    NET::States state = m_windowCache->state(windowId);
     if(state.testFlag(NET::Hidden))
         return LXQtTaskBarWindowState::Hidden;
     if(state.testFlag(NET::Max))
@@ -413,7 +529,7 @@ bool LXQtTaskbarX11Backend::raiseWindow(WId windowId, bool onCurrentWorkSpace)
     KX11Extras::forceActiveWindow(windowId);
 
     // Clear urgency flag
-    emit windowPropertyChanged(windowId, int(LXQtTaskBarWindowProperty::Urgency));
+    m_pendingProperties.notify(windowId, LXQtTaskBarWindowProperty::Urgency);
 
     return true;
 }
@@ -460,8 +576,7 @@ bool LXQtTaskbarX11Backend::setCurrentWorkspace(int idx)
 
 int LXQtTaskbarX11Backend::getWindowWorkspace(WId windowId) const
 {
-    KWindowInfo info(windowId, NET::WMDesktop);
-    return info.desktop();
+    return m_windowCache->desktop(windowId);
 }
 
 bool LXQtTaskbarX11Backend::setWindowOnWorkspace(WId windowId, int idx)
@@ -524,8 +639,7 @@ bool LXQtTaskbarX11Backend::isWindowOnScreen(QScreen *screen, WId windowId) cons
     if(!screen)
         return true;
 
-    QRect r = KWindowInfo(windowId, NET::WMFrameExtents).frameGeometry();
-    return screen->geometry().intersects(r);
+    return screen->geometry().intersects(m_windowCache->frameGeometry(windowId));
 }
 
 bool LXQtTaskbarX11Backend::setDesktopLayout(Qt::Orientation orientation, int rows, int columns, bool rightToLeft)
@@ -591,58 +705,38 @@ void LXQtTaskbarX11Backend::refreshIconGeometry(WId windowId, QRect const & geom
     // NOTE: This function announces where the task icon is,
     // such that X11 WMs can perform their related animations correctly.
 
-    WId appRootWindow = XDefaultRootWindow(m_X11Display);
-
-    NETWinInfo info(m_xcbConnection,
-                    windowId,
-                    appRootWindow,
-                    NET::WMIconGeometry,
-                    NET::Properties2());
-    NETRect const curr = info.iconGeometry();
-
     // see kwindowsystem -> NETWinInfo::setIconGeometry for the scale factor
     const qreal scaleFactor = qApp->devicePixelRatio();
-    int xPos = geom.x() * scaleFactor;
-    int yPos = geom.y() * scaleFactor;
-    int w = geom.width() * scaleFactor;
-    int h = geom.height() * scaleFactor;
-    if (xPos == curr.pos.x && yPos == curr.pos.y && w == curr.size.width && h == curr.size.height)
-        return;
-    NETRect nrect;
-    nrect.pos.x = geom.x();
-    nrect.pos.y = geom.y();
-    nrect.size.height = geom.height();
-    nrect.size.width = geom.width();
-    info.setIconGeometry(nrect);
+    const QRect deviceGeom(int(geom.x() * scaleFactor), int(geom.y() * scaleFactor),
+                           int(geom.width() * scaleFactor), int(geom.height() * scaleFactor));
+
+    // Unchanged geometries cost nothing. The taskbar refreshes all its
+    // buttons at once, so the changed ones are sent together afterwards.
+    if (m_windowCache->setIconGeometry(windowId, deviceGeom) && !m_iconGeometriesQueued)
+    {
+        m_iconGeometriesQueued = true;
+        QTimer::singleShot(0, this, [this] {
+            m_iconGeometriesQueued = false;
+            m_windowCache->publishIconGeometries();
+        });
+    }
 }
 
 bool LXQtTaskbarX11Backend::isAreaOverlapped(const QRect &area) const
 {
-    //TODO: reuse our m_windows cache?
-    QFlags<NET::WindowTypeMask> ignoreList;
-    ignoreList |= NET::DesktopMask;
-    ignoreList |= NET::DockMask;
-    ignoreList |= NET::SplashMask;
-    ignoreList |= NET::MenuMask;
-    ignoreList |= NET::PopupMenuMask;
-    ignoreList |= NET::DropdownMenuMask;
-    ignoreList |= NET::TopMenuMask;
-    ignoreList |= NET::NotificationMask;
+    if (!m_overlapIndexValid)
+        buildOverlapIndex();
 
-    const auto wIds = KX11Extras::stackingOrder();
-    for (auto const wId : wIds)
+    const int currentDesktop = KX11Extras::currentDesktop();
+    for (auto it = m_overlapIndex.cbegin(), it_end = m_overlapIndex.cend(); it != it_end; ++it)
     {
-        KWindowInfo info(wId, NET::WMWindowType | NET::WMState | NET::WMFrameExtents | NET::WMDesktop);
-        if (info.valid()
+        const OverlapInfo &info = it.value();
+        if (!info.ignored
             // skip windows that are on other desktops
-            && info.isOnCurrentDesktop()
-            // skip shaded, minimized or hidden windows
-            && !(info.state() & (NET::Shaded | NET::Hidden))
-            // check against the list of ignored types
-            && !NET::typeMatchesMask(info.windowType(NET::AllTypesMask), ignoreList))
+            && (info.desktop == NET::OnAllDesktops || info.desktop == currentDesktop)
+            && info.frameGeometry.intersects(area))
         {
-            if (info.frameGeometry().intersects(area))
-                return true;
+            return true;
         }
     }
     return false;
@@ -2,6 +2,15 @@
 #define LXQTTASKBARBACKEND_X11_H
 
 #include "../ilxqttaskbarabstractbackend.h"
+#include "../lxqttaskbarpendingproperties.h"
+#include "lxqtx11windowcache.h"
+#include "lxqtx11windowthumbnailer.h"
+
+#include <QHash>
+#include <QRect>
+#include <QSet>
+
+#include <memory>
 
 //TODO: make PIMPL to forward declare NET::Properties, Display, xcb_connection_t
 #include <netwm_def.h>
@@ -26,6 +35,11 @@ public:
     virtual QString getWindowTitle(WId windowId) const override;
     virtual bool applicationDemandsAttention(WId windowId) const override;
     virtual QIcon getApplicationIcon(WId windowId, int devicePixels) const override;
+    virtual QByteArray getApplicationIconData(WId windowId) const override;
+
+    virtual bool supportsWindowThumbnails() const override;
+    virtual void watchWindowThumbnail(WId windowId, bool watch) override;
+    virtual QImage getWindowThumbnail(WId windowId, const QSize &maxSize) override;
     virtual QString getWindowClass(WId windowId) const override;
 
     virtual LXQtTaskBarWindowLayer getWindowLayer(WId windowId) const override;
@@ -77,13 +91,45 @@ private slots:
 
 private:
     bool acceptWindow(WId windowId) const;
+    bool isWindowAcceptable(WId windowId) const;
     void addWindow_internal(WId windowId, bool emitAdded = true);
 
+    // Index of all the windows (not only the taskbar ones) for isAreaOverlapped()
+    struct OverlapInfo
+    {
+        QRect frameGeometry;
+        int desktop;
+        bool ignored; //!< ignored type, shaded or hidden
+    };
+    void buildOverlapIndex() const;
+    void updateOverlapInfo(WId windowId) const;
+
+    LXQtX11WindowThumbnailer *thumbnailer() const;
+
 private:
     Display *m_X11Display;
     xcb_connection_t *m_xcbConnection;
 
     QVector<WId> m_windows;
+    QSet<WId> m_windowSet; //!< same as m_windows, for lookups
+
+    // acceptWindow() results, dropped when the window type, state or transient-for change
+    mutable QHash<WId, bool> m_acceptedWindows;
+
+    // properties of the windows, invalidated by the KX11Extras signals
+    std::unique_ptr<LXQtX11WindowCache> m_windowCache;
+
+    // created on the first use of the thumbnails
+    mutable std::unique_ptr<LXQtX11WindowThumbnailer> m_thumbnailer;
+
+    // built on the first isAreaOverlapped() call, then kept up to date by the KX11Extras signals
+    mutable QHash<WId, OverlapInfo> m_overlapIndex;
+    mutable bool m_overlapIndexValid;
+
+    // a publishIconGeometries() call is scheduled
+    bool m_iconGeometriesQueued;
+
+    LXQtTaskBarPendingProperties m_pendingProperties;
 };
 
 #endif // LXQTTASKBARBACKEND_X11_H
@@ -0,0 +1,395 @@
+#include "lxqtx11windowcache.h"
+
+#include <KX11Extras>
+#include <KWindowInfo>
+
+#include <xcb/xcb.h>
+
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace
+{
+// Indexes in LXQtX11WindowCache::m_atoms
+enum AtomIndex
+{
+    NetWmName = 0,
+    NetWmVisibleName,
+    Utf8String,
+    NetWmDesktop,
+    NetWmState,
+    WmState,
+    NetWmIcon,
+    NetWmIconGeometry,
+    FirstStateAtom
+};
+
+const char * const atomNames[] = {
+    "_NET_WM_NAME",
+    "_NET_WM_VISIBLE_NAME",
+    "UTF8_STRING",
+    "_NET_WM_DESKTOP",
+    "_NET_WM_STATE",
+    "WM_STATE",
+    "_NET_WM_ICON",
+    "_NET_WM_ICON_GEOMETRY"
+};
+
+struct StateAtom
+{
+    const char *name;
+    NET::State state;
+};
+
+// Stored in m_atoms after the atoms above, in the same order
+const StateAtom stateAtoms[] = {
+    {"_NET_WM_STATE_MODAL",             NET::Modal},
+    {"_NET_WM_STATE_STICKY",            NET::Sticky},
+    {"_NET_WM_STATE_MAXIMIZED_VERT",    NET::MaxVert},
+    {"_NET_WM_STATE_MAXIMIZED_HORZ",    NET::MaxHoriz},
+    {"_NET_WM_STATE_SHADED",            NET::Shaded},
+    {"_NET_WM_STATE_SKIP_TASKBAR",      NET::SkipTaskbar},
+    {"_NET_WM_STATE_SKIP_PAGER",        NET::SkipPager},
+    {"_NET_WM_STATE_HIDDEN",            NET::Hidden},
+    {"_NET_WM_STATE_FULLSCREEN",        NET::FullScreen},
+    {"_NET_WM_STATE_ABOVE",             NET::KeepAbove},
+    {"_NET_WM_STATE_BELOW",             NET::KeepBelow},
+    {"_NET_WM_STATE_DEMANDS_ATTENTION", NET::DemandsAttention},
+    {"_NET_WM_STATE_FOCUSED",           NET::Focused}
+};
+
+// ICCCM constants
+constexpr uint32_t IconicState = 3;
+constexpr uint32_t UrgencyHint = 1 << 8;
+
+// Maximum length (in 32 bit units) of the requested properties
+constexpr uint32_t MaxStringLength = 1024;
+constexpr uint32_t MaxAtomCount = 64;
+constexpr uint32_t MaxIconLength = 4 * 1024 * 1024;
+
+using PropertyReply = std::unique_ptr<xcb_get_property_reply_t, decltype(&std::free)>;
+
+xcb_get_property_cookie_t requestProperty(xcb_connection_t *c, WId windowId, xcb_atom_t property, xcb_atom_t type, uint32_t length)
+{
+    return xcb_get_property(c, false, static_cast<xcb_window_t>(windowId), property, type, 0, length);
+}
+
+// Returns nullptr if the window is gone or the property is not set
+PropertyReply takeReply(xcb_connection_t *c, xcb_get_property_cookie_t cookie)
+{
+    xcb_generic_error_t *error = nullptr;
+    PropertyReply reply(xcb_get_property_reply(c, cookie, &error), &std::free);
+    std::free(error);
+    if (reply && reply->type == XCB_ATOM_NONE)
+        reply.reset();
+    return reply;
+}
+
+QByteArray replyBytes(const PropertyReply &reply)
+{
+    if (!reply || reply->format != 8)
+        return QByteArray();
+    return QByteArray(static_cast<const char *>(xcb_get_property_value(reply.get())),
+                      xcb_get_property_value_length(reply.get()));
+}
+
+const uint32_t *replyWords(const PropertyReply &reply, int &count)
+{
+    count = 0;
+    if (!reply || reply->format != 32)
+        return nullptr;
+    count = xcb_get_property_value_length(reply.get()) / sizeof(uint32_t);
+    return static_cast<const uint32_t *>(xcb_get_property_value(reply.get()));
+}
+
+// Outstanding requests of a window, one field per property
+struct Cookies
+{
+    WId windowId;
+    LXQtX11WindowCache::Properties props;
+    xcb_get_property_cookie_t visibleName;
+    xcb_get_property_cookie_t netName;
+    xcb_get_property_cookie_t wmName;
+    xcb_get_property_cookie_t wmClass;
+    xcb_get_property_cookie_t netState;
+    xcb_get_property_cookie_t wmState;
+    xcb_get_property_cookie_t desktop;
+    xcb_get_property_cookie_t hints;
+};
+}
+
+LXQtX11WindowCache::LXQtX11WindowCache(xcb_connection_t *connection)
+    : m_connection(connection)
+{
+    // intern all the atoms with a single round-trip
+    QVector<xcb_intern_atom_cookie_t> cookies;
+    for (const char *name : atomNames)
+        cookies.append(xcb_intern_atom(m_connection, false, qstrlen(name), name));
+    for (const StateAtom &stateAtom : stateAtoms)
+        cookies.append(xcb_intern_atom(m_connection, false, qstrlen(stateAtom.name), stateAtom.name));
+
+    m_atoms.reserve(cookies.size());
+    for (const xcb_intern_atom_cookie_t &cookie : std::as_const(cookies))
+    {
+        xcb_intern_atom_reply_t *reply = xcb_intern_atom_reply(m_connection, cookie, nullptr);
+        m_atoms.append(reply ? reply->atom : XCB_ATOM_NONE);
+        std::free(reply);
+    }
+}
+
+void LXQtX11WindowCache::fetch(const QVector<WId> &windows, Properties props)
+{
+    props &= PipelinedProperties;
+
+    // send all the requests first...
+    QVector<Cookies> pending;
+    pending.reserve(windows.size());
+    for (const WId windowId : windows)
+    {
+        const Properties missing = props & ~m_entries.value(windowId).valid;
+        if (!missing)
+            continue;
+
+        Cookies c{};
+        c.windowId = windowId;
+        c.props = missing;
+        if (missing & Title)
+        {
+            c.visibleName = requestProperty(m_connection, windowId, m_atoms[NetWmVisibleName], m_atoms[Utf8String], MaxStringLength);
+            c.netName = requestProperty(m_connection, windowId, m_atoms[NetWmName], m_atoms[Utf8String], MaxStringLength);
+            c.wmName = requestProperty(m_connection, windowId, XCB_ATOM_WM_NAME, XCB_GET_PROPERTY_TYPE_ANY, MaxStringLength);
+        }
+        if (missing & WindowClass)
+            c.wmClass = requestProperty(m_connection, windowId, XCB_ATOM_WM_CLASS, XCB_ATOM_STRING, MaxStringLength);
+        if (missing & State)
+        {
+            c.netState = requestProperty(m_connection, windowId, m_atoms[NetWmState], XCB_ATOM_ATOM, MaxAtomCount);
+            c.wmState = requestProperty(m_connection, windowId, m_atoms[WmState], m_atoms[WmState], 2);
+        }
+        if (missing & Desktop)
+            c.desktop = requestProperty(m_connection, windowId, m_atoms[NetWmDesktop], XCB_ATOM_CARDINAL, 1);
+        if (missing & Urgency)
+            c.hints = requestProperty(m_connection, windowId, XCB_ATOM_WM_HINTS, XCB_ATOM_WM_HINTS, 9);
+        pending.append(c);
+    }
+
+    // ...then collect the replies
+    for (const Cookies &c : std::as_const(pending))
+    {
+        Entry &e = m_entries[c.windowId];
+        if (c.props & Title)
+        {
+            // same fallbacks as KWindowInfo::visibleName()
+            const QByteArray visibleName = replyBytes(takeReply(m_connection, c.visibleName));
+            const QByteArray netName = replyBytes(takeReply(m_connection, c.netName));
+            PropertyReply wmName = takeReply(m_connection, c.wmName);
+            if (!visibleName.isEmpty())
+                e.title = QString::fromUtf8(visibleName);
+            else if (!netName.isEmpty())
+                e.title = QString::fromUtf8(netName);
+            else if (wmName && wmName->type == XCB_ATOM_STRING)
+                e.title = QString::fromLatin1(replyBytes(wmName));
+            else
+                e.title = QString::fromLocal8Bit(replyBytes(wmName));
+        }
+        if (c.props & WindowClass)
+        {
+            // WM_CLASS is "instance\0class\0"
+            const QByteArray wmClass = replyBytes(takeReply(m_connection, c.wmClass));
+            const int sep = wmClass.indexOf('\0');
+            e.windowClass = sep == -1 ? QString() : QString::fromUtf8(wmClass.mid(sep + 1).constData());
+        }
+        if (c.props & State)
+        {
+            e.state = NET::States();
+            int count;
+            PropertyReply netState = takeReply(m_connection, c.netState);
+            const uint32_t *atoms = replyWords(netState, count);
+            for (int i = 0; i < count; ++i)
+            {
+                for (size_t s = 0; s < std::size(stateAtoms); ++s)
+                {
+                    if (atoms[i] == m_atoms[FirstStateAtom + s])
+                    {
+                        e.state |= stateAtoms[s].state;
+                        break;
+                    }
+                }
+            }
+
+            PropertyReply wmState = takeReply(m_connection, c.wmState);
+            const uint32_t *words = replyWords(wmState, count);
+            e.iconic = count > 0 && words[0] == IconicState;
+        }
+        if (c.props & Desktop)
+        {
+            int count;
+            PropertyReply desktop = takeReply(m_connection, c.desktop);
+            const uint32_t *words = replyWords(desktop, count);
+            // same convention as NETWinInfo::desktop()
+            if (count == 0)
+                e.desktop = 0;
+            else if (words[0] == 0xffffffff)
+                e.desktop = NET::OnAllDesktops;
+            else
+                e.desktop = words[0] + 1;
+        }
+        if (c.props & Urgency)
+        {
+            int count;
+            PropertyReply hints = takeReply(m_connection, c.hints);
+            const uint32_t *words = replyWords(hints, count);
+            e.urgency = count > 0 && (words[0] & UrgencyHint);
+        }
+        e.valid |= c.props;
+    }
+}
+
+void LXQtX11WindowCache::invalidate(WId windowId, Properties props)
+{
+    auto it = m_entries.find(windowId);
+    if (it != m_entries.end())
+        it->valid &= ~props;
+}
+
+void LXQtX11WindowCache::remove(WId windowId)
+{
+    m_entries.remove(windowId);
+    m_iconGeometries.remove(windowId);
+    m_pendingIconGeometries.remove(windowId);
+}
+
+void LXQtX11WindowCache::clear()
+{
+    m_entries.clear();
+}
+
+LXQtX11WindowCache::Properties LXQtX11WindowCache::changedProperties(NET::Properties prop, NET::Properties2 prop2)
+{
+    Properties props;
+    if (prop & (NET::WMName | NET::WMVisibleName))
+        props |= Title;
+    if (prop2 & NET::WM2WindowClass)
+        props |= WindowClass;
+    if (prop & (NET::WMState | NET::XAWMState))
+        props |= State;
+    if (prop & NET::WMDesktop)
+        props |= Desktop;
+    if (prop2 & NET::WM2Urgency)
+        props |= Urgency;
+    if (prop & (NET::WMGeometry | NET::WMFrameExtents))
+        props |= FrameGeometry;
+    return props;
+}
+
+const LXQtX11WindowCache::Entry &LXQtX11WindowCache::entry(WId windowId, Property prop)
+{
+    Entry &e = m_entries[windowId];
+    if (!(e.valid & prop))
+    {
+        if (prop == FrameGeometry)
+        {
+            e.frameGeometry = KWindowInfo(windowId, NET::WMFrameExtents).frameGeometry();
+            e.valid |= FrameGeometry;
+        }
+        else
+        {
+            fetch({windowId}, prop);
+        }
+    }
+    // fetch() may have rehashed
+    return m_entries[windowId];
+}
+
+QString LXQtX11WindowCache::title(WId windowId)
+{
+    return entry(windowId, Title).title;
+}
+
+QString LXQtX11WindowCache::windowClass(WId windowId)
+{
+    return entry(windowId, WindowClass).windowClass;
+}
+
+NET::States LXQtX11WindowCache::state(WId windowId)
+{
+    return entry(windowId, State).state;
+}
+
+bool LXQtX11WindowCache::isMinimized(WId windowId)
+{
+    // same logic as KWindowInfo::isMinimized()
+    const Entry &e = entry(windowId, State);
+    if (!e.iconic)
+        return false;
+    // NETWM 1.2 compliant WMs use NET::Hidden for minimized windows
+    if ((e.state & NET::Hidden) && !(e.state & NET::Shaded))
+        return true;
+    // older WMs use WithdrawnState for other virtual desktops
+    // and IconicState only for minimized windows
+    return !KX11Extras::icccmCompliantMappingState();
+}
+
+int LXQtX11WindowCache::desktop(WId windowId)
+{
+    // with viewports the desktop is derived from the geometry
+    if (KX11Extras::mapViewport())
+        return KWindowInfo(windowId, NET::WMDesktop).desktop();
+    return entry(windowId, Desktop).desktop;
+}
+
+bool LXQtX11WindowCache::urgency(WId windowId)
+{
+    return entry(windowId, Urgency).urgency;
+}
+
+QRect LXQtX11WindowCache::frameGeometry(WId windowId)
+{
+    return entry(windowId, FrameGeometry).frameGeometry;
+}
+
+QByteArray LXQtX11WindowCache::iconData(WId windowId)
+{
+    PropertyReply icon = takeReply(m_connection, requestProperty(m_connection, windowId, m_atoms[NetWmIcon], XCB_ATOM_CARDINAL, MaxIconLength));
+    if (!icon || icon->format != 32)
+        return QByteArray();
+    return QByteArray(static_cast<const char *>(xcb_get_property_value(icon.get())),
+                      xcb_get_property_value_length(icon.get()));
+}
+
+bool LXQtX11WindowCache::setIconGeometry(WId windowId, const QRect &geometry)
+{
+    auto published = m_iconGeometries.constFind(windowId);
+    if (published != m_iconGeometries.cend() && *published == geometry)
+    {
+        // moved back before the queued one was sent
+        m_pendingIconGeometries.remove(windowId);
+        return false;
+    }
+    m_pendingIconGeometries.insert(windowId, geometry);
+    return true;
+}
+
+void LXQtX11WindowCache::publishIconGeometries()
+{
+    if (m_pendingIconGeometries.isEmpty())
+        return;
+
+    for (auto it = m_pendingIconGeometries.cbegin(), it_end = m_pendingIconGeometries.cend(); it != it_end; ++it)
+    {
+        const QRect &geometry = it.value();
+        const uint32_t data[4] = {
+            static_cast<uint32_t>(geometry.x()),
+            static_cast<uint32_t>(geometry.y()),
+            static_cast<uint32_t>(geometry.width()),
+            static_cast<uint32_t>(geometry.height())
+        };
+        xcb_change_property(m_connection, XCB_PROP_MODE_REPLACE, static_cast<xcb_window_t>(it.key()),
+                            m_atoms[NetWmIconGeometry], XCB_ATOM_CARDINAL, 32, 4, data);
+        m_iconGeometries.insert(it.key(), geometry);
+    }
+    m_pendingIconGeometries.clear();
+    xcb_flush(m_connection);
+}
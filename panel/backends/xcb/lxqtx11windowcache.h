@@ -0,0 +1,107 @@
+#ifndef LXQTX11WINDOWCACHE_H
+#define LXQTX11WINDOWCACHE_H
+
+#include <QHash>
+#include <QRect>
+#include <QString>
+#include <QVector>
+#include <qwindowdefs.h>
+
+#include <netwm_def.h>
+
+struct xcb_connection_t;
+
+/**
+ * \brief Client-side cache of the X11 window properties read by LXQtTaskbarX11Backend.
+ *
+ * All the missing properties of a set of windows are requested at once: the xcb
+ * requests are pipelined, so loading them costs a single round-trip to the X server
+ * regardless of how many windows and properties are involved. The backend invalidates
+ * the properties reported by KX11Extras::windowChanged(), they are reloaded on the
+ * next access.
+ */
+class LXQtX11WindowCache
+{
+public:
+    enum Property
+    {
+        Title           = 0x01,
+        WindowClass     = 0x02,
+        State           = 0x04, //!< _NET_WM_STATE and WM_STATE
+        Desktop         = 0x08,
+        Urgency         = 0x10,
+        FrameGeometry   = 0x20, //!< computed by KWindowInfo, never pipelined
+        PipelinedProperties = Title | WindowClass | State | Desktop | Urgency,
+        AllProperties   = PipelinedProperties | FrameGeometry
+    };
+    Q_DECLARE_FLAGS(Properties, Property)
+
+    explicit LXQtX11WindowCache(xcb_connection_t *connection);
+
+    /**
+     * \brief Loads the missing properties of the given windows with a single round-trip.
+     * FrameGeometry is ignored, it is loaded on demand.
+     */
+    void fetch(const QVector<WId> &windows, Properties props = PipelinedProperties);
+
+    void invalidate(WId windowId, Properties props);
+    void remove(WId windowId);
+    void clear();
+
+    /**
+     * \brief Returns the cached properties which are stale after a KX11Extras::windowChanged().
+     */
+    static Properties changedProperties(NET::Properties prop, NET::Properties2 prop2);
+
+    QString title(WId windowId);
+    QString windowClass(WId windowId);
+    NET::States state(WId windowId);
+    bool isMinimized(WId windowId);
+    int desktop(WId windowId);
+    bool urgency(WId windowId);
+    QRect frameGeometry(WId windowId);
+
+    // Raw _NET_WM_ICON property, not cached (it's usually large and read once per change)
+    QByteArray iconData(WId windowId);
+
+    /**
+     * \brief Queues a new _NET_WM_ICON_GEOMETRY (in device pixels) for the window.
+     * \return false if it's the geometry published last, nothing to send then.
+     */
+    bool setIconGeometry(WId windowId, const QRect &geometry);
+
+    /**
+     * \brief Writes all the queued icon geometries, then flushes the connection once.
+     * The geometries are written blindly: nobody but the taskbar is expected to set them.
+     */
+    void publishIconGeometries();
+
+private:
+    struct Entry
+    {
+        Properties valid;
+        QString title;
+        QString windowClass;
+        NET::States state;
+        bool iconic = false;
+        int desktop = 0;
+        bool urgency = false;
+        QRect frameGeometry;
+    };
+
+    const Entry &entry(WId windowId, Property prop);
+
+    xcb_connection_t *m_connection;
+    QHash<WId, Entry> m_entries;
+
+    // Kept apart from m_entries, clear() must not make them look unpublished
+    QHash<WId, QRect> m_iconGeometries;
+    QHash<WId, QRect> m_pendingIconGeometries;
+
+    // _NET_WM_NAME, _NET_WM_VISIBLE_NAME, ... see the atom table in the .cpp
+    QVector<quint32> m_atoms;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(LXQtX11WindowCache::Properties)
+
+#endif // LXQTX11WINDOWCACHE_H
@@ -0,0 +1,322 @@
+#include "lxqtx11windowthumbnailer.h"
+
+#include <KX11Extras>
+
+#include <QCoreApplication>
+
+#include <xcb/xcb.h>
+#include <xcb/composite.h>
+#include <xcb/damage.h>
+#include <xcb/shm.h>
+
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+#include <cstdlib>
+#include <memory>
+#include <utility>
+
+namespace
+{
+// ms between two thumbnailChanged() of the damaged windows
+constexpr int RefreshInterval = 500;
+
+template <typename T>
+using XcbReply = std::unique_ptr<T, decltype(&std::free)>;
+
+template <typename T>
+XcbReply<T> makeReply(T *reply)
+{
+    return XcbReply<T>(reply, &std::free);
+}
+
+bool hasExtension(xcb_connection_t *c, xcb_extension_t *extension)
+{
+    const xcb_query_extension_reply_t *data = xcb_get_extension_data(c, extension);
+    return data && data->present;
+}
+}
+
+LXQtX11WindowThumbnailer::LXQtX11WindowThumbnailer(xcb_connection_t *connection, QObject *parent)
+    : QObject(parent)
+    , m_connection(connection)
+    , m_extensionsPresent(false)
+    , m_shmPresent(false)
+    , m_damageNotify(0)
+    , m_shmSegment(0)
+    , m_shmId(-1)
+    , m_shmAddress(nullptr)
+    , m_shmSize(0)
+{
+    m_refreshTimer.setSingleShot(true);
+    m_refreshTimer.setInterval(RefreshInterval);
+    connect(&m_refreshTimer, &QTimer::timeout, this, &LXQtX11WindowThumbnailer::refresh);
+
+    if (!hasExtension(m_connection, &xcb_composite_id) || !hasExtension(m_connection, &xcb_damage_id))
+        return;
+
+    // the versions must be negotiated before using the extensions, send all the requests at once
+    auto compositeCookie = xcb_composite_query_version(m_connection, 0, 2);
+    auto damageCookie = xcb_damage_query_version(m_connection, 1, 1);
+    const bool shm = hasExtension(m_connection, &xcb_shm_id);
+    xcb_shm_query_version_cookie_t shmCookie;
+    if (shm)
+        shmCookie = xcb_shm_query_version(m_connection);
+
+    auto composite = makeReply(xcb_composite_query_version_reply(m_connection, compositeCookie, nullptr));
+    auto damage = makeReply(xcb_damage_query_version_reply(m_connection, damageCookie, nullptr));
+    if (shm)
+        m_shmPresent = bool(makeReply(xcb_shm_query_version_reply(m_connection, shmCookie, nullptr)));
+
+    // NameWindowPixmap needs XComposite 0.2
+    m_extensionsPresent = composite && (composite->major_version > 0 || composite->minor_version >= 2) && damage;
+    if (!m_extensionsPresent)
+        return;
+
+    m_damageNotify = xcb_get_extension_data(m_connection, &xcb_damage_id)->first_event + XCB_DAMAGE_NOTIFY;
+    QCoreApplication::instance()->installNativeEventFilter(this);
+}
+
+LXQtX11WindowThumbnailer::~LXQtX11WindowThumbnailer()
+{
+    if (m_extensionsPresent)
+        QCoreApplication::instance()->removeNativeEventFilter(this);
+
+    for (const Thumbnail &thumbnail : std::as_const(m_thumbnails))
+    {
+        if (thumbnail.damage)
+            xcb_damage_destroy(m_connection, thumbnail.damage);
+    }
+    releaseSharedMemory();
+    xcb_flush(m_connection);
+}
+
+bool LXQtX11WindowThumbnailer::isSupported() const
+{
+    // without a compositing manager the top-level windows are not redirected
+    return m_extensionsPresent && KX11Extras::compositingActive();
+}
+
+void LXQtX11WindowThumbnailer::watch(WId windowId, bool watch)
+{
+    if (!m_extensionsPresent)
+        return;
+
+    if (!watch)
+    {
+        auto it = m_thumbnails.find(windowId);
+        if (it == m_thumbnails.end() || !it->damage || --it->watchers > 0)
+            return;
+        xcb_damage_destroy(m_connection, it->damage);
+        xcb_flush(m_connection);
+        m_damages.remove(it->damage);
+        m_damaged.remove(windowId);
+        it->damage = 0;
+        // changes are not tracked anymore
+        it->dirty = true;
+        return;
+    }
+
+    Thumbnail &thumbnail = m_thumbnails[windowId];
+    if (thumbnail.watchers++ > 0)
+        return;
+    if (!thumbnail.frame)
+        thumbnail.frame = topLevelWindow(static_cast<quint32>(windowId));
+
+    thumbnail.damage = xcb_generate_id(m_connection);
+    xcb_damage_create(m_connection, thumbnail.damage, thumbnail.frame, XCB_DAMAGE_REPORT_LEVEL_NON_EMPTY);
+    xcb_flush(m_connection);
+    m_damages.insert(thumbnail.damage, windowId);
+
+    // the cached thumbnail may be stale, capture it again right after
+    // the caller is done (e.g. once all the buttons of a popup are shown)
+    thumbnail.dirty = true;
+    m_damaged.insert(windowId);
+    if (!m_refreshTimer.isActive())
+        m_refreshTimer.start(0);
+}
+
+void LXQtX11WindowThumbnailer::remove(WId windowId)
+{
+    auto it = m_thumbnails.find(windowId);
+    if (it == m_thumbnails.end())
+        return;
+    // the server destroys the damage together with the window,
+    // destroying it here would raise an error in most cases
+    m_damages.remove(it->damage);
+    m_damaged.remove(windowId);
+    m_thumbnails.erase(it);
+}
+
+QImage LXQtX11WindowThumbnailer::thumbnail(WId windowId, const QSize &maxSize)
+{
+    auto it = m_thumbnails.find(windowId);
+    if (it == m_thumbnails.end() || !it->damage || !isSupported())
+        return it == m_thumbnails.end() ? QImage() : it->image;
+
+    const bool sizeChanged = !it->image.isNull()
+                             && it->image.size() != it->image.size().scaled(maxSize, Qt::KeepAspectRatio);
+    if (!it->dirty && !sizeChanged)
+        return it->image;
+
+    // re-arm the damage before reading, so that no change is lost
+    xcb_damage_subtract(m_connection, it->damage, XCB_NONE, XCB_NONE);
+    const QImage image = capture(it->frame, maxSize);
+    it->dirty = false;
+    if (!image.isNull())
+        it->image = image;
+    return it->image;
+}
+
+bool LXQtX11WindowThumbnailer::nativeEventFilter(const QByteArray &eventType, void *message, qintptr * /*result*/)
+{
+    if (eventType != "xcb_generic_event_t")
+        return false;
+
+    const xcb_generic_event_t *event = static_cast<const xcb_generic_event_t *>(message);
+    if ((event->response_type & ~0x80) != m_damageNotify)
+        return false;
+
+    const auto *notify = reinterpret_cast<const xcb_damage_notify_event_t *>(event);
+    auto damage = m_damages.constFind(notify->damage);
+    if (damage == m_damages.cend())
+        return false;
+
+    // reported once until the next xcb_damage_subtract() in thumbnail()
+    auto it = m_thumbnails.find(*damage);
+    if (it != m_thumbnails.end() && !it->dirty)
+    {
+        it->dirty = true;
+        m_damaged.insert(*damage);
+        scheduleRefresh();
+    }
+    return true;
+}
+
+void LXQtX11WindowThumbnailer::scheduleRefresh()
+{
+    if (!m_refreshTimer.isActive())
+        m_refreshTimer.start();
+}
+
+void LXQtX11WindowThumbnailer::refresh()
+{
+    m_refreshTimer.setInterval(RefreshInterval);
+    const QSet<WId> damaged = std::exchange(m_damaged, {});
+    for (const WId windowId : damaged)
+        emit thumbnailChanged(windowId);
+}
+
+QImage LXQtX11WindowThumbnailer::capture(quint32 frame, const QSize &maxSize)
+{
+    auto attributesCookie = xcb_get_window_attributes(m_connection, frame);
+    auto geometryCookie = xcb_get_geometry(m_connection, frame);
+    auto attributes = makeReply(xcb_get_window_attributes_reply(m_connection, attributesCookie, nullptr));
+    auto geometry = makeReply(xcb_get_geometry_reply(m_connection, geometryCookie, nullptr));
+
+    // unmapped windows have no pixmap, only 32 bpp visuals are handled
+    if (!attributes || attributes->map_state != XCB_MAP_STATE_VIEWABLE || !geometry
+        || (geometry->depth != 24 && geometry->depth != 32) || geometry->width == 0 || geometry->height == 0)
+    {
+        return QImage();
+    }
+
+    const xcb_pixmap_t pixmap = xcb_generate_id(m_connection);
+    if (xcb_generic_error_t *error = xcb_request_check(m_connection, xcb_composite_name_window_pixmap_checked(m_connection, frame, pixmap)))
+    {
+        // not redirected
+        std::free(error);
+        return QImage();
+    }
+
+    const int width = geometry->width;
+    const int height = geometry->height;
+    const uint size = uint(width) * uint(height) * 4;
+    const QImage::Format format = geometry->depth == 32 ? QImage::Format_ARGB32_Premultiplied : QImage::Format_RGB32;
+
+    QImage result;
+    if (uchar *data = m_shmPresent ? sharedMemory(size) : nullptr)
+    {
+        auto image = makeReply(xcb_shm_get_image_reply(m_connection,
+                                                       xcb_shm_get_image(m_connection, pixmap, 0, 0, width, height, ~0u,
+                                                                         XCB_IMAGE_FORMAT_Z_PIXMAP, m_shmSegment, 0),
+                                                       nullptr));
+        if (image)
+            result = QImage(data, width, height, width * 4, format).scaled(maxSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    else
+    {
+        auto image = makeReply(xcb_get_image_reply(m_connection,
+                                                   xcb_get_image(m_connection, XCB_IMAGE_FORMAT_Z_PIXMAP, pixmap, 0, 0, width, height, ~0u),
+                                                   nullptr));
+        if (image && uint(xcb_get_image_data_length(image.get())) >= size)
+            result = QImage(xcb_get_image_data(image.get()), width, height, width * 4, format).scaled(maxSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+
+    xcb_free_pixmap(m_connection, pixmap);
+    xcb_flush(m_connection);
+    return result;
+}
+
+quint32 LXQtX11WindowThumbnailer::topLevelWindow(quint32 window) const
+{
+    // the window manager reparents the client into its frame
+    for (;;)
+    {
+        auto tree = makeReply(xcb_query_tree_reply(m_connection, xcb_query_tree(m_connection, window), nullptr));
+        if (!tree || tree->parent == tree->root || tree->parent == XCB_WINDOW_NONE)
+            return window;
+        window = tree->parent;
+    }
+}
+
+uchar *LXQtX11WindowThumbnailer::sharedMemory(uint size)
+{
+    if (m_shmAddress && m_shmSize >= size)
+        return m_shmAddress;
+
+    releaseSharedMemory();
+
+    m_shmId = shmget(IPC_PRIVATE, size, IPC_CREAT | 0600);
+    if (m_shmId < 0)
+        return nullptr;
+
+    void *address = shmat(m_shmId, nullptr, 0);
+    if (address == reinterpret_cast<void *>(-1))
+    {
+        shmctl(m_shmId, IPC_RMID, nullptr);
+        m_shmId = -1;
+        return nullptr;
+    }
+
+    m_shmSegment = xcb_generate_id(m_connection);
+    xcb_generic_error_t *error = xcb_request_check(m_connection, xcb_shm_attach_checked(m_connection, m_shmSegment, m_shmId, false));
+    // attached or not, the segment goes away with its last user
+    shmctl(m_shmId, IPC_RMID, nullptr);
+    if (error)
+    {
+        // e.g. a remote server
+        std::free(error);
+        shmdt(address);
+        m_shmId = -1;
+        m_shmSegment = 0;
+        m_shmPresent = false;
+        return nullptr;
+    }
+
+    m_shmAddress = static_cast<uchar *>(address);
+    m_shmSize = size;
+    return m_shmAddress;
+}
+
+void LXQtX11WindowThumbnailer::releaseSharedMemory()
+{
+    if (!m_shmAddress)
+        return;
+    xcb_shm_detach(m_connection, m_shmSegment);
+    shmdt(m_shmAddress);
+    m_shmAddress = nullptr;
+    m_shmSize = 0;
+    m_shmSegment = 0;
+    m_shmId = -1;
+}
@@ -0,0 +1,83 @@
+#ifndef LXQTX11WINDOWTHUMBNAILER_H
+#define LXQTX11WINDOWTHUMBNAILER_H
+
+#include <QObject>
+#include <QAbstractNativeEventFilter>
+#include <QHash>
+#include <QImage>
+#include <QSet>
+#include <QTimer>
+#include <qwindowdefs.h>
+
+struct xcb_connection_t;
+
+/**
+ * \brief Thumbnails of the X11 windows, for LXQtTaskbarX11Backend.
+ *
+ * The contents of a window are read from its XComposite named pixmap (so a
+ * compositing manager is needed), through a MIT-SHM segment when the server
+ * supports it, and scaled down once. The result is cached per window.
+ *
+ * Only watched windows are captured: an XDamage object tracks their changes
+ * and thumbnailChanged() is emitted for the damaged ones at most once per
+ * refresh interval. A window is captured again only after it was damaged;
+ * an unmapped (e.g. minimized) window keeps its last thumbnail.
+ */
+class LXQtX11WindowThumbnailer : public QObject, public QAbstractNativeEventFilter
+{
+    Q_OBJECT
+
+public:
+    explicit LXQtX11WindowThumbnailer(xcb_connection_t *connection, QObject *parent = nullptr);
+    ~LXQtX11WindowThumbnailer();
+
+    // The extensions are available and a compositing manager is running
+    bool isSupported() const;
+
+    // Calls can be nested, the window is watched until the last watch(windowId, false)
+    void watch(WId windowId, bool watch);
+    void remove(WId windowId);
+
+    QImage thumbnail(WId windowId, const QSize &maxSize);
+
+    bool nativeEventFilter(const QByteArray &eventType, void *message, qintptr *result) override;
+
+signals:
+    void thumbnailChanged(WId windowId);
+
+private:
+    struct Thumbnail
+    {
+        quint32 frame = 0; //!< top-level ancestor, the one redirected by the compositor
+        quint32 damage = 0; //!< 0 while not watched
+        int watchers = 0; //!< e.g. the taskbars of several panels
+        bool dirty = true;
+        QImage image;
+    };
+
+    void scheduleRefresh();
+    void refresh();
+    QImage capture(quint32 frame, const QSize &maxSize);
+    quint32 topLevelWindow(quint32 window) const;
+    uchar *sharedMemory(uint size);
+    void releaseSharedMemory();
+
+private:
+    xcb_connection_t *m_connection;
+    bool m_extensionsPresent;
+    bool m_shmPresent;
+    quint8 m_damageNotify; //!< type of XDamageNotify events
+
+    QHash<WId, Thumbnail> m_thumbnails;
+    QHash<quint32, WId> m_damages; //!< damage -> window
+    QSet<WId> m_damaged; //!< waiting for the next thumbnailChanged()
+    QTimer m_refreshTimer;
+
+    // MIT-SHM segment, reused by all the captures
+    quint32 m_shmSegment;
+    int m_shmId;
+    uchar *m_shmAddress;
+    uint m_shmSize;
+};
+
+#endif // LXQTX11WINDOWTHUMBNAILER_H
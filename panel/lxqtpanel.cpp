@@ -34,8 +34,10 @@
 #include "config/configpaneldialog.h"
 #include "popupmenu.h"
 #include "plugin.h"
+#include "pluginplaceholder.h"
 #include "panelpluginsmodel.h"
 #include "windownotifier.h"
+#include "startupprofiler.h"
 #include <LXQt/PluginInfo>
 
 #include <QScreen>
@@ -304,12 +306,12 @@ LXQtPanel::LXQtPanel(const QString &configGroup, LXQt::Settings *settings, QWidg
                 mShowDelayTimer.start();
        }
     });
-    connect(wmBackend, &ILXQtTaskbarAbstractBackend::windowPropertyChanged,
-            this, [this] (WId /* id */, int prop)
+    connect(wmBackend, &ILXQtTaskbarAbstractBackend::windowPropertiesChanged,
+            this, [this] (WId /* id */, int props)
     {
         if (mHidable && mHideOnOverlap
             // when a window is moved, resized, shaded, or minimized
-            && (prop == int(LXQtTaskBarWindowProperty::Geometry) || prop == int(LXQtTaskBarWindowProperty::State)))
+            && (props & (windowPropertyFlag(LXQtTaskBarWindowProperty::Geometry) | windowPropertyFlag(LXQtTaskBarWindowProperty::State))))
         {
             if (!mHidden)
             {
@@ -327,6 +329,8 @@ LXQtPanel::LXQtPanel(const QString &configGroup, LXQt::Settings *settings, QWidg
  ************************************************/
 void LXQtPanel::readSettings()
 {
+    StartupProfiler::Span span("settings", QStringLiteral("LXQtPanel::readSettings"), mConfigGroup);
+
     // Read settings ......................................
     mSettings->beginGroup(mConfigGroup);
 
@@ -481,6 +485,8 @@ QStringList pluginDesktopDirs()
  ************************************************/
 void LXQtPanel::loadPlugins()
 {
+    StartupProfiler::Span span("plugin", QStringLiteral("LXQtPanel::loadPlugins"), mConfigGroup);
+
     QString names_key(mConfigGroup);
     names_key += QLatin1Char('/');
     names_key += QLatin1String(CFG_KEY_PLUGINS);
@@ -492,15 +498,64 @@ void LXQtPanel::loadPlugins()
     connect(mPlugins.get(), &PanelPluginsModel::pluginAdded, this, &LXQtPanel::pluginAdded);
     connect(mPlugins.get(), &PanelPluginsModel::pluginRemoved, this, &LXQtPanel::pluginRemoved);
 
-    const auto plugins = mPlugins->plugins();
-    for (auto const & plugin : plugins)
+    connect(mPlugins.get(), &PanelPluginsModel::pluginLoaded, this, &LXQtPanel::pluginLoaded);
+
+    // the plugins are loaded from the event loop, keep their slots meanwhile
+    const auto pending = mPlugins->pendingPluginNames();
+    for (auto const & name : pending)
+    {
+        mSettings->beginGroup(name);
+        const Plugin::Alignment alignment = mSettings->value(QStringLiteral("alignment")).toString().toUpper() == QLatin1String("RIGHT") ?
+                    Plugin::AlignRight :
+                    Plugin::AlignLeft;
+        const QSize sizeHint = mSettings->value(QStringLiteral("sizeHint"), QSize(mIconSize, mIconSize)).toSize();
+        PluginPlaceholder *placeholder = new PluginPlaceholder(name, alignment, sizeHint, LXQtPanelWidget);
+        placeholder->setExpandable(mSettings->value(QStringLiteral("expandable"), false).toBool());
+        placeholder->setSeparate(mSettings->value(QStringLiteral("separate"), false).toBool());
+        mSettings->endGroup();
+        mLayout->addPlaceholder(placeholder);
+    }
+}
+
+
+/************************************************
+
+ ************************************************/
+void LXQtPanel::pluginLoaded(const QString &name, Plugin *plugin)
+{
+    mLayout->replacePlaceholder(name, plugin, mPlugins->pluginNames());
+    if (plugin)
     {
-        mLayout->addPlugin(plugin);
+        // the panel was realigned before the plugin existed
+        plugin->realign();
         connect(plugin, &Plugin::dragLeft, this, [this] {
             mShowDelayTimer.stop();
             hidePanel();
         });
     }
+
+    if (!mPlugins->hasPendingPlugins())
+        emit pluginsLoaded();
+}
+
+
+/************************************************
+
+ ************************************************/
+bool LXQtPanel::isLoadingPlugins() const
+{
+    return mPlugins && mPlugins->hasPendingPlugins();
+}
+
+
+/************************************************
+
+ ************************************************/
+void LXQtPanel::saveLayoutCache()
+{
+    const auto plugins = mPlugins->plugins();
+    for (auto const & plugin : plugins)
+        plugin->saveLayoutCache();
 }
 
 /************************************************
@@ -111,7 +111,8 @@ public:
      * 4. Connects signals and slots.
      * 5. Reads the settings for this panel.
      * 6. Optionally moves the panel to a valid screen (position-dependent).
-     * 7. Loads the Plugins.
+     * 7. Adds placeholders for the Plugins, which are loaded from the
+     * event loop afterwards (see PanelPluginsModel::pendingPluginNames()).
      * 8. Shows the panel, even if it is hidable (but then, starts the timer).
      * @param configGroup The name of the panel which is used as identifier
      * in the config file.
@@ -133,6 +134,19 @@ public:
      * or updateStyleSheet() which need to get called after changing settings.
      */
     void readSettings();
+    /**
+     * @brief Stores the current size hints and expand states of the Plugins
+     * in their settings. They are used for the placeholders of the Plugins
+     * at the next startup, so the initial layout doesn't change when the
+     * Plugins get loaded.
+     */
+    void saveLayoutCache();
+    /**
+     * @brief Returns true while the Plugins of the startup are being loaded
+     * from the event loop. The signal pluginsLoaded() is emitted after the
+     * last of them.
+     */
+    bool isLoadingPlugins() const;
 
     /**
      * @brief Creates and shows the popup menu (right click menu). If a plugin
@@ -370,6 +384,12 @@ signals:
      * will further re-emit this signal.
      */
     void pluginRemoved();
+    /**
+     * @brief This signal gets emitted when the last of the Plugins of the
+     * startup was loaded (or removed before being loaded).
+     * LXQtPanelApplication uses it to release the preloaded plugin modules.
+     */
+    void pluginsLoaded();
 
 protected:
     /**
@@ -439,6 +459,14 @@ private slots:
      * @param plug
      */
     void pluginMoved(Plugin * plug);
+    /**
+     * @brief Puts a Plugin loaded after the startup in the place of its
+     * placeholder. PanelPluginsModel::pluginLoaded() will be connected to
+     * this slot.
+     * @param name The name of the Plugin.
+     * @param plugin The loaded Plugin or nullptr if it couldn't be loaded.
+     */
+    void pluginLoaded(const QString &name, Plugin *plugin);
     /**
      * @brief Removes this panel's entries from the config file and emits
      * the deletedByUser signal.
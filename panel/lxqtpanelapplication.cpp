@@ -30,19 +30,38 @@
 
 #include "config/configpaneldialog.h"
 #include "lxqtpanel.h"
+#include "lxqtpanellimits.h"
+#include "lxqtpanellazypopup.h"
+#include "pluginpreloader.h"
+#include "startupprofiler.h"
+#include "systemsampler.h"
 
 #include <QCommandLineParser>
 #include <QScreen>
+#include <QTimer>
 #include <QUuid>
 #include <QWindow>
 #include <QtDebug>
 #include <LXQt/Settings>
 
 #include "backends/lxqttaskbardummybackend.h"
+#include "backends/lxqttaskmodel.h"
 #include "backends/xcb/lxqttaskbarbackend_x11.h"
 
+#ifdef WITH_SYNTHETIC_BACKEND
+#include "backends/lxqttaskbarsyntheticbackend.h"
+#endif
+#ifdef WITH_TASKBAR_BENCHMARK
+#include "taskbarbenchmark.h"
+#include <cstdlib>
+#endif
+
 ILXQtTaskbarAbstractBackend *createWMBackend()
 {
+#ifdef WITH_SYNTHETIC_BACKEND
+    // lxqt-panel-taskbar-bench and the taskbar tests make the windows themselves
+    return new LXQtTaskBarSyntheticBackend;
+#else
     if(qGuiApp->nativeInterface<QNativeInterface::QX11Application>())
         return new LXQtTaskbarX11Backend;
 
@@ -53,15 +72,39 @@ ILXQtTaskbarAbstractBackend *createWMBackend()
                << "\n";
 
     return new LXQtTaskBarDummyBackend;
+#endif
 }
 
 LXQtPanelApplicationPrivate::LXQtPanelApplicationPrivate(LXQtPanelApplication *q)
     : mSettings(nullptr),
+      mTaskModel(nullptr),
+      mSystemSampler(nullptr),
+      mPluginPreloader(nullptr),
       q_ptr(q)
 {
     mWMBackend = createWMBackend();
 }
 
+LXQtPanelApplicationPrivate::~LXQtPanelApplicationPrivate()
+{
+    delete mPluginPreloader;
+}
+
+void LXQtPanelApplicationPrivate::releasePluginPreloader()
+{
+    Q_Q(LXQtPanelApplication);
+    if (!mPluginPreloader)
+        return;
+
+    for (const LXQtPanel *panel : std::as_const(q->mPanels))
+    {
+        if (panel->isLoadingPlugins())
+            return;
+    }
+    delete mPluginPreloader;
+    mPluginPreloader = nullptr;
+}
+
 
 ILXQtPanel::Position LXQtPanelApplicationPrivate::computeNewPanelPosition(const LXQtPanel *p, const int screenNum)
 {
@@ -115,14 +158,64 @@ LXQtPanelApplication::LXQtPanelApplication(int& argc, char** argv)
             QCoreApplication::translate("main", "Configuration file"));
     parser.addOption(configFileOption);
 
+    QCommandLineOption startupProfileOption(QStringList()
+            << QLatin1String("startup-profile"),
+            QCoreApplication::translate("main", "Write a timeline of the startup to a trace file (Chrome trace event format)."),
+            QCoreApplication::translate("main", "Trace file"));
+    parser.addOption(startupProfileOption);
+
+#ifdef WITH_TASKBAR_BENCHMARK
+    // lxqt-panel-taskbar-bench, see TaskBarBenchmark
+    QCommandLineOption scenarioOption(QStringList()
+            << QLatin1String("scenario"),
+            QLatin1String("Windows and rates of changes of the synthetic window manager."),
+            QLatin1String("e.g. windows=10/100/1000,classes=20,title=50"));
+    parser.addOption(scenarioOption);
+#endif
+
     parser.process(*this);
 
-    const QString configFile = parser.value(configFileOption);
+    QString configFile = parser.value(configFileOption);
 
-    if (configFile.isEmpty())
-        d->mSettings = new LXQt::Settings(QLatin1String("panel"), this);
-    else
-        d->mSettings = new LXQt::Settings(configFile, QSettings::IniFormat, this);
+#ifdef WITH_TASKBAR_BENCHMARK
+    {
+        auto *syntheticBackend = static_cast<LXQtTaskBarSyntheticBackend *>(d->mWMBackend);
+        auto *benchmark = new TaskBarBenchmark(syntheticBackend, parser.value(scenarioOption), this);
+        connect(benchmark, &TaskBarBenchmark::finished, this, &QCoreApplication::quit);
+        QTimer::singleShot(TASKBAR_BENCH_DELAY, benchmark, &TaskBarBenchmark::start);
+
+        // never the settings of the user, the measures depend on them
+        if (!configFile.isEmpty())
+            qWarning() << "TaskBarBenchmark: --config is ignored";
+        configFile = benchmark->configFile();
+        if (configFile.isEmpty())
+        {
+            qWarning() << "TaskBarBenchmark: cannot write the configuration of the panel";
+            ::exit(1);
+        }
+    }
+#endif
+
+    d->mTaskModel = new LXQtTaskModel(d->mWMBackend, this);
+    d->mSystemSampler = new SystemSampler(this);
+
+    const QString startupProfile = parser.value(startupProfileOption);
+    if (!startupProfile.isEmpty())
+    {
+        StartupProfiler::start(startupProfile);
+        // give the panels some time to show up and paint their plugins
+        QTimer::singleShot(STARTUP_PROFILE_DURATION, this, [] { StartupProfiler::finish(); });
+        connect(this, &QCoreApplication::aboutToQuit, this, [] { StartupProfiler::finish(); });
+    }
+    StartupProfiler::Span startupSpan("startup", QStringLiteral("LXQtPanelApplication"));
+
+    {
+        StartupProfiler::Span span("settings", QStringLiteral("load settings"), configFile);
+        if (configFile.isEmpty())
+            d->mSettings = new LXQt::Settings(QLatin1String("panel"), this);
+        else
+            d->mSettings = new LXQt::Settings(configFile, QSettings::IniFormat, this);
+    }
 
     // This is a workaround for Qt 5 bug #40681.
     const auto allScreens = screens();
@@ -145,15 +238,30 @@ LXQtPanelApplication::LXQtPanelApplication(int& argc, char** argv)
     if (!iconTheme.isEmpty())
         QIcon::setThemeName(iconTheme);
 
+    // the time (in seconds) the hidden popups of the plugins are kept before they're released
+    LXQtPanelLazyPopup::setDefaultIdleTimeout(d->mSettings->value(QStringLiteral("popupIdleTimeout"),
+                                                                  PANEL_POPUP_IDLE_TIMEOUT).toInt() * 1000);
+
     if (panels.isEmpty())
     {
         panels << QStringLiteral("panel1");
     }
 
+    // Prepare the plugin modules of all panels in parallel, off the GUI thread.
+    // The modules are loaded and instantiated by the panels (on the GUI thread)
+    // from the event loop after that, the preloader is kept until then.
+    d->mPluginPreloader = new PluginPreloader;
+    {
+        StartupProfiler::Span span("plugin", QStringLiteral("PluginPreloader"));
+        d->mPluginPreloader->preloadPanels(d->mSettings, panels);
+        d->mPluginPreloader->waitForDone();
+    }
+
     for(const QString& i : std::as_const(panels))
     {
         addPanel(i);
     }
+    d->releasePluginPreloader();
 }
 
 LXQtPanelApplication::~LXQtPanelApplication()
@@ -163,6 +271,8 @@ LXQtPanelApplication::~LXQtPanelApplication()
 
 void LXQtPanelApplication::cleanup()
 {
+    for (LXQtPanel *panel : std::as_const(mPanels))
+        panel->saveLayoutCache();
     qDeleteAll(mPanels);
 }
 
@@ -188,13 +298,18 @@ LXQtPanel* LXQtPanelApplication::addPanel(const QString& name)
 {
     Q_D(LXQtPanelApplication);
 
-    LXQtPanel *panel = new LXQtPanel(name, d->mSettings);
+    LXQtPanel *panel;
+    {
+        StartupProfiler::Span span("panel", QStringLiteral("LXQtPanel"), name);
+        panel = new LXQtPanel(name, d->mSettings);
+    }
     mPanels << panel;
 
     // reemit signals
     connect(panel, &LXQtPanel::deletedByUser, this, &LXQtPanelApplication::removePanel);
     connect(panel, &LXQtPanel::pluginAdded, this, &LXQtPanelApplication::pluginAdded);
     connect(panel, &LXQtPanel::pluginRemoved, this, &LXQtPanelApplication::pluginRemoved);
+    connect(panel, &LXQtPanel::pluginsLoaded, this, [d] { d->releasePluginPreloader(); });
 
     return panel;
 }
@@ -292,6 +407,8 @@ void LXQtPanelApplication::removePanel(LXQtPanel* panel)
     Q_ASSERT(mPanels.contains(panel));
 
     mPanels.removeAll(panel);
+    // it may have been the last one loading its plugins
+    d->releasePluginPreloader();
 
     QStringList panels = d->mSettings->value(QStringLiteral("panels")).toStringList();
     panels.removeAll(panel->name());
@@ -315,6 +432,18 @@ ILXQtTaskbarAbstractBackend *LXQtPanelApplication::getWMBackend() const
     return d->mWMBackend;
 }
 
+LXQtTaskModel *LXQtPanelApplication::getTaskModel() const
+{
+    Q_D(const LXQtPanelApplication);
+    return d->mTaskModel;
+}
+
+SystemSampler *LXQtPanelApplication::getSystemSampler() const
+{
+    Q_D(const LXQtPanelApplication);
+    return d->mSystemSampler;
+}
+
 // See LXQtPanelApplication::LXQtPanelApplication for why this isn't good.
 void LXQtPanelApplication::setIconTheme(const QString &iconTheme)
 {
@@ -38,6 +38,8 @@ class LXQtPanel;
 class LXQtPanelApplicationPrivate;
 
 class ILXQtTaskbarAbstractBackend;
+class LXQtTaskModel;
+class SystemSampler;
 
 /*!
  * \brief The LXQtPanelApplication class inherits from LXQt::Application and
@@ -50,7 +52,7 @@ class ILXQtTaskbarAbstractBackend;
  * to have more than one panel (for example one panel at the top and one
  * panel at the bottom of the screen) without additional effort.
  */
-class LXQtPanelApplication : public LXQt::Application
+class LXQT_PANEL_API LXQtPanelApplication : public LXQt::Application
 {
     Q_OBJECT
 public:
@@ -93,6 +95,16 @@ public:
 
     ILXQtTaskbarAbstractBackend* getWMBackend() const;
 
+    /*!
+     * \brief The windows of getWMBackend(), shared by all the taskbars.
+     */
+    LXQtTaskModel* getTaskModel() const;
+
+    /*!
+     * \brief Reads the system statistics for all the plugins showing them.
+     */
+    SystemSampler* getSystemSampler() const;
+
 public slots:
     /*!
      * \brief Adds a new LXQtPanel which consists of the following steps:
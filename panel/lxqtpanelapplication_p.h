@@ -28,18 +28,26 @@ class Settings;
 }
 
 class ILXQtTaskbarAbstractBackend;
+class LXQtTaskModel;
+class PluginPreloader;
+class SystemSampler;
 
 class LXQtPanelApplicationPrivate {
     Q_DECLARE_PUBLIC(LXQtPanelApplication)
 public:
 
     LXQtPanelApplicationPrivate(LXQtPanelApplication *q);
-    ~LXQtPanelApplicationPrivate() {};
+    ~LXQtPanelApplicationPrivate();
 
     LXQt::Settings *mSettings;
     ILXQtTaskbarAbstractBackend *mWMBackend;
+    LXQtTaskModel *mTaskModel;
+    SystemSampler *mSystemSampler;
+    //! Keeps the metadata of the plugin modules until the panels have loaded them
+    PluginPreloader *mPluginPreloader;
 
     ILXQtPanel::Position computeNewPanelPosition(const LXQtPanel *p, const int screenNum);
+    void releasePluginPreloader();
 
 private:
     LXQtPanelApplication *const q_ptr;
@@ -40,12 +40,17 @@
 #include <QMouseEvent>
 #include <QPropertyAnimation>
 #include "plugin.h"
+#include "pluginplaceholder.h"
 #include "lxqtpanellimits.h"
 #include "ilxqtpanelplugin.h"
 #include "lxqtpanel.h"
 #include "pluginmoveprocessor.h"
+#include "startupprofiler.h"
 #include <QToolButton>
 #include <QStyle>
+#include <QTimer>
+
+#include <algorithm>
 
 #define ANIMATION_DURATION 250
 
@@ -75,6 +80,8 @@ struct LayoutItemInfo
     LayoutItemInfo(QLayoutItem *layoutItem=nullptr);
     QLayoutItem *item;
     QRect geometry;
+    QSize sizeHint; //!< the size hint used for geometry, to detect the changed items
+    QRect appliedGeometry; //!< the last geometry set to the item
     bool separate{false};
     bool expandable{false};
 };
@@ -93,6 +100,13 @@ LayoutItemInfo::LayoutItemInfo(QLayoutItem *layoutItem):
         expandable = p->isExpandable();
         return;
     }
+
+    PluginPlaceholder *placeholder = qobject_cast<PluginPlaceholder*>(item->widget());
+    if (placeholder)
+    {
+        separate = placeholder->isSeparate();
+        expandable = placeholder->isExpandable();
+    }
 }
 
 
@@ -122,6 +136,8 @@ public:
     int count() const { return mItems.count(); }
     QLayoutItem *itemAt(int index) const { return mItems[index]; }
     QLayoutItem *takeAt(int index);
+    void insertItem(int index, QLayoutItem *item);
+    QLayoutItem *replaceAt(int index, QLayoutItem *item);
 
 
     const LayoutItemInfo &itemInfo(int row, int col) const;
@@ -173,6 +189,11 @@ private:
     bool mExpandable;
     QList<QLayoutItem*> mItems;
 
+    // per row: the size in the direction of the panel, the size across it and the position
+    QList<int> mRowSizes;
+    QList<int> mRowBreadths;
+    QList<int> mRowOffsets;
+
     void doAddToGrid(QLayoutItem *item);
 };
 
@@ -273,6 +294,22 @@ void LayoutItemGrid::doAddToGrid(QLayoutItem *item)
 }
 
 
+/************************************************
+
+ ************************************************/
+void LayoutItemGrid::insertItem(int index, QLayoutItem *item)
+{
+    if (index >= mItems.count())
+    {
+        addItem(item);
+        return;
+    }
+
+    mItems.insert(index, item);
+    rebuild();
+}
+
+
 /************************************************
 
  ************************************************/
@@ -284,6 +321,37 @@ QLayoutItem *LayoutItemGrid::takeAt(int index)
 }
 
 
+/************************************************
+
+ ************************************************/
+QLayoutItem *LayoutItemGrid::replaceAt(int index, QLayoutItem *item)
+{
+    QLayoutItem *old = mItems[index];
+    mItems[index] = item;
+
+    // The item takes the cell of the old one, unless it breaks the lines
+    // differently. Its size hint is unknown, so update() recalculates its
+    // row only.
+    const LayoutItemInfo info(item);
+    for (LayoutItemInfo &cell : mInfoItems)
+    {
+        if (cell.item != old)
+            continue;
+        if (cell.separate != info.separate)
+            break;
+
+        cell = info;
+        mExpandable = std::any_of(mInfoItems.cbegin(), mInfoItems.cend(),
+                                  [] (const LayoutItemInfo &i) { return i.expandable; });
+        invalidate();
+        return old;
+    }
+
+    rebuild();
+    return old;
+}
+
+
 /************************************************
 
  ************************************************/
@@ -317,66 +385,99 @@ LayoutItemInfo &LayoutItemGrid::itemInfo(int row, int col)
  ************************************************/
 void LayoutItemGrid::update()
 {
-    mExpandableSize = 0;
-    mSizeHint = QSize(0,0);
+    StartupProfiler::Span span("layout", QStringLiteral("LayoutItemGrid::update"));
 
-    if (mHoriz)
+    mRowSizes.resize(mRowCount);
+    mRowBreadths.resize(mRowCount);
+    mRowOffsets.resize(mRowCount);
+
+    // Only the rows with a changed item are recalculated,
+    // the rows after the first changed one are just shifted.
+    int firstChanged = mRowCount;
+    int changedRows = 0;
+    for (int r=0; r<mRowCount; ++r)
     {
-        mSizeHint.setHeight(mLineSize * mColCount);
-        int x = 0;
-        for (int r=0; r<mRowCount; ++r)
+        bool changed = false;
+        for (int c=0; c<mColCount; ++c)
         {
-            int y = 0;
-            int rw = 0;
-            for (int c=0; c<mColCount; ++c)
+            LayoutItemInfo &info = itemInfo(r, c);
+            if (!info.item)
+                continue;
+
+            const QSize sz = info.item->sizeHint();
+            if (sz != info.sizeHint)
             {
-                LayoutItemInfo &info = itemInfo(r, c);
-                if (!info.item)
-                    continue;
-
-                QSize sz = info.item->sizeHint();
-                info.geometry = QRect(QPoint(x,y), sz);
-                y += sz.height();
-                rw = qMax(rw, sz.width());
+                info.sizeHint = sz;
+                changed = true;
             }
-            x += rw;
+        }
+
+        if (!changed)
+            continue;
 
-            if (itemInfo(r, 0).expandable)
-                mExpandableSize += rw;
+        ++changedRows;
+        firstChanged = qMin(firstChanged, r);
+        int pos = 0;
+        int rowSize = 0;
+        for (int c=0; c<mColCount; ++c)
+        {
+            LayoutItemInfo &info = itemInfo(r, c);
+            if (!info.item)
+                continue;
 
-            mSizeHint.setWidth(x);
-            mSizeHint.rheight() = qMax(mSizeHint.rheight(), y);
+            if (mHoriz)
+            {
+                info.geometry = QRect(QPoint(mRowOffsets[r], pos), info.sizeHint);
+                pos += info.sizeHint.height();
+                rowSize = qMax(rowSize, info.sizeHint.width());
+            }
+            else
+            {
+                info.geometry = QRect(QPoint(pos, mRowOffsets[r]), info.sizeHint);
+                pos += info.sizeHint.width();
+                rowSize = qMax(rowSize, info.sizeHint.height());
+            }
         }
+        mRowSizes[r] = rowSize;
+        mRowBreadths[r] = pos;
     }
-    else
+
+    if (firstChanged < mRowCount)
     {
-        mSizeHint.setWidth(mLineSize * mColCount);
-        int y = 0;
-        for (int r=0; r<mRowCount; ++r)
+        int offset = firstChanged > 0 ? mRowOffsets[firstChanged - 1] + mRowSizes[firstChanged - 1] : 0;
+        for (int r=firstChanged; r<mRowCount; ++r)
         {
-            int x = 0;
-            int rh = 0;
-            for (int c=0; c<mColCount; ++c)
+            if (mRowOffsets[r] != offset)
             {
-                LayoutItemInfo &info = itemInfo(r, c);
-                if (!info.item)
-                    continue;
-
-                QSize sz = info.item->sizeHint();
-                info.geometry = QRect(QPoint(x,y), sz);
-                x += sz.width();
-                rh = qMax(rh, sz.height());
+                mRowOffsets[r] = offset;
+                for (int c=0; c<mColCount; ++c)
+                {
+                    LayoutItemInfo &info = itemInfo(r, c);
+                    if (mHoriz)
+                        info.geometry.moveLeft(offset);
+                    else
+                        info.geometry.moveTop(offset);
+                }
             }
-            y += rh;
-
-            if (itemInfo(r, 0).expandable)
-                mExpandableSize += rh;
-
-            mSizeHint.setHeight(y);
-            mSizeHint.rwidth() = qMax(mSizeHint.rwidth(), x);
+            offset += mRowSizes[r];
         }
     }
 
+    mExpandableSize = 0;
+    int size = 0;
+    int breadth = mLineSize * mColCount;
+    for (int r=0; r<mRowCount; ++r)
+    {
+        size += mRowSizes[r];
+        breadth = qMax(breadth, mRowBreadths[r]);
+        if (itemInfo(r, 0).expandable)
+            mExpandableSize += mRowSizes[r];
+    }
+    mSizeHint = mHoriz ? QSize(size, breadth) : QSize(breadth, size);
+
+    if (span.isRecording())
+        span.setDetail(QStringLiteral("%1 of %2 lines recalculated").arg(changedRows).arg(mRowCount));
+
     mValid = true;
 }
 
@@ -405,8 +506,12 @@ void LayoutItemGrid::setColCount(int value)
  ************************************************/
 void LayoutItemGrid::setHoriz(bool value)
 {
+    if (mHoriz == value)
+        return;
+
     mHoriz = value;
-    invalidate();
+    // all the geometries have to be recalculated
+    rebuild();
 }
 
 
@@ -419,9 +524,14 @@ LXQtPanelLayout::LXQtPanelLayout(QWidget *parent) :
     mLeftGrid(new LayoutItemGrid()),
     mRightGrid(new LayoutItemGrid()),
     mPosition(ILXQtPanel::PositionBottom),
-    mAnimate(false)
+    mAnimate(false),
+    mAppliedCount(0)
 {
     setContentsMargins(0, 0, 0, 0);
+
+    mRelayoutTimer.setSingleShot(true);
+    mRelayoutTimer.setInterval(0);
+    connect(&mRelayoutTimer, &QTimer::timeout, this, [this] { QLayout::invalidate(); });
 }
 
 
@@ -443,7 +553,9 @@ void LXQtPanelLayout::addItem(QLayoutItem *item)
     LayoutItemGrid *grid = mRightGrid;
 
     Plugin *p = qobject_cast<Plugin*>(item->widget());
-    if (p && p->alignment() == Plugin::AlignLeft)
+    PluginPlaceholder *placeholder = qobject_cast<PluginPlaceholder*>(item->widget());
+    if ((p && p->alignment() == Plugin::AlignLeft)
+            || (placeholder && placeholder->alignment() == Plugin::AlignLeft))
         grid = mLeftGrid;
 
     grid->addItem(item);
@@ -529,6 +641,8 @@ int LXQtPanelLayout::count() const
  ************************************************/
 void LXQtPanelLayout::moveItem(int from, int to, bool withAnimation)
 {
+    StartupProfiler::Span span("layout", QStringLiteral("LXQtPanelLayout::moveItem"));
+
     if (from != to)
     {
         LayoutItemGrid *fromGrid=nullptr;
@@ -565,6 +679,8 @@ void LXQtPanelLayout::moveItem(int from, int to, bool withAnimation)
  ************************************************/
 QSize LXQtPanelLayout::sizeHint() const
 {
+    StartupProfiler::Span span("layout", QStringLiteral("LXQtPanelLayout::sizeHint"));
+
     if (!mLeftGrid->isValid())
         mLeftGrid->update();
 
@@ -592,6 +708,9 @@ QSize LXQtPanelLayout::sizeHint() const
  ************************************************/
 void LXQtPanelLayout::setGeometry(const QRect &geometry)
 {
+    StartupProfiler::Span span("layout", QStringLiteral("LXQtPanelLayout::setGeometry"));
+    mAppliedCount = 0;
+
     if (!mLeftGrid->isValid())
         mLeftGrid->update();
 
@@ -610,14 +729,24 @@ void LXQtPanelLayout::setGeometry(const QRect &geometry)
 
     mAnimate = false;
     QLayout::setGeometry(my_geometry);
+
+    if (span.isRecording())
+        span.setDetail(QStringLiteral("%1 of %2 items moved").arg(mAppliedCount).arg(count()));
 }
 
 
 /************************************************
 
  ************************************************/
-void LXQtPanelLayout::setItemGeometry(QLayoutItem *item, const QRect &geometry, bool withAnimation)
+void LXQtPanelLayout::setItemGeometry(LayoutItemInfo &info, const QRect &geometry, bool withAnimation)
 {
+    // untouched item
+    if (info.appliedGeometry == geometry)
+        return;
+    info.appliedGeometry = geometry;
+    ++mAppliedCount;
+
+    QLayoutItem *item = info.item;
     Plugin *plugin = qobject_cast<Plugin*>(item->widget());
     if (withAnimation && plugin)
     {
@@ -683,7 +812,7 @@ void LXQtPanelLayout::setGeometryHoriz(const QRect &geometry)
         int remain = height_remain;
         for (int c=0; c<mLeftGrid->usedColCount(); ++c)
         {
-            const LayoutItemInfo &info = mLeftGrid->itemInfo(r, c);
+            LayoutItemInfo &info = mLeftGrid->itemInfo(r, c);
             if (info.item)
             {
                 QRect rect;
@@ -716,7 +845,7 @@ void LXQtPanelLayout::setGeometryHoriz(const QRect &geometry)
                 rw = qMax(rw, rect.width());
                 if (visual_h_reversed)
                     rect.moveLeft(geometry.left() + geometry.right() - rect.x() - rect.width() + 1);
-                setItemGeometry(info.item, rect, mAnimate);
+                setItemGeometry(info, rect, mAnimate);
             }
         }
         left += rw;
@@ -730,7 +859,7 @@ void LXQtPanelLayout::setGeometryHoriz(const QRect &geometry)
         int remain = height_remain;
         for (int c=0; c<mRightGrid->usedColCount(); ++c)
         {
-            const LayoutItemInfo &info = mRightGrid->itemInfo(r, c);
+            LayoutItemInfo &info = mRightGrid->itemInfo(r, c);
             if (info.item)
             {
                 QRect rect;
@@ -764,7 +893,7 @@ void LXQtPanelLayout::setGeometryHoriz(const QRect &geometry)
                 rw = qMax(rw, rect.width());
                 if (visual_h_reversed)
                     rect.moveLeft(geometry.left() + geometry.right() - rect.x() - rect.width() + 1);
-                setItemGeometry(info.item, rect, mAnimate);
+                setItemGeometry(info, rect, mAnimate);
             }
         }
         right -= rw;
@@ -821,7 +950,7 @@ void LXQtPanelLayout::setGeometryVert(const QRect &geometry)
         int remain = width_remain;
         for (int c=0; c<mLeftGrid->usedColCount(); ++c)
         {
-            const LayoutItemInfo &info = mLeftGrid->itemInfo(r, c);
+            LayoutItemInfo &info = mLeftGrid->itemInfo(r, c);
             if (info.item)
             {
                 QRect rect;
@@ -854,7 +983,7 @@ void LXQtPanelLayout::setGeometryVert(const QRect &geometry)
                 rh = qMax(rh, rect.height());
                 if (visual_h_reversed)
                     rect.moveLeft(geometry.left() + geometry.right() - rect.x() - rect.width() + 1);
-                setItemGeometry(info.item, rect, mAnimate);
+                setItemGeometry(info, rect, mAnimate);
             }
         }
         top += rh;
@@ -869,7 +998,7 @@ void LXQtPanelLayout::setGeometryVert(const QRect &geometry)
         int remain = width_remain;
         for (int c=0; c<mRightGrid->usedColCount(); ++c)
         {
-            const LayoutItemInfo &info = mRightGrid->itemInfo(r, c);
+            LayoutItemInfo &info = mRightGrid->itemInfo(r, c);
             if (info.item)
             {
                 QRect rect;
@@ -902,7 +1031,7 @@ void LXQtPanelLayout::setGeometryVert(const QRect &geometry)
                 rh = qMax(rh, rect.height());
                 if (visual_h_reversed)
                     rect.moveLeft(geometry.left() + geometry.right() - rect.x() - rect.width() + 1);
-                setItemGeometry(info.item, rect, mAnimate);
+                setItemGeometry(info, rect, mAnimate);
             }
         }
         bottom -= rh;
@@ -918,7 +1047,11 @@ void LXQtPanelLayout::invalidate()
     mLeftGrid->invalidate();
     mRightGrid->invalidate();
     mMinPluginSize = QSize();
-    QLayout::invalidate();
+
+    // Plugins being loaded or resizing their contents invalidate the layout many
+    // times in a row, do a single relayout for all of them in the next iteration.
+    if (!mRelayoutTimer.isActive())
+        mRelayoutTimer.start();
 }
 
 
@@ -947,6 +1080,8 @@ void LXQtPanelLayout::setLineCount(int value)
  ************************************************/
 void LXQtPanelLayout::rebuild()
 {
+    StartupProfiler::Span span("layout", QStringLiteral("LXQtPanelLayout::rebuild"));
+
     mLeftGrid->rebuild();
     mRightGrid->rebuild();
 }
@@ -1003,7 +1138,10 @@ bool LXQtPanelLayout::itemIsSeparate(QLayoutItem *item)
 
     Plugin *p = qobject_cast<Plugin*>(item->widget());
     if (!p)
-        return true;
+    {
+        PluginPlaceholder *placeholder = qobject_cast<PluginPlaceholder*>(item->widget());
+        return !placeholder || placeholder->isSeparate();
+    }
 
     return p->isSeparate();
 }
@@ -1066,3 +1204,101 @@ void LXQtPanelLayout::addPlugin(Plugin * plugin)
     if (prev_count > pos)
         moveItem(pos, prev_count, false);
 }
+
+
+/************************************************
+
+ ************************************************/
+void LXQtPanelLayout::addPlaceholder(PluginPlaceholder *placeholder)
+{
+    addWidget(placeholder);
+}
+
+
+/************************************************
+
+ ************************************************/
+void LXQtPanelLayout::replacePlaceholder(const QString &settingsGroup, Plugin *plugin, const QStringList &order)
+{
+    for (int i = 0; i < count(); ++i)
+    {
+        PluginPlaceholder *placeholder = qobject_cast<PluginPlaceholder*>(itemAt(i)->widget());
+        if (!placeholder || placeholder->settingsGroup() != settingsGroup)
+            continue;
+
+        LayoutItemGrid *grid=nullptr;
+        int idx=0;
+        globalIndexToLocal(i, &grid, &idx);
+
+        QLayoutItem *old;
+        // the alignment in the settings may be missing (the plugin was never saved), so
+        // the placeholder can be in the wrong grid -> the plugin is inserted in the other one
+        if (plugin && plugin->alignment() == placeholder->alignment())
+        {
+            connect(plugin, &Plugin::startMove, this, &LXQtPanelLayout::startMovePlugin);
+            addChildWidget(plugin);
+            QLayoutItem *item = new QWidgetItem(plugin);
+            old = grid->replaceAt(idx, item);
+
+            // the cached layout is still right -> no relayout, just take the place
+            // (if the placeholder has been laid out, its geometry is the default one otherwise)
+            if (placeholder->testAttribute(Qt::WA_Resized)
+                    && plugin->sizeHint() == placeholder->sizeHint()
+                    && plugin->isExpandable() == placeholder->isExpandable()
+                    && plugin->isSeparate() == placeholder->isSeparate())
+            {
+                item->setGeometry(placeholder->geometry());
+                grid->update();
+            }
+            else
+            {
+                invalidate();
+            }
+        }
+        else
+        {
+            old = grid->takeAt(idx);
+            if (plugin)
+                insertPlugin(plugin, order);
+            invalidate();
+        }
+        delete old;
+        delete placeholder;
+        return;
+    }
+
+    // no placeholder (e.g. the panel was rebuilt meanwhile)
+    if (plugin)
+        insertPlugin(plugin, order);
+}
+
+
+/************************************************
+
+ ************************************************/
+void LXQtPanelLayout::insertPlugin(Plugin *plugin, const QStringList &order)
+{
+    connect(plugin, &Plugin::startMove, this, &LXQtPanelLayout::startMovePlugin);
+    addChildWidget(plugin);
+
+    LayoutItemGrid *grid = plugin->alignment() == Plugin::AlignLeft ? mLeftGrid : mRightGrid;
+
+    // the grid is in the order of the panel, before the first plugin (or
+    // placeholder) which comes after this one
+    const int position = order.indexOf(plugin->settingsGroup());
+    int idx = position < 0 ? grid->count() : 0;
+    for (; idx < grid->count(); ++idx)
+    {
+        const QWidget *widget = grid->itemAt(idx)->widget();
+        QString name;
+        if (const Plugin *p = qobject_cast<const Plugin*>(widget))
+            name = p->settingsGroup();
+        else if (const PluginPlaceholder *placeholder = qobject_cast<const PluginPlaceholder*>(widget))
+            name = placeholder->settingsGroup();
+        if (order.indexOf(name) > position)
+            break;
+    }
+
+    grid->insertItem(idx, new QWidgetItem(plugin));
+    invalidate();
+}
@@ -33,6 +33,7 @@
 #include <QList>
 #include <QWidget>
 #include <QLayoutItem>
+#include <QTimer>
 #include "ilxqtpanel.h"
 #include "lxqtpanelglobals.h"
 
@@ -41,7 +42,9 @@ class QMouseEvent;
 class QEvent;
 
 class Plugin;
+class PluginPlaceholder;
 class LayoutItemGrid;
+struct LayoutItemInfo;
 
 class LXQT_PANEL_API LXQtPanelLayout : public QLayout
 {
@@ -77,6 +80,21 @@ public:
      */
     void rebuild();
 
+    /*! \brief Adds the placeholder of a not yet loaded Plugin (at the end,
+     * like addPlugin()).
+     */
+    void addPlaceholder(PluginPlaceholder *placeholder);
+    /*! \brief Puts the Plugin in the place of its placeholder and deletes the
+     * placeholder.
+     * \param settingsGroup The name of the Plugin the placeholder stands for.
+     * \param plugin The loaded Plugin. If it's nullptr (the Plugin couldn't
+     * be loaded), the placeholder is just removed.
+     * \param order The names of all the Plugins in the order of the panel
+     * (PanelPluginsModel::pluginNames()). If the Plugin doesn't go to the grid
+     * of its placeholder, it's inserted at its place in the other grid.
+     */
+    void replacePlaceholder(const QString &settingsGroup, Plugin *plugin, const QStringList &order);
+
     static bool itemIsSeparate(QLayoutItem *item);
 signals:
     void pluginMoved(Plugin * plugin);
@@ -93,6 +111,8 @@ private:
     LayoutItemGrid *mRightGrid;
     ILXQtPanel::Position mPosition;
     bool mAnimate;
+    int mAppliedCount; //!< items moved/resized by the last setGeometry() (for the startup profile)
+    QTimer mRelayoutTimer; //!< coalesces the invalidations, see invalidate()
 
 
     void setGeometryHoriz(const QRect &geometry);
@@ -100,7 +120,8 @@ private:
     void globalIndexToLocal(int index, LayoutItemGrid **grid, int *gridIndex);
     void globalIndexToLocal(int index, LayoutItemGrid **grid, int *gridIndex) const;
 
-    void setItemGeometry(QLayoutItem *item, const QRect &geometry, bool withAnimation);
+    void setItemGeometry(LayoutItemInfo &info, const QRect &geometry, bool withAnimation);
+    void insertPlugin(Plugin *plugin, const QStringList &order);
 };
 
 #endif // LXQTPANELLAYOUT_H
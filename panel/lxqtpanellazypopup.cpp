@@ -0,0 +1,174 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt.org
+ *
+ * Copyright: 2026 LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "lxqtpanellazypopup.h"
+#include "lxqtpanellimits.h"
+
+#include <QEvent>
+
+int LXQtPanelLazyPopup::mDefaultIdleTimeout = PANEL_POPUP_IDLE_TIMEOUT * 1000;
+
+/************************************************
+
+ ************************************************/
+LXQtPanelLazyPopup::LXQtPanelLazyPopup(QObject *parent) :
+    QObject(parent),
+    mIdleTimeout(-1)
+{
+    mIdleTimer.setSingleShot(true);
+    connect(&mIdleTimer, &QTimer::timeout, this, &LXQtPanelLazyPopup::release);
+}
+
+/************************************************
+
+ ************************************************/
+LXQtPanelLazyPopup::~LXQtPanelLazyPopup()
+{
+    if (mTrigger)
+        mTrigger->removeEventFilter(this);
+    // NOTE: with a releaser, the popup is owned by someone else
+    if (mWidget && !mReleaser)
+        delete mWidget.data();
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtPanelLazyPopup::setFactory(Factory factory, Releaser releaser)
+{
+    mFactory = std::move(factory);
+    mReleaser = std::move(releaser);
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtPanelLazyPopup::setTrigger(QWidget *trigger)
+{
+    if (mTrigger)
+        mTrigger->removeEventFilter(this);
+    mTrigger = trigger;
+    if (mTrigger)
+        mTrigger->installEventFilter(this);
+}
+
+/************************************************
+
+ ************************************************/
+QWidget *LXQtPanelLazyPopup::widget()
+{
+    if (!mWidget && mFactory)
+    {
+        mWidget = mFactory();
+        if (mWidget)
+        {
+            mWidget->installEventFilter(this);
+            // built in advance, release it if it's not shown in time
+            startIdleTimer();
+        }
+    }
+    return mWidget;
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtPanelLazyPopup::release()
+{
+    mIdleTimer.stop();
+    if (!mWidget || mWidget->isVisible())
+        return;
+
+    QWidget *widget = mWidget;
+    mWidget = nullptr;
+    widget->removeEventFilter(this);
+    if (mReleaser)
+        mReleaser(widget);
+    else
+        widget->deleteLater(); // we may be called from the widget's event handling
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtPanelLazyPopup::setIdleTimeout(int msec)
+{
+    mIdleTimeout = msec;
+}
+
+/************************************************
+
+ ************************************************/
+int LXQtPanelLazyPopup::defaultIdleTimeout()
+{
+    return mDefaultIdleTimeout;
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtPanelLazyPopup::setDefaultIdleTimeout(int msec)
+{
+    mDefaultIdleTimeout = msec;
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtPanelLazyPopup::startIdleTimer()
+{
+    const int timeout = mIdleTimeout < 0 ? mDefaultIdleTimeout : mIdleTimeout;
+    if (timeout > 0)
+        mIdleTimer.start(timeout);
+}
+
+/************************************************
+
+ ************************************************/
+bool LXQtPanelLazyPopup::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched == mTrigger)
+    {
+        if (event->type() == QEvent::Enter)
+            widget();
+    }
+    else if (watched == mWidget)
+    {
+        switch (event->type())
+        {
+        case QEvent::Show:
+            mIdleTimer.stop();
+            break;
+
+        case QEvent::Hide:
+            startIdleTimer();
+            break;
+
+        default:
+            break;
+        }
+    }
+    return QObject::eventFilter(watched, event);
+}
@@ -0,0 +1,119 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt.org
+ *
+ * Copyright: 2026 LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#ifndef LXQTPANELLAZYPOPUP_H
+#define LXQTPANELLAZYPOPUP_H
+
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QWidget>
+#include <functional>
+#include "lxqtpanelglobals.h"
+
+/*!
+ * \brief The LXQtPanelLazyPopup class holds a popup widget of a plugin which
+ * is built only when it's needed and released when it's not used anymore.
+ *
+ * The popup is built by the factory on the first call of widget(), or
+ * earlier, when the mouse enters the trigger widget (usually the plugin
+ * button), so that it's ready when the user clicks. After the popup gets
+ * hidden, it is released when it stays hidden for the idle timeout.
+ *
+ * Plugins must not keep pointers to the popup (or its children) across
+ * event loop iterations; use createdWidget() to update it only if it exists
+ * and apply the current state in the factory.
+ */
+class LXQT_PANEL_API LXQtPanelLazyPopup : public QObject
+{
+    Q_OBJECT
+public:
+    using Factory = std::function<QWidget *()>;
+    using Releaser = std::function<void (QWidget *)>;
+
+    explicit LXQtPanelLazyPopup(QObject *parent = nullptr);
+    ~LXQtPanelLazyPopup();
+
+    /*!
+     * \brief setFactory Sets the function building the popup.
+     * \param releaser Optional function releasing the popup (e.g. when the
+     * widget is owned by another object). By default the widget is deleted,
+     * also when the LXQtPanelLazyPopup is destroyed.
+     */
+    void setFactory(Factory factory, Releaser releaser = Releaser());
+
+    /*!
+     * \brief setTrigger Builds the popup in advance when the mouse enters
+     * the given widget.
+     */
+    void setTrigger(QWidget *trigger);
+
+    /*!
+     * \brief widget Returns the popup, building it if needed.
+     */
+    QWidget *widget();
+    template <class T> T *widget() { return static_cast<T *>(widget()); }
+
+    /*!
+     * \brief createdWidget Returns the popup if it's built, nullptr otherwise.
+     */
+    QWidget *createdWidget() const { return mWidget; }
+    template <class T> T *createdWidget() const { return static_cast<T *>(mWidget.data()); }
+
+    bool isCreated() const { return !mWidget.isNull(); }
+
+    /*!
+     * \brief release Releases the popup now (if it isn't visible).
+     */
+    void release();
+
+    /*!
+     * \brief idleTimeout The time (in ms) a hidden popup is kept; negative
+     * means the default of the panel ("popupIdleTimeout" in panel.conf),
+     * 0 means that it's never released.
+     */
+    int idleTimeout() const { return mIdleTimeout; }
+    void setIdleTimeout(int msec);
+
+    static int defaultIdleTimeout();
+    static void setDefaultIdleTimeout(int msec);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    void startIdleTimer();
+
+    Factory mFactory;
+    Releaser mReleaser;
+    QPointer<QWidget> mWidget;
+    QPointer<QWidget> mTrigger;
+    QTimer mIdleTimer;
+    int mIdleTimeout;
+
+    static int mDefaultIdleTimeout;
+};
+
+#endif // LXQTPANELLAZYPOPUP_H
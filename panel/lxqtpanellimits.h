@@ -44,4 +44,14 @@
 #define PANEL_SHOW_DELAY 0
 
 #define SETTINGS_SAVE_DELAY 3000
+
+#define STARTUP_PROFILE_DURATION 10000
+
+#define TASKBAR_BENCH_DELAY 3000 // ms given to the panels to load their plugins
+#define TASKBAR_BENCH_SETTLE_TIME 500 // ms given to the deferred work before and after measuring
+#define TASKBAR_BENCH_TICK 10 // ms between two batches of changes
+
+#define SYSTEM_SAMPLER_SLACK 20 // ms a subscription is sampled early to share a reading
+
+#define PANEL_POPUP_IDLE_TIMEOUT 60
 #endif // LXQTPANELLIMITS_H
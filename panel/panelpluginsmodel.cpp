@@ -28,12 +28,36 @@
 #include "ilxqtpanelplugin.h"
 #include "lxqtpanel.h"
 #include "lxqtpanelapplication.h"
+#include "startupprofiler.h"
 #include <QPointer>
+#include <QTimer>
 #include <XdgIcon>
 #include <LXQt/Settings>
 
 #include <QDebug>
 
+namespace
+{
+    /*!
+     * \brief loadingPriority returns the position of the plugin type in the
+     * loading order at the startup. The plugins the user sees and uses
+     * right away are loaded first.
+     */
+    int loadingPriority(QString const & type)
+    {
+        static const QStringList priorities = {
+            QStringLiteral("taskbar"),
+            QStringLiteral("worldclock"),
+            QStringLiteral("statusnotifier"),
+            QStringLiteral("tray"),
+            QStringLiteral("fancymenu"),
+            QStringLiteral("mainmenu"),
+        };
+        const int priority = priorities.indexOf(type);
+        return priority < 0 ? priorities.size() : priority;
+    }
+}
+
 PanelPluginsModel::PanelPluginsModel(LXQtPanel * panel,
                                      QString const & namesKey,
                                      QStringList const & desktopDirs,
@@ -116,6 +140,16 @@ Plugin* PanelPluginsModel::pluginByName(QString name) const
     return nullptr;
 }
 
+QStringList PanelPluginsModel::pendingPluginNames() const
+{
+    QStringList names;
+    for (auto const & p : mPlugins)
+        if (std::any_of(mPendingPlugins.cbegin(), mPendingPlugins.cend(),
+                        [&p] (pendinglist_t::const_reference pending) { return p.first == pending.first; }))
+            names.append(p.first);
+    return names;
+}
+
 Plugin const * PanelPluginsModel::pluginByID(QString id) const
 {
     for (auto const & p : mPlugins)
@@ -153,8 +187,16 @@ void PanelPluginsModel::removePlugin(pluginslist_t::iterator plugin)
         Plugin * p = plugin->second.data();
         const int row = plugin - mPlugins.begin();
         beginRemoveRows(QModelIndex(), row, row);
+        const QString name = plugin->first;
         mPlugins.erase(plugin);
         endRemoveRows();
+        const auto pending = std::find_if(mPendingPlugins.begin(), mPendingPlugins.end(),
+                                          [&name] (pendinglist_t::const_reference obj) { return name == obj.first; });
+        if (mPendingPlugins.end() != pending)
+        {
+            mPendingPlugins.erase(pending);
+            emit pluginLoaded(name, nullptr);
+        }
         emit pluginRemoved(p); // p can be nullptr
         mPanel->settings()->setValue(mNamesKey, pluginNames());
         if (nullptr != p)
@@ -219,11 +261,6 @@ void PanelPluginsModel::loadPlugins(QStringList const & desktopDirs)
 {
     QStringList plugin_names = mPanel->settings()->value(mNamesKey).toStringList();
 
-#ifdef DEBUG_PLUGIN_LOADTIME
-    QElapsedTimer timer;
-    timer.start();
-    qint64 lastTime = 0;
-#endif
     for (auto const & name : std::as_const(plugin_names))
     {
         pluginslist_t::iterator i = mPlugins.insert(mPlugins.end(), {name, nullptr});
@@ -260,12 +297,46 @@ void PanelPluginsModel::loadPlugins(QStringList const & desktopDirs)
             continue;
         }
 
-        i->second = loadPlugin(list.first(), name);
+        mPendingPlugins.append({name, list.first()});
+    }
+
+    // the important plugins first, the rest in the order of the panel
+    std::stable_sort(mPendingPlugins.begin(), mPendingPlugins.end(),
+                     [] (pendinglist_t::const_reference a, pendinglist_t::const_reference b) {
+                         return loadingPriority(a.second.id()) < loadingPriority(b.second.id());
+                     });
+
+    if (!mPendingPlugins.isEmpty())
+        QTimer::singleShot(0, this, &PanelPluginsModel::loadNextPlugin);
+}
+
+void PanelPluginsModel::loadNextPlugin()
+{
+    if (mPendingPlugins.isEmpty())
+        return;
+
+    const auto pending = mPendingPlugins.takeFirst();
+    const auto i = std::find_if(mPlugins.begin(), mPlugins.end(),
+                                [&pending] (pluginslist_t::const_reference obj) { return pending.first == obj.first; });
+    Q_ASSERT(mPlugins.end() != i);
+
 #ifdef DEBUG_PLUGIN_LOADTIME
-        qDebug() << "load plugin" << type << "takes" << (timer.elapsed() - lastTime) << "ms";
-        lastTime = timer.elapsed();
+    QElapsedTimer timer;
+    timer.start();
 #endif
-    }
+    i->second = loadPlugin(pending.second, pending.first);
+#ifdef DEBUG_PLUGIN_LOADTIME
+    qDebug() << "load plugin" << pending.second.id() << "takes" << timer.elapsed() << "ms";
+#endif
+
+    const QModelIndex changed = index(i - mPlugins.begin());
+    emit dataChanged(changed, changed);
+    emit pluginLoaded(pending.first, i->second.data());
+
+    if (mPendingPlugins.isEmpty())
+        StartupProfiler::instant("plugin", QStringLiteral("All plugins loaded"), mNamesKey);
+    else
+        QTimer::singleShot(0, this, &PanelPluginsModel::loadNextPlugin);
 }
 
 QPointer<Plugin> PanelPluginsModel::loadPlugin(LXQt::PluginInfo const & desktopFile, QString const & settingsGroup)
@@ -27,11 +27,11 @@
 #define PANELPLUGINSMODEL_H
 
 #include <QAbstractListModel>
+#include <LXQt/PluginInfo>
 #include <memory>
 
 namespace LXQt
 {
-    class PluginInfo;
     struct PluginData;
 }
 
@@ -128,6 +128,27 @@ public:
      * \return the first Plugin found with the given ID.
      */
     Plugin const *pluginByID(QString id) const;
+    /*!
+     * \brief pendingPluginNames returns the names of the Plugins that
+     * are configured in this panel but are not loaded yet, in the order
+     * of the panel.
+     *
+     * The Plugins are not loaded in the constructor. They are loaded one
+     * by one from the event loop, in the order of their priority (the
+     * taskbar, the clock and the tray first), so the panel can be shown
+     * before all the Plugins are ready. The signal pluginLoaded() is
+     * emitted for every one of them.
+     *
+     * \sa pluginLoaded
+     */
+    QStringList pendingPluginNames() const;
+    /*!
+     * \brief hasPendingPlugins returns true while some Plugins of the
+     * startup are not loaded yet.
+     *
+     * \sa pendingPluginNames
+     */
+    bool hasPendingPlugins() const { return !mPendingPlugins.isEmpty(); }
 
     /*!
      * \brief movePlugin moves a Plugin in the underlying data.
@@ -156,6 +177,16 @@ signals:
      * to the panel.
      */
     void pluginAdded(Plugin * plugin);
+    /*!
+     * \brief pluginLoaded gets emitted whenever a Plugin which was pending
+     * at the startup gets loaded.
+     * \param name The name of the Plugin as it is used in the config files.
+     * \param plugin The loaded Plugin. This is a nullptr if the Plugin
+     * could not be loaded or if it was removed before being loaded.
+     *
+     * \sa pendingPluginNames
+     */
+    void pluginLoaded(QString const & name, Plugin * plugin);
     /*!
      * \brief pluginRemoved gets emitted whenever a Plugin is removed.
      * \param plugin The Plugin that was removed. This could be a nullptr.
@@ -256,6 +287,13 @@ public slots:
      */
     void onRemovePlugin(QModelIndex const & index);
 
+private slots:
+    /*!
+     * \brief loadNextPlugin Loads the pending Plugin with the highest
+     * priority and schedules the loading of the next one.
+     */
+    void loadNextPlugin();
+
 private:
     /*!
      * \brief pluginslist_t is the data type used for mPlugins which stores
@@ -264,10 +302,17 @@ private:
      * \sa mPlugins
      */
     typedef QList<std::pair <QString/*name*/, QPointer<Plugin> > > pluginslist_t;
+    /*!
+     * \brief pendinglist_t is the data type used for mPendingPlugins.
+     *
+     * \sa mPendingPlugins
+     */
+    typedef QList<std::pair <QString/*name*/, LXQt::PluginInfo> > pendinglist_t;
 
 private:
     /*!
-     * \brief loadPlugins Loads all the Plugins.
+     * \brief loadPlugins Finds the .desktop-files of all the Plugins and
+     * queues them for loading (see loadNextPlugin()).
      * \param desktopDirs These directories are scanned for corresponding
      * .desktop-files which are necessary to load the plugins.
      */
@@ -330,6 +375,12 @@ private:
      * \sa pluginslist_t
      */
     pluginslist_t mPlugins;
+    /*!
+     * \brief mPendingPlugins Stores the Plugins which are not loaded yet,
+     * sorted by their loading priority. Their entries in mPlugins hold a
+     * nullptr until they are loaded.
+     */
+    pendinglist_t mPendingPlugins;
     /*!
      * \brief mPanel Stores a reference to the LXQtPanel.
      */
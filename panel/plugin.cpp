@@ -29,6 +29,7 @@
 #include "plugin.h"
 #include "ilxqtpanelplugin.h"
 #include "pluginsettings_p.h"
+#include "startupprofiler.h"
 #include "lxqtpanel.h"
 
 #include <KX11Extras>
@@ -108,14 +109,14 @@ Plugin::Plugin(const LXQt::PluginInfo &desktopFile, LXQt::Settings *settings, co
     mAlignment(AlignLeft),
     mPanel(panel)
 {
+    StartupProfiler::Span span("plugin", QStringLiteral("Plugin"), desktopFile.id());
+
     mSettings = PluginSettingsFactory::create(settings, settingsGroup);
 
     setWindowTitle(desktopFile.name());
     mName = desktopFile.name();
 
-    QStringList dirs;
-    dirs << QProcessEnvironment::systemEnvironment().value(QStringLiteral("LXQTPANEL_PLUGIN_PATH")).split(QStringLiteral(":"));
-    dirs << QStringLiteral(PLUGIN_DIR);
+    const QStringList dirs = moduleDirs();
 
     bool found = false;
     if(ILXQtPanelPluginLibrary const * pluginLib = findStaticPlugin(desktopFile.id()))
@@ -126,6 +127,7 @@ Plugin::Plugin(const LXQt::PluginInfo &desktopFile, LXQt::Settings *settings, co
     }
     else {
         // this plugin is a dynamically loadable module
+        // a copy that fails to load falls back to the next directory
         QString baseName = QStringLiteral("lib%1.so").arg(desktopFile.id());
         for(const QString &dirName : std::as_const(dirs))
         {
@@ -274,9 +276,41 @@ ILXQtPanelPluginLibrary const * Plugin::findStaticPlugin(const QString &libraryN
     return nullptr;
 }
 
+/************************************************
+
+ ************************************************/
+QStringList Plugin::moduleDirs()
+{
+    QStringList dirs;
+    dirs << QProcessEnvironment::systemEnvironment().value(QStringLiteral("LXQTPANEL_PLUGIN_PATH")).split(QStringLiteral(":"));
+    dirs << QStringLiteral(PLUGIN_DIR);
+    return dirs;
+}
+
+/************************************************
+
+ ************************************************/
+QString Plugin::moduleFileName(const QString &pluginId)
+{
+    if (findStaticPlugin(pluginId))
+        return QString();
+
+    const QString baseName = QStringLiteral("lib%1.so").arg(pluginId);
+    const QStringList dirs = moduleDirs();
+    for (const QString &dirName : dirs)
+    {
+        QFileInfo fi(QDir(dirName), baseName);
+        if (fi.exists())
+            return fi.absoluteFilePath();
+    }
+    return QString();
+}
+
 // load a plugin from a library
 bool Plugin::loadLib(ILXQtPanelPluginLibrary const * pluginLib)
 {
+    StartupProfiler::Span span("plugin", QStringLiteral("Plugin::loadLib"), mDesktopFile.id());
+
     ILXQtPanelPluginStartupInfo startupInfo;
     startupInfo.settings = mSettings;
     startupInfo.desktopFile = &mDesktopFile;
@@ -294,6 +328,7 @@ bool Plugin::loadLib(ILXQtPanelPluginLibrary const * pluginLib)
     {
         mPluginWidget->setObjectName(mPlugin->themeId());
         watchWidgets(mPluginWidget);
+        StartupProfiler::watchFirstPaint(mPluginWidget, mDesktopFile.id());
     }
     this->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
     return true;
@@ -302,6 +337,8 @@ bool Plugin::loadLib(ILXQtPanelPluginLibrary const * pluginLib)
 // load dynamic plugin from a *.so module
 bool Plugin::loadModule(const QString &libraryName)
 {
+    StartupProfiler::Span span("plugin", QStringLiteral("Plugin::loadModule"), mDesktopFile.id());
+
     mPluginLoader = new QPluginLoader(libraryName);
 
     if (!mPluginLoader->load())
@@ -361,6 +398,7 @@ void Plugin::unwatchWidgets(QObject * const widget)
  ************************************************/
 void Plugin::settingsChanged()
 {
+    StartupProfiler::Span span("plugin", QStringLiteral("Plugin::settingsChanged"), mDesktopFile.id());
     mPlugin->settingsChanged();
 }
 
@@ -377,6 +415,17 @@ void Plugin::saveSettings()
 }
 
 
+/************************************************
+
+ ************************************************/
+void Plugin::saveLayoutCache()
+{
+    mSettings->setValue(QStringLiteral("sizeHint"), sizeHint());
+    mSettings->setValue(QStringLiteral("expandable"), isExpandable());
+    mSettings->setValue(QStringLiteral("separate"), isSeparate());
+}
+
+
 /************************************************
 
  ************************************************/
@@ -31,6 +31,7 @@
 
 #include <QFrame>
 #include <QString>
+#include <QStringList>
 #include <QPointer>
 #include <LXQt/PluginInfo>
 #include <LXQt/Settings>
@@ -68,6 +69,12 @@ public:
     QString settingsGroup() const { return mSettings->group(); }
 
     void saveSettings();
+    /*!
+     * \brief saveLayoutCache stores the current size hint and the
+     * expandable/separate state in the settings. They are used for the
+     * placeholder of the plugin at the next startup.
+     */
+    void saveLayoutCache();
 
     QMenu* popupMenu() const;
     const ILXQtPanelPlugin * iPlugin() const { return mPlugin; }
@@ -87,6 +94,18 @@ public:
     static QColor moveMarkerColor() { return mMoveMarkerColor; }
     static void setMoveMarkerColor(QColor color) { mMoveMarkerColor = color; }
 
+    /*!
+     * \brief moduleDirs returns the directories searched for dynamically
+     * loadable plugin modules (LXQTPANEL_PLUGIN_PATH and PLUGIN_DIR).
+     */
+    static QStringList moduleDirs();
+    /*!
+     * \brief moduleFileName returns the absolute path of the module of
+     * the given plugin type (desktop file id), or an empty string if the
+     * plugin is statically linked or its module can't be found.
+     */
+    static QString moduleFileName(const QString &pluginId);
+
 public slots:
     void realign();
     void showConfigureDialog();
@@ -110,7 +129,7 @@ protected:
 private:
     bool loadLib(ILXQtPanelPluginLibrary const * pluginLib);
     bool loadModule(const QString &libraryName);
-    ILXQtPanelPluginLibrary const * findStaticPlugin(const QString &libraryName);
+    static ILXQtPanelPluginLibrary const * findStaticPlugin(const QString &libraryName);
     void watchWidgets(QObject * const widget);
     void unwatchWidgets(QObject * const widget);
 
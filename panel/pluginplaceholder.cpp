@@ -0,0 +1,61 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt.org
+ *
+ * Copyright: 2026 LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "pluginplaceholder.h"
+
+/************************************************
+
+ ************************************************/
+PluginPlaceholder::PluginPlaceholder(const QString &settingsGroup, Plugin::Alignment alignment, const QSize &sizeHint, QWidget *parent) :
+    QWidget(parent),
+    mSettingsGroup(settingsGroup),
+    mAlignment(alignment),
+    mSizeHint(sizeHint),
+    mExpandable(false),
+    mSeparate(false)
+{
+    setObjectName(QStringLiteral("PluginPlaceholder"));
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    // same as the Plugin, to get the same geometry in the layout
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+}
+
+
+/************************************************
+
+ ************************************************/
+void PluginPlaceholder::setExpandable(bool expandable)
+{
+    mExpandable = expandable;
+}
+
+
+/************************************************
+
+ ************************************************/
+void PluginPlaceholder::setSeparate(bool separate)
+{
+    mSeparate = separate;
+}
@@ -0,0 +1,77 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt.org
+ *
+ * Copyright: 2026 LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#ifndef PLUGINPLACEHOLDER_H
+#define PLUGINPLACEHOLDER_H
+
+#include <QWidget>
+#include "plugin.h"
+
+/*!
+ * \brief The PluginPlaceholder class is an empty widget that keeps the slot
+ * of a Plugin in the LXQtPanelLayout until the Plugin is loaded.
+ *
+ * The panel shows its frame with the placeholders right away and the
+ * PanelPluginsModel loads the Plugins afterwards, one by one, from the event
+ * loop. When a Plugin is ready, LXQtPanelLayout::replacePlaceholder() puts it
+ * in the place of its placeholder.
+ */
+class PluginPlaceholder : public QWidget
+{
+    Q_OBJECT
+public:
+    /*!
+     * \param settingsGroup The name of the Plugin (its settings group).
+     * \param alignment The alignment of the Plugin as stored in the settings.
+     * \param sizeHint The size hint of the Plugin cached at the last run.
+     */
+    PluginPlaceholder(const QString &settingsGroup, Plugin::Alignment alignment, const QSize &sizeHint, QWidget *parent = nullptr);
+
+    QString settingsGroup() const { return mSettingsGroup; }
+    Plugin::Alignment alignment() const { return mAlignment; }
+
+    QSize sizeHint() const override { return mSizeHint; }
+
+    /*!
+     * \brief The cached Plugin::isExpandable() state of the Plugin.
+     */
+    bool isExpandable() const { return mExpandable; }
+    void setExpandable(bool expandable);
+
+    /*!
+     * \brief The cached Plugin::isSeparate() state of the Plugin.
+     */
+    bool isSeparate() const { return mSeparate; }
+    void setSeparate(bool separate);
+
+private:
+    const QString mSettingsGroup;
+    const Plugin::Alignment mAlignment;
+    const QSize mSizeHint;
+    bool mExpandable;
+    bool mSeparate;
+};
+
+#endif // PLUGINPLACEHOLDER_H
@@ -0,0 +1,99 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt.org
+ *
+ * Copyright: 2026 LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "pluginpreloader.h"
+#include "plugin.h"
+#include "startupprofiler.h"
+
+#include <QFile>
+#include <QPluginLoader>
+#include <LXQt/Settings>
+
+#include <fcntl.h>
+
+/************************************************
+
+ ************************************************/
+PluginPreloader::PluginPreloader()
+{
+}
+
+/************************************************
+
+ ************************************************/
+PluginPreloader::~PluginPreloader()
+{
+    waitForDone();
+    // NOTE: our loaders keep the (cached) metadata alive, so the preloader
+    // must live until the plugins are created
+    qDeleteAll(mLoaders);
+}
+
+/************************************************
+
+ ************************************************/
+void PluginPreloader::preload(const QString &pluginId)
+{
+    if (pluginId.isEmpty() || mRequested.contains(pluginId))
+        return;
+    mRequested.insert(pluginId);
+
+    const QString fileName = Plugin::moduleFileName(pluginId);
+    if (fileName.isEmpty())
+        return; // static plugin or not found
+
+    QPluginLoader *loader = new QPluginLoader(fileName);
+    mLoaders.append(loader);
+    mPool.start([loader, fileName, pluginId] {
+        StartupProfiler::Span span("plugin", QStringLiteral("PluginPreloader::preload"), pluginId);
+        // start reading the whole module, the dlopen() on the GUI thread will find it in the page cache
+        QFile file(fileName);
+        if (file.open(QIODevice::ReadOnly))
+            posix_fadvise(file.handle(), 0, 0, POSIX_FADV_WILLNEED);
+        // errors are ignored here, the Plugin will report them when loading the module
+        loader->metaData();
+    });
+}
+
+/************************************************
+
+ ************************************************/
+void PluginPreloader::preloadPanels(LXQt::Settings *settings, const QStringList &panels)
+{
+    for (const QString &panel : panels)
+    {
+        const QStringList names = settings->value(panel + QStringLiteral("/plugins")).toStringList();
+        for (const QString &name : names)
+            preload(settings->value(name + QStringLiteral("/type")).toString());
+    }
+}
+
+/************************************************
+
+ ************************************************/
+void PluginPreloader::waitForDone()
+{
+    mPool.waitForDone();
+}
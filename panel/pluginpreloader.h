@@ -0,0 +1,89 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt.org
+ *
+ * Copyright: 2026 LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#ifndef PLUGINPRELOADER_H
+#define PLUGINPRELOADER_H
+
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QThreadPool>
+
+namespace LXQt
+{
+    class Settings;
+}
+
+class QPluginLoader;
+
+/*!
+ * \brief The PluginPreloader class prepares the dynamic plugin modules
+ * (the lib<id>.so files) on a pool of worker threads.
+ *
+ * For every module the workers read and parse the plugin metadata (the
+ * expensive part of QPluginLoader::load() before dlopen()) and ask the
+ * kernel to read the whole file ahead. Both are cached/shared, so the
+ * QPluginLoader created later by the Plugin finds the metadata ready and
+ * the dlopen() doesn't wait for the disk.
+ *
+ * The dlopen() itself and QPluginLoader::instance() stay on the GUI thread:
+ * the static initializers of the modules (e.g. the plugin translation
+ * loaders) install objects into the application, which must not happen on
+ * a worker thread. (glibc serializes dlopen() calls anyway.)
+ *
+ * Statically linked plugins and plugins whose module can't be found are
+ * skipped; the Plugin constructor reports them as before.
+ */
+class PluginPreloader
+{
+public:
+    PluginPreloader();
+    ~PluginPreloader();
+
+    /*!
+     * \brief preload Queues the module of the given plugin type (the
+     * desktop file id, e.g. "mainmenu"). Each module is processed only
+     * once, no matter how many times it is requested.
+     */
+    void preload(const QString &pluginId);
+    /*!
+     * \brief preloadPanels Queues the modules of all the plugins configured
+     * in the given panels.
+     * \param settings The panel settings (panel.conf).
+     * \param panels The names of the panels (config groups).
+     */
+    void preloadPanels(LXQt::Settings *settings, const QStringList &panels);
+    /*!
+     * \brief waitForDone Blocks until all the queued modules are processed.
+     */
+    void waitForDone();
+
+private:
+    QThreadPool mPool;
+    QSet<QString> mRequested; //!< plugin ids already queued
+    QList<QPluginLoader *> mLoaders;
+};
+
+#endif // PLUGINPRELOADER_H
@@ -0,0 +1,245 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt.org
+ *
+ * Copyright: 2026 LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "startupprofiler.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QSet>
+#include <QThread>
+#include <QWidget>
+#include <QDebug>
+
+#include <atomic>
+
+namespace
+{
+    class FirstPaintWatcher : public QObject
+    {
+    public:
+        QHash<QObject *, QString> mWidgets;
+
+        bool eventFilter(QObject *watched, QEvent *event) override
+        {
+            if (event->type() == QEvent::Paint)
+            {
+                StartupProfiler::instant("paint", QStringLiteral("first paint"), mWidgets.take(watched));
+                watched->removeEventFilter(this);
+            }
+            return false;
+        }
+    };
+
+    struct ProfilerData
+    {
+        QMutex mutex;
+        QElapsedTimer timer;
+        QString fileName;
+        QJsonArray events;
+        QHash<Qt::HANDLE, int> threads; //!< thread handle -> tid in the trace
+        QSet<QPair<const void *, QByteArray>> once;
+        FirstPaintWatcher *watcher = nullptr;
+    };
+
+    std::atomic<bool> sActive{false};
+    ProfilerData *sData = nullptr;
+
+    // NOTE: must be called with the mutex locked
+    QJsonObject newEvent(const char *category, const QString &name, const QString &detail, const char *phase, qint64 ts)
+    {
+        const Qt::HANDLE thread = QThread::currentThreadId();
+        auto it = sData->threads.constFind(thread);
+        if (it == sData->threads.constEnd())
+            it = sData->threads.insert(thread, sData->threads.size() + 1);
+
+        QJsonObject event;
+        event.insert(QLatin1String("cat"), QLatin1String(category));
+        event.insert(QLatin1String("name"), name);
+        event.insert(QLatin1String("ph"), QLatin1String(phase));
+        event.insert(QLatin1String("ts"), ts);
+        event.insert(QLatin1String("pid"), QCoreApplication::applicationPid());
+        event.insert(QLatin1String("tid"), it.value());
+        if (!detail.isEmpty())
+            event.insert(QLatin1String("args"), QJsonObject{{QLatin1String("detail"), detail}});
+        return event;
+    }
+
+    inline qint64 now()
+    {
+        return sData->timer.nsecsElapsed() / 1000;
+    }
+}
+
+/************************************************
+
+ ************************************************/
+StartupProfiler::Span::Span(const char *category, const QString &name, const QString &detail, bool enabled) :
+    mCategory(category),
+    mStart(-1)
+{
+    if (enabled && isActive())
+    {
+        mName = name;
+        mDetail = detail;
+        mStart = now();
+    }
+}
+
+/************************************************
+
+ ************************************************/
+void StartupProfiler::Span::setDetail(const QString &detail)
+{
+    if (mStart >= 0)
+        mDetail = detail;
+}
+
+/************************************************
+
+ ************************************************/
+StartupProfiler::Span::~Span()
+{
+    if (mStart < 0)
+        return;
+
+    QMutexLocker locker(&sData->mutex);
+    if (!isActive())
+        return;
+    QJsonObject event = newEvent(mCategory, mName, mDetail, "X", mStart);
+    event.insert(QLatin1String("dur"), now() - mStart);
+    sData->events.append(event);
+}
+
+/************************************************
+
+ ************************************************/
+void StartupProfiler::start(const QString &fileName)
+{
+    if (sData)
+        return;
+    sData = new ProfilerData;
+    sData->fileName = fileName;
+    sData->threads.insert(QThread::currentThreadId(), 1); // the GUI thread
+    sData->watcher = new FirstPaintWatcher;
+    sData->timer.start();
+    sActive = true;
+}
+
+/************************************************
+
+ ************************************************/
+void StartupProfiler::finish()
+{
+    if (!isActive())
+        return;
+
+    QMutexLocker locker(&sData->mutex);
+    sActive = false;
+    delete sData->watcher; // removes the remaining event filters
+    sData->watcher = nullptr;
+
+    // name the threads of the timeline
+    for (auto it = sData->threads.constBegin(); it != sData->threads.constEnd(); ++it)
+    {
+        const QString name = it.value() == 1 ? QStringLiteral("GUI") : QStringLiteral("worker %1").arg(it.value() - 1);
+        sData->events.append(QJsonObject{
+                {QLatin1String("name"), QLatin1String("thread_name")},
+                {QLatin1String("ph"), QLatin1String("M")},
+                {QLatin1String("pid"), QCoreApplication::applicationPid()},
+                {QLatin1String("tid"), it.value()},
+                {QLatin1String("args"), QJsonObject{{QLatin1String("name"), name}}}});
+    }
+
+    QFile file(sData->fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning() << "StartupProfiler: can't write" << sData->fileName << ':' << file.errorString();
+        return;
+    }
+    const QJsonObject trace{
+        {QLatin1String("traceEvents"), sData->events},
+        {QLatin1String("displayTimeUnit"), QLatin1String("ms")}};
+    file.write(QJsonDocument(trace).toJson(QJsonDocument::Compact));
+    sData->events = QJsonArray();
+}
+
+/************************************************
+
+ ************************************************/
+bool StartupProfiler::isActive()
+{
+    return sActive.load(std::memory_order_relaxed);
+}
+
+/************************************************
+
+ ************************************************/
+bool StartupProfiler::firstTime(const void *object, const char *key)
+{
+    if (!isActive())
+        return false;
+
+    QMutexLocker locker(&sData->mutex);
+    const auto entry = qMakePair(object, QByteArray(key));
+    if (sData->once.contains(entry))
+        return false;
+    sData->once.insert(entry);
+    return true;
+}
+
+/************************************************
+
+ ************************************************/
+void StartupProfiler::instant(const char *category, const QString &name, const QString &detail)
+{
+    if (!isActive())
+        return;
+
+    QMutexLocker locker(&sData->mutex);
+    if (!isActive())
+        return;
+    QJsonObject event = newEvent(category, name, detail, "i", now());
+    event.insert(QLatin1String("s"), QLatin1String("t")); // thread scoped
+    sData->events.append(event);
+}
+
+/************************************************
+
+ ************************************************/
+void StartupProfiler::watchFirstPaint(QWidget *widget, const QString &detail)
+{
+    if (!isActive() || !widget)
+        return;
+
+    sData->watcher->mWidgets.insert(widget, detail);
+    widget->installEventFilter(sData->watcher);
+}
@@ -0,0 +1,112 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt.org
+ *
+ * Copyright: 2026 LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#ifndef STARTUPPROFILER_H
+#define STARTUPPROFILER_H
+
+#include <QString>
+
+class QWidget;
+
+/*!
+ * \brief The StartupProfiler class records a timeline of the panel startup
+ * (enabled with the --startup-profile command line option).
+ *
+ * The recorded events are written as a Chrome trace event JSON file, which
+ * can be opened by Perfetto (https://ui.perfetto.dev) or chrome://tracing.
+ * Recording stops and the file is written when finish() is called, which
+ * happens a few seconds after startup or when the panel quits, whatever
+ * comes first.
+ *
+ * When the profiler is not active, all the functions return immediately.
+ * Events can be recorded from any thread.
+ */
+class StartupProfiler
+{
+public:
+    /*!
+     * \brief The Span class records the time between its construction and
+     * its destruction as one "complete" event.
+     */
+    class Span
+    {
+    public:
+        /*!
+         * \param category The trace category, e.g. "plugin".
+         * \param name The name of the span.
+         * \param detail Optional detail, stored in the event arguments
+         * (e.g. the plugin id).
+         * \param enabled Can be used to record only some calls (see firstTime()).
+         */
+        Span(const char *category, const QString &name, const QString &detail = QString(), bool enabled = true);
+        ~Span();
+
+        /*!
+         * \brief isRecording Returns true if the span will be recorded.
+         * Can be used to skip the computation of a detail.
+         */
+        bool isRecording() const { return mStart >= 0; }
+        /*!
+         * \brief setDetail Replaces the detail, e.g. with a result known only
+         * at the end of the span.
+         */
+        void setDetail(const QString &detail);
+
+    private:
+        Q_DISABLE_COPY(Span)
+        const char *mCategory;
+        QString mName;
+        QString mDetail;
+        qint64 mStart; //!< -1 if not recording
+    };
+
+    /*!
+     * \brief start Starts the recording.
+     * \param fileName The trace file to write in finish().
+     */
+    static void start(const QString &fileName);
+    /*!
+     * \brief finish Stops the recording and writes the trace file.
+     */
+    static void finish();
+    static bool isActive();
+
+    /*!
+     * \brief firstTime Returns true only for the first call with the given
+     * object and key while the profiler is active.
+     */
+    static bool firstTime(const void *object, const char *key);
+    /*!
+     * \brief instant Records an instant event.
+     */
+    static void instant(const char *category, const QString &name, const QString &detail = QString());
+    /*!
+     * \brief watchFirstPaint Records an instant event when the widget gets
+     * its first paint event.
+     */
+    static void watchFirstPaint(QWidget *widget, const QString &detail);
+};
+
+#endif // STARTUPPROFILER_H
@@ -0,0 +1,716 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt.org
+ *
+ * Copyright: 2026 LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "systemsampler.h"
+#include "lxqtpanellimits.h"
+
+#include <QByteArrayView>
+#include <QDebug>
+
+#include <algorithm>
+#include <limits>
+
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef HAVE_STATGRAB
+extern "C" {
+#include <statgrab.h>
+}
+
+#ifdef __sg_public
+// since libstatgrab 0.90 this macro is defined, so we use it for version check
+#define STATGRAB_NEWER_THAN_0_90 	1
+#endif
+#endif
+
+namespace
+{
+int openFile(const char *path)
+{
+    return ::open(path, O_RDONLY | O_CLOEXEC);
+}
+
+void closeFile(int &fd)
+{
+    if (fd >= 0)
+        ::close(fd);
+    fd = -1;
+}
+
+// The whole file into buffer, read again from the start. The buffer keeps
+// its capacity from one reading to the next: the files of /proc have no
+// size, it grows until the file fits in one pass.
+bool readFile(int fd, QByteArray &buffer)
+{
+    if (fd < 0)
+    {
+        buffer.resize(0);
+        return false;
+    }
+
+    buffer.resize(qMax<qsizetype>(buffer.capacity(), 4096));
+    for (;;)
+    {
+        qsizetype size = 0;
+        for (;;)
+        {
+            const ssize_t read = ::pread(fd, buffer.data() + size, static_cast<size_t>(buffer.size() - size), size);
+            if (read < 0 && errno == EINTR)
+                continue;
+            if (read < 0)
+            {
+                buffer.resize(0);
+                return false;
+            }
+            if (read == 0 || (size += read) == buffer.size())
+                break;
+        }
+
+        if (size < buffer.size())
+        {
+            buffer.resize(size);
+            return true;
+        }
+        // start again, so that the contents are of one reading
+        buffer.resize(buffer.size() * 2);
+    }
+}
+
+const char *skipSpaces(const char *p, const char *end)
+{
+    while (p < end && (*p == ' ' || *p == '\t'))
+        ++p;
+    return p;
+}
+
+const char *skipLine(const char *p, const char *end)
+{
+    while (p < end && *(p++) != '\n')
+        ;
+    return p;
+}
+
+const char *parseNumber(const char *p, const char *end, quint64 &value)
+{
+    value = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; ++p)
+        value = value * 10 + static_cast<quint64>(*p - '0');
+    return p;
+}
+
+// e.g. of the cpufreq files
+quint64 readNumber(int fd)
+{
+    char buffer[32];
+    const ssize_t size = fd < 0 ? -1 : ::pread(fd, buffer, sizeof(buffer), 0);
+    quint64 value = 0;
+    if (size > 0)
+        parseNumber(skipSpaces(buffer, buffer + size), buffer + size, value);
+    return value;
+}
+
+// without sharing, so that to keeps its capacity and from is never detached
+template <typename T>
+void copyInto(QVector<T> &to, const QVector<T> &from)
+{
+    to.resize(from.size());
+    std::copy(from.cbegin(), from.cend(), to.begin());
+}
+
+quint64 delta(quint64 current, quint64 previous)
+{
+    return current > previous ? current - previous : 0;
+}
+}
+
+const SystemSampler::NetworkUsage *SystemSampler::Sample::networkUsage(const QString &interface) const
+{
+    const int index = interfaces.indexOf(interface);
+    return index < 0 || index >= network.size() ? nullptr : &network.at(index);
+}
+
+SystemSampler::SystemSampler(QObject *parent) :
+    QObject(parent),
+    mNextId(1),
+    mStatFd(-1),
+    mMeminfoFd(-1),
+    mNetDevFd(-1),
+    mNetworkTime(0),
+    mInterfacesGeneration(0),
+    mStatgrab(false)
+{
+    mTimer.setSingleShot(true);
+    connect(&mTimer, &QTimer::timeout, this, &SystemSampler::sample);
+    mClock.start();
+}
+
+SystemSampler::~SystemSampler()
+{
+    closeFile(mStatFd);
+    closeFile(mMeminfoFd);
+    closeFile(mNetDevFd);
+    for (int &fd : mFrequencyFds)
+        closeFile(fd);
+#ifdef HAVE_STATGRAB
+    if (mStatgrab)
+        sg_shutdown();
+#endif
+}
+
+int SystemSampler::subscribe(QObject *context, Sources sources, int interval, Callback callback)
+{
+    const int id = mNextId++;
+
+    Subscription &subscription = mSubscriptions[id];
+    subscription.sources = sources;
+    subscription.interval = qMax(interval, 1);
+    subscription.due = mClock.elapsed() + subscription.interval;
+    subscription.callback = std::make_shared<const Callback>(std::move(callback));
+    if (context)
+        subscription.contextConnection = connect(context, &QObject::destroyed, this, [this, id] { unsubscribe(id); });
+
+    // the counters of the first call are compared with these
+    read(sources);
+    keepReading(subscription);
+
+    schedule();
+    return id;
+}
+
+void SystemSampler::unsubscribe(int id)
+{
+    auto it = mSubscriptions.find(id);
+    if (it == mSubscriptions.end())
+        return;
+
+    disconnect(it->contextConnection);
+    mSubscriptions.erase(it);
+    schedule();
+}
+
+QStringList SystemSampler::sourceNames(Source source)
+{
+    QStringList names;
+    switch (source)
+    {
+    case Cpu:
+        readCpu();
+        if (!mCpu.isEmpty())
+            names << QStringLiteral("cpu");
+        for (int i = 1; i < mCpu.size(); ++i)
+            names << QStringLiteral("cpu%1").arg(i - 1);
+        break;
+
+    case Memory:
+        names << QStringLiteral("memory") << QStringLiteral("swap");
+        break;
+
+    case Network:
+        readNetwork();
+        names = mInterfaces;
+        break;
+
+    default:
+        break;
+    }
+    return names;
+}
+
+void SystemSampler::schedule()
+{
+    if (mSubscriptions.isEmpty())
+    {
+        mTimer.stop();
+        return;
+    }
+
+    qint64 due = std::numeric_limits<qint64>::max();
+    for (const Subscription &subscription : std::as_const(mSubscriptions))
+        due = qMin(due, subscription.due);
+    mTimer.start(static_cast<int>(qMax<qint64>(0, due - mClock.elapsed())));
+}
+
+void SystemSampler::sample()
+{
+    const qint64 now = mClock.elapsed();
+
+    // the subscriptions due a bit later share this reading
+    mDue.resize(0);
+    Sources sources;
+    for (auto it = mSubscriptions.cbegin(), it_end = mSubscriptions.cend(); it != it_end; ++it)
+    {
+        if (it->due <= now + SYSTEM_SAMPLER_SLACK)
+        {
+            mDue.append(it.key());
+            sources |= it->sources;
+        }
+    }
+
+    read(sources);
+
+    for (const int id : std::as_const(mDue))
+    {
+        // a callback can unsubscribe the others
+        auto it = mSubscriptions.find(id);
+        if (it == mSubscriptions.end())
+            continue;
+
+        fillSample(*it);
+        keepReading(*it);
+        it->due += it->interval;
+        if (it->due <= now)
+            it->due = now + it->interval;
+
+        // it can unsubscribe itself too, the callback is kept until it returns
+        const std::shared_ptr<const Callback> callback = it->callback;
+        (*callback)(mSample);
+    }
+
+    schedule();
+}
+
+void SystemSampler::read(Sources sources)
+{
+    if (sources & Cpu)
+    {
+        readCpu();
+        if (sources & CpuFrequency)
+            readFrequencies();
+    }
+    if (sources & Memory)
+        readMemory();
+    if (sources & Network)
+        readNetwork();
+}
+
+void SystemSampler::readCpu()
+{
+    // parsed in place, mStatBuffer and mCpu keep their capacity, so that
+    // reading many cores every second allocates nothing
+    if (mStatFd < 0)
+        mStatFd = openFile("/proc/stat");
+    if (mStatFd < 0 && useStatgrab())
+    {
+        readStatgrabCpu();
+        return;
+    }
+    if (!readFile(mStatFd, mStatBuffer))
+    {
+        mCpu.resize(0);
+        return;
+    }
+
+    int count = 0;
+    const char *p = mStatBuffer.constData();
+    const char *end = p + mStatBuffer.size();
+    // the lines of the cpus come first
+    while (end - p > 3 && qstrncmp(p, "cpu", 3) == 0)
+    {
+        // cpu[N] user nice system idle iowait irq softirq steal guest guest_nice
+        p += 3;
+        quint64 core = 0;
+        const bool all = p < end && (*p == ' ' || *p == '\t');
+        if (!all)
+            p = parseNumber(p, end, core);
+
+        quint64 values[8] = {};
+        for (int i = 0; i < 8; ++i)
+            p = parseNumber(skipSpaces(p, end), end, values[i]);
+        p = skipLine(p, end);
+
+        // offline cores have no line, keep "cpuN" at N + 1
+        const int index = all ? 0 : static_cast<int>(core) + 1;
+        if (index < count)
+            continue;
+        if (index >= mCpu.size())
+            mCpu.resize(index + 1);
+        for (; count < index; ++count)
+            mCpu[count] = CpuCounters();
+        count = index + 1;
+
+        CpuCounters &counters = mCpu[index];
+        counters.user = values[0];
+        counters.nice = values[1];
+        counters.system = values[2];
+        counters.other = values[5] + values[6] + values[7];
+        // the guest time is counted in the user time already
+        counters.total = values[0] + values[1] + values[2] + values[3] + values[4] + counters.other;
+    }
+    mCpu.resize(count);
+}
+
+void SystemSampler::readFrequencies()
+{
+    const int count = mCpu.size();
+    if (mMaxFrequencies.size() != count)
+    {
+        // the cores changed, open the files again
+        for (int &fd : mFrequencyFds)
+            closeFile(fd);
+        mFrequencyFds.fill(-1, count);
+        mMaxFrequencies.fill(0, count);
+        for (int i = 1; i < count; ++i)
+        {
+            const QByteArray path = "/sys/devices/system/cpu/cpu" + QByteArray::number(i - 1) + "/cpufreq/";
+            int fd = openFile((path + "cpuinfo_max_freq").constData());
+            mMaxFrequencies[i] = static_cast<uint>(readNumber(fd));
+            closeFile(fd);
+            // no cpufreq
+            if (mMaxFrequencies.at(i) > 0)
+                mFrequencyFds[i] = openFile((path + "scaling_cur_freq").constData());
+        }
+    }
+
+    mFrequencies.fill(0, count);
+    quint64 current = 0;
+    quint64 maximum = 0;
+    int cores = 0;
+    for (int i = 1; i < count; ++i)
+    {
+        if (mFrequencyFds.at(i) < 0)
+            continue;
+        mFrequencies[i] = static_cast<uint>(readNumber(mFrequencyFds.at(i)));
+        current += mFrequencies.at(i);
+        maximum += mMaxFrequencies.at(i);
+        ++cores;
+    }
+
+    // "cpu" is the average of the cores
+    if (cores > 0)
+    {
+        mFrequencies[0] = static_cast<uint>(current / cores);
+        mMaxFrequencies[0] = static_cast<uint>(maximum / cores);
+    }
+}
+
+void SystemSampler::readMemory()
+{
+    quint64 total = 0;
+    quint64 free = 0;
+    quint64 buffers = 0;
+    quint64 cached = 0;
+    quint64 swapTotal = 0;
+    quint64 swapFree = 0;
+
+    struct Key
+    {
+        QByteArrayView name;
+        quint64 *value;
+    };
+    quint64 reclaimable = 0;
+    const Key keys[] = {
+        {"MemTotal", &total},
+        {"MemFree", &free},
+        {"Buffers", &buffers},
+        {"Cached", &cached},
+        {"SReclaimable", &reclaimable},
+        {"SwapTotal", &swapTotal},
+        {"SwapFree", &swapFree}
+    };
+
+    if (mMeminfoFd < 0)
+        mMeminfoFd = openFile("/proc/meminfo");
+    if (mMeminfoFd < 0 && useStatgrab())
+    {
+        readStatgrabMemory();
+        return;
+    }
+    readFile(mMeminfoFd, mMeminfoBuffer);
+
+    const char *p = mMeminfoBuffer.constData();
+    const char *end = p + mMeminfoBuffer.size();
+    while (p < end)
+    {
+        // Key:   value kB
+        const char *colon = std::find(p, end, ':');
+        if (colon == end)
+            break;
+        const QByteArrayView name(p, colon - p);
+        for (const Key &key : keys)
+        {
+            if (name == key.name)
+            {
+                parseNumber(skipSpaces(colon + 1, end), end, *key.value);
+                break;
+            }
+        }
+        p = skipLine(colon, end);
+    }
+    cached += reclaimable;
+
+    mMemory = MemoryUsage();
+    if (total > 0)
+    {
+        mMemory.apps = static_cast<float>(delta(total, free + buffers + cached)) / total;
+        mMemory.buffers = static_cast<float>(buffers) / total;
+        mMemory.cached = static_cast<float>(cached) / total;
+    }
+    if (swapTotal > 0)
+        mMemory.swapUsed = static_cast<float>(delta(swapTotal, swapFree)) / swapTotal;
+}
+
+void SystemSampler::readNetwork()
+{
+    mNetworkTime = mClock.elapsed();
+    if (mNetDevFd < 0)
+        mNetDevFd = openFile("/proc/net/dev");
+    if (mNetDevFd < 0 && useStatgrab())
+    {
+        readStatgrabNetwork();
+        return;
+    }
+    readFile(mNetDevFd, mNetDevBuffer);
+
+    const char *p = mNetDevBuffer.constData();
+    const char *end = p + mNetDevBuffer.size();
+    // two lines of headers, then
+    // interface: rx_bytes packets errs drop fifo frame compressed multicast tx_bytes ...
+    p = skipLine(skipLine(p, end), end);
+
+    int count = 0;
+    bool changed = false;
+    while (p < end)
+    {
+        const char *colon = std::find(p, end, ':');
+        if (colon == end)
+            break;
+        const char *name = skipSpaces(p, colon);
+        const QByteArrayView interface(name, colon - name);
+
+        quint64 fields[9] = {};
+        const char *field = colon + 1;
+        for (quint64 &value : fields)
+            field = parseNumber(skipSpaces(field, end), end, value);
+        p = skipLine(field, end);
+
+        changed |= setInterface(count++, interface, fields[0], fields[8]);
+    }
+    setInterfaceCount(count, changed);
+}
+
+bool SystemSampler::setInterface(int index, QByteArrayView name, quint64 received, quint64 transmitted)
+{
+    if (index >= mNetwork.size())
+        mNetwork.resize(index + 1);
+    mNetwork[index].received = received;
+    mNetwork[index].transmitted = transmitted;
+
+    // the names are converted only when the interfaces change
+    if (index < mInterfaceNames.size() && QByteArrayView(mInterfaceNames.at(index)) == name)
+        return false;
+    mInterfaceNames.resize(index + 1);
+    mInterfaceNames[index] = name.toByteArray();
+    return true;
+}
+
+void SystemSampler::setInterfaceCount(int count, bool changed)
+{
+    if (changed || count != mInterfaceNames.size())
+    {
+        mInterfaceNames.resize(count);
+        mInterfaces.clear();
+        for (const QByteArray &name : std::as_const(mInterfaceNames))
+            mInterfaces << QString::fromLocal8Bit(name);
+        ++mInterfacesGeneration;
+    }
+    mNetwork.resize(count);
+}
+
+bool SystemSampler::useStatgrab()
+{
+#ifdef HAVE_STATGRAB
+    if (!mStatgrab)
+    {
+#ifdef STATGRAB_NEWER_THAN_0_90
+        sg_init(0);
+#else
+        sg_init();
+#endif
+        if (sg_drop_privileges() != 0)
+            qWarning() << "SystemSampler: failed to drop the privileges of libstatgrab";
+        mStatgrab = true;
+    }
+    return true;
+#else
+    static bool warned = false;
+    if (!warned)
+        qWarning() << "SystemSampler: no /proc and no libstatgrab, the system statistics are not available";
+    warned = true;
+    return false;
+#endif
+}
+
+// Without /proc, the statistics of libstatgrab: the load of all the cores only,
+// no frequencies, no buffers.
+void SystemSampler::readStatgrabCpu()
+{
+#ifdef HAVE_STATGRAB
+#ifdef STATGRAB_NEWER_THAN_0_90
+    const sg_cpu_stats *stats = sg_get_cpu_stats(nullptr);
+#else
+    const sg_cpu_stats *stats = sg_get_cpu_stats();
+#endif
+    if (!stats)
+    {
+        mCpu.resize(0);
+        return;
+    }
+
+    mCpu.resize(1);
+    CpuCounters &counters = mCpu[0];
+    counters.user = static_cast<quint64>(stats->user);
+    counters.nice = static_cast<quint64>(stats->nice);
+    counters.system = static_cast<quint64>(stats->kernel);
+    counters.other = 0;
+    counters.total = static_cast<quint64>(stats->total);
+#endif
+}
+
+void SystemSampler::readStatgrabMemory()
+{
+    mMemory = MemoryUsage();
+#ifdef HAVE_STATGRAB
+#ifdef STATGRAB_NEWER_THAN_0_90
+    const sg_mem_stats *memory = sg_get_mem_stats(nullptr);
+    const sg_swap_stats *swap = sg_get_swap_stats(nullptr);
+#else
+    const sg_mem_stats *memory = sg_get_mem_stats();
+    const sg_swap_stats *swap = sg_get_swap_stats();
+#endif
+    if (memory && memory->total > 0)
+    {
+        const quint64 total = static_cast<quint64>(memory->total);
+        const quint64 cached = static_cast<quint64>(memory->cache);
+        mMemory.apps = static_cast<float>(delta(static_cast<quint64>(memory->used), cached)) / total;
+        mMemory.cached = static_cast<float>(cached) / total;
+    }
+    if (swap && swap->total > 0)
+        mMemory.swapUsed = static_cast<float>(swap->used) / swap->total;
+#endif
+}
+
+void SystemSampler::readStatgrabNetwork()
+{
+    int count = 0;
+    bool changed = false;
+#ifdef HAVE_STATGRAB
+#ifdef STATGRAB_NEWER_THAN_0_90
+    size_t entries = 0;
+#else
+    int entries = 0;
+#endif
+    const sg_network_io_stats *stats = sg_get_network_io_stats(&entries);
+    for (; stats && count < static_cast<int>(entries); ++count)
+    {
+        const sg_network_io_stats &interface = stats[count];
+        changed |= setInterface(count, QByteArrayView(interface.interface_name),
+                                static_cast<quint64>(interface.rx), static_cast<quint64>(interface.tx));
+    }
+#endif
+    setInterfaceCount(count, changed);
+}
+
+void SystemSampler::fillSample(const Subscription &subscription)
+{
+    // mSample keeps its capacity from one call to the next
+    if (subscription.sources & Cpu)
+    {
+        mSample.cpu.resize(mCpu.size());
+        for (int i = 0; i < mCpu.size(); ++i)
+        {
+            CpuLoad &load = mSample.cpu[i];
+            load = CpuLoad();
+
+            const CpuCounters &current = mCpu.at(i);
+            const CpuCounters &previous = i < subscription.cpu.size() ? subscription.cpu.at(i) : current;
+            const quint64 total = delta(current.total, previous.total);
+            if (total == 0)
+                continue;
+
+            load.user = static_cast<float>(delta(current.user, previous.user)) / total;
+            load.nice = static_cast<float>(delta(current.nice, previous.nice)) / total;
+            load.system = static_cast<float>(delta(current.system, previous.system)) / total;
+            load.other = static_cast<float>(delta(current.other, previous.other)) / total;
+        }
+
+        if (subscription.sources & CpuFrequency)
+        {
+            for (int i = 0; i < mCpu.size() && i < mFrequencies.size(); ++i)
+            {
+                CpuLoad &load = mSample.cpu[i];
+                load.frequency = mFrequencies.at(i) / 1000;
+                if (mMaxFrequencies.at(i) > 0)
+                    load.frequencyRate = static_cast<float>(mFrequencies.at(i)) / mMaxFrequencies.at(i);
+            }
+        }
+    }
+    else
+        mSample.cpu.resize(0);
+
+    mSample.memory = subscription.sources & Memory ? mMemory : MemoryUsage();
+
+    if (subscription.sources & Network)
+    {
+        // the previous counters are by index, valid while the interfaces are the same
+        const bool samePrevious = subscription.networkGeneration == mInterfacesGeneration;
+        const qint64 elapsed = mNetworkTime - subscription.networkTime;
+        mSample.interfaces = mInterfaces;
+        mSample.network.resize(mNetwork.size());
+        for (int i = 0; i < mNetwork.size(); ++i)
+        {
+            const NetworkCounters &current = mNetwork.at(i);
+            NetworkUsage &usage = mSample.network[i];
+            usage = NetworkUsage();
+            usage.received = current.received;
+            usage.transmitted = current.transmitted;
+
+            if (samePrevious && i < subscription.network.size() && elapsed > 0)
+            {
+                const NetworkCounters &previous = subscription.network.at(i);
+                usage.receiveRate = delta(current.received, previous.received) * 1000 / elapsed;
+                usage.transmitRate = delta(current.transmitted, previous.transmitted) * 1000 / elapsed;
+            }
+        }
+    }
+    else
+    {
+        mSample.interfaces.clear();
+        mSample.network.resize(0);
+    }
+}
+
+void SystemSampler::keepReading(Subscription &subscription) const
+{
+    if (subscription.sources & Cpu)
+        copyInto(subscription.cpu, mCpu);
+    if (subscription.sources & Network)
+    {
+        copyInto(subscription.network, mNetwork);
+        subscription.networkTime = mNetworkTime;
+        subscription.networkGeneration = mInterfacesGeneration;
+    }
+}
@@ -0,0 +1,216 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt.org
+ *
+ * Copyright: 2026 LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#ifndef SYSTEMSAMPLER_H
+#define SYSTEMSAMPLER_H
+
+#include <QObject>
+#include <QByteArrayView>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
+
+#include <functional>
+#include <memory>
+
+#include "lxqtpanelglobals.h"
+
+/*!
+ * \brief The SystemSampler class reads the system statistics shown by the
+ * plugins (sysstat, cpuload, networkmonitor) once for all their instances.
+ *
+ * The plugins subscribe with the sources they show and their update interval.
+ * The sampler wakes up when the earliest subscription is due, reads every
+ * source needed by the subscriptions due by then once (/proc/stat, the
+ * cpufreq files, /proc/meminfo, /proc/net/dev) and passes the same reading to
+ * all of them. The files are kept open and parsed in place, into buffers
+ * reused from one reading to the next. Where there is no such file (e.g. on
+ * FreeBSD), the statistics are read with libstatgrab, if the panel is built
+ * with it. Loads and rates are computed over the interval of each
+ * subscription, from the counters of its previous call, so a subscription is
+ * not affected by the faster ones.
+ *
+ * There is one sampler, see LXQtPanelApplication::getSystemSampler(). No timer
+ * runs while nothing is subscribed.
+ */
+class LXQT_PANEL_API SystemSampler : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Source
+    {
+        Cpu = 0x1,
+        CpuFrequency = 0x2, //!< with Cpu
+        Memory = 0x4, //!< memory and swap
+        Network = 0x8
+    };
+    Q_DECLARE_FLAGS(Sources, Source)
+
+    //! Fractions of the time, in [0, 1]
+    struct CpuLoad
+    {
+        float user = 0;
+        float nice = 0;
+        float system = 0;
+        float other = 0; //!< interrupts and stolen time
+        float frequencyRate = 0; //!< current / maximum frequency (CpuFrequency)
+        uint frequency = 0; //!< MHz (CpuFrequency)
+    };
+
+    //! Fractions of the memory and of the swap
+    struct MemoryUsage
+    {
+        float apps = 0;
+        float buffers = 0;
+        float cached = 0;
+        float swapUsed = 0;
+    };
+
+    struct NetworkUsage
+    {
+        quint64 received = 0; //!< bytes, since the interface is up
+        quint64 transmitted = 0;
+        quint64 receiveRate = 0; //!< bytes per second
+        quint64 transmitRate = 0;
+    };
+
+    struct LXQT_PANEL_API Sample
+    {
+        QVector<CpuLoad> cpu; //!< all the cores ("cpu"), then each of them ("cpu0"...)
+        MemoryUsage memory;
+        QVector<NetworkUsage> network; //!< in the order of interfaces
+        QStringList interfaces;
+
+        //! nullptr if there is no such interface
+        const NetworkUsage *networkUsage(const QString &interface) const;
+    };
+
+    using Callback = std::function<void (const Sample &)>;
+
+    explicit SystemSampler(QObject *parent = nullptr);
+    ~SystemSampler();
+
+    /*!
+     * \brief Calls \p callback with the \p sources every \p interval ms, until
+     * unsubscribe() or the destruction of \p context. The sample is reused,
+     * it is valid only during the call.
+     * \return The id of the subscription, for unsubscribe().
+     */
+    int subscribe(QObject *context, Sources sources, int interval, Callback callback);
+    void unsubscribe(int id);
+
+    /*!
+     * \brief The names of the sources, e.g. for the configuration dialogs:
+     * "cpu", "cpu0"... for Cpu, "memory" and "swap" for Memory, the
+     * interfaces for Network.
+     */
+    QStringList sourceNames(Source source);
+
+private:
+    struct CpuCounters
+    {
+        quint64 user = 0;
+        quint64 nice = 0;
+        quint64 system = 0;
+        quint64 other = 0;
+        quint64 total = 0; //!< including the idle time
+    };
+
+    struct NetworkCounters
+    {
+        quint64 received = 0;
+        quint64 transmitted = 0;
+    };
+
+    struct Subscription
+    {
+        Sources sources;
+        int interval = 0;
+        qint64 due = 0; //!< ms of mClock
+        // shared with sample() during the call, in case the subscription is
+        // removed or moved (by another subscribe()) meanwhile
+        std::shared_ptr<const Callback> callback;
+        QMetaObject::Connection contextConnection;
+
+        // the reading of the previous call
+        QVector<CpuCounters> cpu;
+        QVector<NetworkCounters> network;
+        qint64 networkTime = 0;
+        int networkGeneration = 0; //!< of the interfaces of network
+    };
+
+    void schedule();
+    void sample();
+    void read(Sources sources);
+    void readCpu();
+    void readFrequencies();
+    void readMemory();
+    void readNetwork();
+    bool setInterface(int index, QByteArrayView name, quint64 received, quint64 transmitted);
+    void setInterfaceCount(int count, bool changed);
+    bool useStatgrab();
+    void readStatgrabCpu();
+    void readStatgrabMemory();
+    void readStatgrabNetwork();
+    void fillSample(const Subscription &subscription);
+    void keepReading(Subscription &subscription) const;
+
+private:
+    QHash<int, Subscription> mSubscriptions;
+    int mNextId;
+    QTimer mTimer;
+    QElapsedTimer mClock;
+
+    QVector<int> mDue; //!< subscriptions of the current sample()
+    Sample mSample; //!< passed to the callbacks, filled again for each one
+
+    // Kept open, read again with pread() into buffers that keep their size
+    int mStatFd;
+    int mMeminfoFd;
+    int mNetDevFd;
+    QVector<int> mFrequencyFds; //!< scaling_cur_freq, per core, -1 without cpufreq
+    QByteArray mStatBuffer;
+    QByteArray mMeminfoBuffer;
+    QByteArray mNetDevBuffer;
+
+    // The last reading, updated in place
+    QVector<CpuCounters> mCpu;
+    QVector<uint> mFrequencies; //!< kHz, per core
+    QVector<uint> mMaxFrequencies;
+    MemoryUsage mMemory;
+    QVector<NetworkCounters> mNetwork; //!< in the order of mInterfaces
+    QVector<QByteArray> mInterfaceNames; //!< as in /proc/net/dev
+    QStringList mInterfaces; //!< in the order of /proc/net/dev
+    qint64 mNetworkTime;
+    int mInterfacesGeneration; //!< changes with mInterfaces
+    bool mStatgrab; //!< libstatgrab is initialized, without /proc
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(SystemSampler::Sources)
+
+#endif // SYSTEMSAMPLER_H
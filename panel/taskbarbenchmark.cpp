@@ -0,0 +1,314 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt.org
+ *
+ * Copyright: 2026 LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "taskbarbenchmark.h"
+#include "backends/lxqttaskbarsyntheticbackend.h"
+#include "lxqtpanellimits.h"
+
+#include <QFile>
+#include <QSettings>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <QDebug>
+
+#include <algorithm>
+#include <time.h>
+#include <unistd.h>
+
+namespace
+{
+const char * const changeKeys[] = {"title", "icon", "state", "workspace", "urgency"};
+
+double microseconds(qint64 nsecs, int count)
+{
+    return count > 0 ? nsecs / 1000.0 / count : 0.0;
+}
+}
+
+TaskBarBenchmark::TaskBarBenchmark(LXQtTaskBarSyntheticBackend *backend, const QString &scenario, QObject *parent) :
+    QObject(parent),
+    mBackend(backend),
+    mRandom(1), // the same changes on every run
+    mWindowCounts{10, 100, 1000},
+    mClasses(20),
+    mWorkspaces(4),
+    mDuration(5000),
+    mLightweightView(false),
+    mRates{50.0, 2.0, 5.0, 1.0, 1.0},
+    mStep(0),
+    mBudget{},
+    mCpuStart(0),
+    mChangeTimer(new QTimer(this))
+{
+    parseScenario(scenario);
+
+    mChangeTimer->setInterval(TASKBAR_BENCH_TICK);
+    connect(mChangeTimer, &QTimer::timeout, this, &TaskBarBenchmark::applyChanges);
+}
+
+void TaskBarBenchmark::parseScenario(const QString &scenario)
+{
+    const QStringList pairs = scenario.split(QLatin1Char(','), Qt::SkipEmptyParts);
+    for (const QString &pair : pairs)
+    {
+        const QString key = pair.section(QLatin1Char('='), 0, 0).trimmed();
+        const QString value = pair.section(QLatin1Char('='), 1).trimmed();
+
+        if (key == QLatin1String("windows"))
+        {
+            mWindowCounts.clear();
+            const QStringList counts = value.split(QLatin1Char('/'), Qt::SkipEmptyParts);
+            for (const QString &count : counts)
+                mWindowCounts.append(qMax(1, count.toInt()));
+            continue;
+        }
+        if (key == QLatin1String("classes"))
+        {
+            mClasses = qMax(1, value.toInt());
+            continue;
+        }
+        if (key == QLatin1String("workspaces"))
+        {
+            mWorkspaces = qMax(1, value.toInt());
+            continue;
+        }
+        if (key == QLatin1String("duration"))
+        {
+            mDuration = qMax(0, value.toInt());
+            continue;
+        }
+        if (key == QLatin1String("view"))
+        {
+            mLightweightView = value == QLatin1String("lightweight");
+            if (!mLightweightView && value != QLatin1String("buttons"))
+                qWarning() << "TaskBarBenchmark: unknown view" << value;
+            continue;
+        }
+
+        const auto change = std::find_if(std::begin(changeKeys), std::end(changeKeys), [&key] (const char *changeKey) {
+            return key == QLatin1String(changeKey);
+        });
+        if (change != std::end(changeKeys))
+            mRates[change - std::begin(changeKeys)] = qMax(0.0, value.toDouble());
+        else
+            qWarning() << "TaskBarBenchmark: unknown scenario key" << key;
+    }
+}
+
+QString TaskBarBenchmark::configFile() const
+{
+    // removed after the panel has saved its settings on exit
+    static QTemporaryDir dir;
+    if (!dir.isValid())
+        return QString();
+
+    const QString fileName = dir.filePath(QStringLiteral("panel.conf"));
+    QSettings settings(fileName, QSettings::IniFormat);
+    settings.clear();
+    settings.setValue(QStringLiteral("panels"), QStringList{QStringLiteral("panel1")});
+    settings.beginGroup(QStringLiteral("panel1"));
+    settings.setValue(QStringLiteral("plugins"), QStringList{QStringLiteral("taskbar")});
+    settings.endGroup();
+    settings.beginGroup(QStringLiteral("taskbar"));
+    settings.setValue(QStringLiteral("type"), QStringLiteral("taskbar"));
+    settings.setValue(QStringLiteral("lightweightView"), mLightweightView);
+    settings.endGroup();
+    settings.sync();
+    return settings.status() == QSettings::NoError ? fileName : QString();
+}
+
+void TaskBarBenchmark::start()
+{
+    mBackend->setWorkspacesCount(mWorkspaces);
+    qInfo().noquote() << QStringLiteral("TaskBarBenchmark: %1 view, %2 classes, %3 workspaces, %4 ms of changes per step")
+                         .arg(mLightweightView ? QStringLiteral("lightweight") : QStringLiteral("buttons"))
+                         .arg(mClasses).arg(mWorkspaces).arg(mDuration);
+    mStep = 0;
+    runStep();
+}
+
+void TaskBarBenchmark::runStep()
+{
+    if (mStep >= mWindowCounts.size())
+    {
+        emit finished();
+        return;
+    }
+
+    mStats = Stats();
+    mStats.rssBefore = residentMemory();
+
+    const int count = mWindowCounts.at(mStep);
+    mWindows.reserve(count);
+    QElapsedTimer timer;
+    for (int i = 0; i < count; ++i)
+    {
+        const int windowClass = i % mClasses;
+        timer.start();
+        mWindows.append(mBackend->addWindow(QStringLiteral("bench-class-%1").arg(windowClass),
+                                            QStringLiteral("Window %1").arg(i),
+                                            iconData(windowClass, 0)));
+        const qint64 elapsed = timer.nsecsElapsed();
+        mStats.addTotal += elapsed;
+        mStats.addMax = qMax(mStats.addMax, elapsed);
+    }
+
+    // let the taskbar finish its deferred work (layout, icons...) first
+    QTimer::singleShot(TASKBAR_BENCH_SETTLE_TIME, this, &TaskBarBenchmark::startChanges);
+}
+
+void TaskBarBenchmark::startChanges()
+{
+    std::fill(std::begin(mBudget), std::end(mBudget), 0.0);
+    mCpuStart = cpuTime();
+    mChangeTime.start();
+    mChangeTimer->start();
+}
+
+void TaskBarBenchmark::applyChanges()
+{
+    const bool last = mChangeTime.elapsed() >= mDuration;
+
+    for (int type = 0; type < ChangeCount; ++type)
+    {
+        mBudget[type] += mRates[type] * TASKBAR_BENCH_TICK / 1000.0;
+        for (; mBudget[type] >= 1.0; mBudget[type] -= 1.0)
+            change(static_cast<Change>(type));
+    }
+
+    if (!last)
+        return;
+
+    mChangeTimer->stop();
+    // count the deferred handling of the last changes too
+    QTimer::singleShot(TASKBAR_BENCH_SETTLE_TIME, this, &TaskBarBenchmark::finishStep);
+}
+
+void TaskBarBenchmark::finishStep()
+{
+    mStats.cpuTime = cpuTime() - mCpuStart;
+    mStats.rssAfter = residentMemory();
+
+    QElapsedTimer timer;
+    for (const WId windowId : std::as_const(mWindows))
+    {
+        timer.start();
+        mBackend->removeWindow(windowId);
+        const qint64 elapsed = timer.nsecsElapsed();
+        mStats.removeTotal += elapsed;
+        mStats.removeMax = qMax(mStats.removeMax, elapsed);
+    }
+
+    const int count = mWindows.size();
+    qInfo().noquote() << QStringLiteral("TaskBarBenchmark: %1 windows: add %2 us (max %3 us), remove %4 us (max %5 us),"
+                                        " %6 us CPU per change (%7 changes), RSS %8 KiB")
+                         .arg(count)
+                         .arg(microseconds(mStats.addTotal, count), 0, 'f', 1)
+                         .arg(microseconds(mStats.addMax, 1), 0, 'f', 1)
+                         .arg(microseconds(mStats.removeTotal, count), 0, 'f', 1)
+                         .arg(microseconds(mStats.removeMax, 1), 0, 'f', 1)
+                         .arg(microseconds(mStats.cpuTime, mStats.changes), 0, 'f', 1)
+                         .arg(mStats.changes)
+                         .arg(mStats.rssBefore < 0 || mStats.rssAfter < 0
+                              ? QStringLiteral("n/a")
+                              : QString::asprintf("%+lld", (mStats.rssAfter - mStats.rssBefore) / 1024));
+    mWindows.clear();
+
+    ++mStep;
+    QTimer::singleShot(TASKBAR_BENCH_SETTLE_TIME, this, &TaskBarBenchmark::runStep);
+}
+
+void TaskBarBenchmark::change(Change type)
+{
+    if (mWindows.isEmpty())
+        return;
+
+    const int index = mRandom.bounded(mWindows.size());
+    const WId windowId = mWindows.at(index);
+    switch (type)
+    {
+    case TitleChange:
+        // like a progress in the title
+        mBackend->setWindowTitle(windowId, QStringLiteral("Window %1 - %2%").arg(index).arg(mRandom.bounded(101)));
+        break;
+
+    case IconChange:
+        mBackend->setWindowIconData(windowId, iconData(index % mClasses, mRandom.bounded(1, 4)));
+        break;
+
+    case StateChange:
+    {
+        const bool minimized = mBackend->getWindowState(windowId) == LXQtTaskBarWindowState::Minimized;
+        mBackend->setWindowState(windowId, LXQtTaskBarWindowState::Minimized, !minimized);
+        break;
+    }
+
+    case WorkspaceChange:
+        mBackend->setWindowOnWorkspace(windowId, mRandom.bounded(1, mWorkspaces + 1));
+        break;
+
+    case UrgencyChange:
+        mBackend->setWindowUrgency(windowId, !mBackend->applicationDemandsAttention(windowId));
+        break;
+
+    case ChangeCount:
+        break;
+    }
+    ++mStats.changes;
+}
+
+QByteArray TaskBarBenchmark::iconData(int windowClass, int variant) const
+{
+    // a single 32x32 image in the _NET_WM_ICON layout, one color per class and variant
+    constexpr quint32 size = 32;
+    const quint32 color = 0xff000000u | ((windowClass * 0x3b) & 0xff) << 16 | ((variant * 0x55) & 0xff) << 8 | 0x80;
+
+    QByteArray data((2 + size * size) * sizeof(quint32), Qt::Uninitialized);
+    quint32 *words = reinterpret_cast<quint32 *>(data.data());
+    words[0] = size;
+    words[1] = size;
+    std::fill(words + 2, words + 2 + size * size, color);
+    return data;
+}
+
+qint64 TaskBarBenchmark::cpuTime()
+{
+    timespec ts;
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) != 0)
+        return 0;
+    return qint64(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+qint64 TaskBarBenchmark::residentMemory()
+{
+    // statm: size resident shared ... in pages
+    QFile statm(QStringLiteral("/proc/self/statm"));
+    if (!statm.open(QIODevice::ReadOnly))
+        return -1;
+    const QList<QByteArray> fields = statm.readAll().split(' ');
+    if (fields.size() < 2)
+        return -1;
+    return fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE);
+}
@@ -0,0 +1,141 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt.org
+ *
+ * Copyright: 2026 LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#ifndef TASKBARBENCHMARK_H
+#define TASKBARBENCHMARK_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QVector>
+
+#include "backends/lxqttaskbartypes.h"
+
+class QTimer;
+class LXQtTaskBarSyntheticBackend;
+
+/*!
+ * \brief The TaskBarBenchmark class measures how the taskbar scales with the
+ * number of windows. It runs in lxqt-panel-taskbar-bench, the panel built with
+ * the BUILD_TASKBAR_BENCHMARK CMake option; the lxqt-panel executable doesn't
+ * contain it.
+ *
+ * It drives LXQtTaskBarSyntheticBackend as a synthetic window manager, in
+ * place of the real one, so the taskbar plugins and their models react to its
+ * windows as usual. For every window count of the scenario it:
+ * - adds the windows one by one, timing each windowAdded() (its slots are
+ *   called directly, so this is the cost of adding a window);
+ * - changes titles, icons, states, workspaces and urgencies at the given
+ *   rates for a while, and divides the CPU time of the process by the number
+ *   of changes;
+ * - records the growth of the resident memory;
+ * - removes the windows one by one, timing each windowRemoved().
+ *
+ * A line is printed for every window count, then finished() is emitted.
+ * Running the panel offscreen (QT_QPA_PLATFORM=offscreen) isolates the
+ * taskbar from the compositor.
+ *
+ * The panel doesn't use the configuration of the user but configFile(): a
+ * single panel with the taskbar alone, in the view of the scenario.
+ *
+ * The scenario (the --scenario option) is a comma separated list of key=value pairs, e.g.
+ * "windows=10/100/1000,classes=20,title=50,duration=5000,view=lightweight".
+ * Rates are changes per second over all the windows. The view is "buttons"
+ * (the default) or "lightweight" (LXQtTaskBarView).
+ */
+class TaskBarBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    TaskBarBenchmark(LXQtTaskBarSyntheticBackend *backend, const QString &scenario, QObject *parent = nullptr);
+
+    void start();
+
+    /*!
+     * \brief The configuration file of the panel, in a temporary directory
+     * removed at exit. Empty if it can't be written.
+     */
+    QString configFile() const;
+
+signals:
+    void finished();
+
+private:
+    enum Change
+    {
+        TitleChange = 0,
+        IconChange,
+        StateChange,
+        WorkspaceChange,
+        UrgencyChange,
+        ChangeCount
+    };
+
+    struct Stats
+    {
+        qint64 addTotal = 0;
+        qint64 addMax = 0;
+        qint64 removeTotal = 0;
+        qint64 removeMax = 0;
+        qint64 cpuTime = 0;
+        int changes = 0;
+        qint64 rssBefore = 0;
+        qint64 rssAfter = 0;
+    };
+
+    void parseScenario(const QString &scenario);
+    void runStep();
+    void startChanges();
+    void applyChanges();
+    void finishStep();
+    void change(Change type);
+    QByteArray iconData(int windowClass, int variant) const;
+
+    static qint64 cpuTime();
+    static qint64 residentMemory();
+
+private:
+    LXQtTaskBarSyntheticBackend *mBackend;
+    QRandomGenerator mRandom;
+
+    // Scenario
+    QVector<int> mWindowCounts;
+    int mClasses;
+    int mWorkspaces;
+    int mDuration; //!< ms of changes for every window count
+    bool mLightweightView;
+    double mRates[ChangeCount];
+
+    int mStep;
+    Stats mStats;
+    QVector<WId> mWindows;
+    double mBudget[ChangeCount];
+    QElapsedTimer mChangeTime;
+    qint64 mCpuStart;
+    QTimer *mChangeTimer;
+};
+
+#endif // TASKBARBENCHMARK_H
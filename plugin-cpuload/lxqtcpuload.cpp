@@ -28,33 +28,43 @@
 #include "lxqtcpuload.h"
 #include "../panel/ilxqtpanelplugin.h"
 #include "../panel/pluginsettings.h"
+#include "../panel/lxqtpanelapplication.h"
+#include "../panel/systemsampler.h"
 #include <QPainter>
 #include <QLinearGradient>
 #include <QHBoxLayout>
 
-extern "C" {
-#include <statgrab.h>
-}
-
-#ifdef __sg_public
-// since libstatgrab 0.90 this macro is defined, so we use it for version check
-#define STATGRAB_NEWER_THAN_0_90 	1
-#endif
+#include <array>
 
 #define BAR_ORIENT_BOTTOMUP "bottomUp"
 #define BAR_ORIENT_TOPDOWN "topDown"
 #define BAR_ORIENT_LEFTRIGHT "leftRight"
 #define BAR_ORIENT_RIGHTLEFT "rightLeft"
 
+namespace
+{
+// by load percentage, from green to red, computed once
+const QColor &loadColour(int load)
+{
+    static const std::array<QColor, 101> colours = [] {
+        std::array<QColor, 101> result;
+        for (int i = 0; i <= 100; ++i)
+            result[i] = QColor::fromHsvF((1.0f - i / 100.0f) / 3.0f, 1.0f, 0.77f);
+        return result;
+    }();
+    return colours[qBound(0, load, 100)];
+}
+}
 
 LXQtCpuLoad::LXQtCpuLoad(ILXQtPanelPlugin* plugin, QWidget* parent):
     QFrame(parent),
     mPlugin(plugin),
     m_avg(0),
     m_showText(false),
+    m_perCore(false),
     m_barWidth(20),
     m_barOrientation(TopDownBar),
-    m_timerID(-1)
+    m_subscription(0)
 {
     setObjectName(QStringLiteral("LXQtCpuLoad"));
 
@@ -63,27 +73,12 @@ LXQtCpuLoad::LXQtCpuLoad(ILXQtPanelPlugin* plugin, QWidget* parent):
     layout->setContentsMargins(0, 0, 0, 0);
     layout->addWidget(&m_stuff);
 
-    /* Initialise statgrab */
-#ifdef STATGRAB_NEWER_THAN_0_90
-    sg_init(0);
-#else
-    sg_init();
-#endif
-
-    /* Drop setuid/setgid privileges. */
-    if (sg_drop_privileges() != 0) {
-        perror("Error. Failed to drop privileges");
-    }
-
     m_font.setPointSizeF(8);
 
     settingsChanged();
 }
 
-LXQtCpuLoad::~LXQtCpuLoad()
-{
-  sg_shutdown();
-}
+LXQtCpuLoad::~LXQtCpuLoad() = default;
 
 void LXQtCpuLoad::setSizes()
 {
@@ -106,28 +101,100 @@ void LXQtCpuLoad::resizeEvent(QResizeEvent *)
 }
 
 
-double LXQtCpuLoad::getLoadCpu() const
+void LXQtCpuLoad::loadSampled(const SystemSampler::Sample &sample)
 {
-#ifdef STATGRAB_NEWER_THAN_0_90
-    size_t count;
-    sg_cpu_percents* cur = sg_get_cpu_percents(&count);
-#else
-    sg_cpu_percents* cur = sg_get_cpu_percents();
-#endif
-    return (cur->user + cur->kernel + cur->nice);
-}
+    if (sample.cpu.isEmpty())
+        return;
 
-void LXQtCpuLoad::timerEvent(QTimerEvent * /*event*/)
-{
-    double avg = getLoadCpu();
-    if ( qAbs(m_avg-avg)>1 )
-    {
+    // all the cores
+    const SystemSampler::CpuLoad &load = sample.cpu.first();
+    double avg = (load.user + load.system + load.nice) * 100.0;
+    bool changed = qAbs(m_avg-avg)>1;
+    if (changed)
         m_avg = avg;
+
+    if (m_perCore)
+    {
+        // "cpu" is the first one, then "cpu0"...
+        const int cores = sample.cpu.size() - 1;
+        if (m_coreLoads.size() != cores)
+        {
+            m_coreLoads.fill(0, cores);
+            changed = true;
+        }
+
+        int busiest = 0;
+        for (int core = 0; core < cores; ++core)
+        {
+            const SystemSampler::CpuLoad &coreLoad = sample.cpu.at(core + 1);
+            const int coreAvg = static_cast<int>((coreLoad.user + coreLoad.system + coreLoad.nice) * 100.0);
+            if (m_coreLoads.at(core) != coreAvg)
+            {
+                m_coreLoads[core] = coreAvg;
+                changed = true;
+            }
+            if (coreAvg > m_coreLoads.at(busiest))
+                busiest = core;
+        }
+
+        if (changed)
+        {
+            setToolTip(tr("CPU load %1%<br>busiest: cpu%2 %3%").arg(m_avg).arg(busiest).arg(m_coreLoads.value(busiest)));
+            update();
+        }
+    }
+    else if (changed)
+    {
         setToolTip(tr("CPU load %1%").arg(m_avg));
         update();
     }
 }
 
+void LXQtCpuLoad::paintCores(QPainter &p)
+{
+    const int cores = m_coreLoads.size();
+    if (cores == 0)
+        return;
+
+    // the area of the single bar, a slot per core across it
+    const QRectF r = rect();
+    const bool horizontal = m_barOrientation == RightToLeftBar || m_barOrientation == LeftToRightBar;
+    QRectF area;
+    if (horizontal)
+    {
+        const qreal vo = (r.height() - static_cast<qreal>(m_barWidth)) / 2.0;
+        area = r.adjusted(0, vo, 0, -vo);
+    }
+    else
+    {
+        const qreal ho = (r.width() - static_cast<qreal>(m_barWidth)) / 2.0;
+        area = r.adjusted(ho, 0, -ho, 0);
+    }
+    const qreal slot = (horizontal ? area.height() : area.width()) / cores;
+
+    for (int core = 0; core < cores; ++core)
+    {
+        const int load = qBound(0, m_coreLoads.at(core), 100);
+        if (load == 0)
+            continue;
+
+        QRectF bar;
+        if (horizontal)
+        {
+            const qreal length = area.width() * load / 100.0;
+            bar.setRect(m_barOrientation == RightToLeftBar ? area.right() - length : area.left(),
+                        area.top() + core * slot, length, slot);
+        }
+        else
+        {
+            const qreal length = area.height() * load / 100.0;
+            bar.setRect(area.left() + core * slot,
+                        m_barOrientation == BottomUpBar ? area.bottom() - length : area.top(), slot, length);
+        }
+        p.fillRect(bar, loadColour(load));
+    }
+}
+
 void LXQtCpuLoad::paintEvent ( QPaintEvent * )
 {
     QPainter p(this);
@@ -137,6 +204,18 @@ void LXQtCpuLoad::paintEvent ( QPaintEvent * )
     p.setRenderHint(QPainter::Antialiasing, true);
 
     p.setFont(m_font);
+
+    if (m_perCore)
+    {
+        paintCores(p);
+        if (m_showText)
+        {
+            p.setPen(fontColor);
+            p.drawText(rect(), Qt::AlignCenter, QString::number(m_avg));
+        }
+        return;
+    }
+
     QRectF r = rect();
 
     QRectF r1;
@@ -189,10 +268,13 @@ void LXQtCpuLoad::paintEvent ( QPaintEvent * )
 
 void LXQtCpuLoad::settingsChanged()
 {
-    if (m_timerID != -1)
-        killTimer(m_timerID);
+    SystemSampler *sampler = static_cast<LXQtPanelApplication *>(qApp)->getSystemSampler();
+    if (m_subscription)
+        sampler->unsubscribe(m_subscription);
 
     m_showText = mPlugin->settings()->value(QStringLiteral("showText"), false).toBool();
+    m_perCore = mPlugin->settings()->value(QStringLiteral("perCore"), false).toBool();
+    m_coreLoads.clear();
     m_barWidth = mPlugin->settings()->value(QStringLiteral("barWidth"), 20).toInt();
     m_updateInterval = mPlugin->settings()->value(QStringLiteral("updateInterval"), 1000).toInt();
 
@@ -206,7 +288,8 @@ void LXQtCpuLoad::settingsChanged()
     else
         m_barOrientation = BottomUpBar;
 
-    m_timerID = startTimer(m_updateInterval);
+    m_subscription = sampler->subscribe(this, SystemSampler::Cpu, m_updateInterval,
+                                        [this] (const SystemSampler::Sample &sample) { loadSampled(sample); });
     setSizes();
     update();
 }
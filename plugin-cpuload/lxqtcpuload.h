@@ -29,7 +29,10 @@
 #define LXQTCPULOAD_H
 #include <QLabel>
 
+#include "../panel/systemsampler.h"
+
 class ILXQtPanelPlugin;
+class QPainter;
 
 class LXQtCpuLoad: public QFrame
 {
@@ -58,12 +61,13 @@ public:
     QColor getFontColor() const { return fontColor; }
 
 protected:
-    void virtual timerEvent(QTimerEvent *event);
     void virtual paintEvent ( QPaintEvent * event );
     void virtual resizeEvent(QResizeEvent *);
 
 private:
-    double getLoadCpu() const;
+    void loadSampled(const SystemSampler::Sample &sample);
+    //! A bar per core, coloured by its load
+    void paintCores(QPainter &p);
     void setSizes();
 
     ILXQtPanelPlugin *mPlugin;
@@ -73,10 +77,12 @@ private:
     int m_avg;
 
     bool m_showText;
+    bool m_perCore;
+    QVector<int> m_coreLoads; //!< percent, reused between the samples
     int m_barWidth;
     BarOrientation m_barOrientation;
     int m_updateInterval;
-    int m_timerID;
+    int m_subscription; //!< to SystemSampler, 0 if none
 
     QFont m_font;
 
@@ -49,6 +49,7 @@ LXQtCpuLoadConfiguration::LXQtCpuLoadConfiguration(PluginSettings *settings, QWi
     loadSettings();
 
     connect(ui->showTextCB,            &QCheckBox::toggled,                                  this, &LXQtCpuLoadConfiguration::showTextChanged);
+    connect(ui->perCoreCB,             &QCheckBox::toggled,                                  this, &LXQtCpuLoadConfiguration::perCoreChanged);
     connect(ui->barWidthSB,            QOverload<int>::of(&QSpinBox::valueChanged),          this, &LXQtCpuLoadConfiguration::barWidthChanged);
     connect(ui->updateIntervalSpinBox, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &LXQtCpuLoadConfiguration::updateIntervalChanged);
     connect(ui->barOrientationCOB,     QOverload<int>::of(&QComboBox::currentIndexChanged),  this, &LXQtCpuLoadConfiguration::barOrientationChanged);
@@ -72,6 +73,7 @@ void LXQtCpuLoadConfiguration::loadSettings()
     mLockSettingChanges = true;
 
     ui->showTextCB->setChecked(settings().value(QStringLiteral("showText"), false).toBool());
+    ui->perCoreCB->setChecked(settings().value(QStringLiteral("perCore"), false).toBool());
     ui->barWidthSB->setValue(settings().value(QStringLiteral("barWidth"), 20).toInt());
     ui->updateIntervalSpinBox->setValue(settings().value(QStringLiteral("updateInterval"), 1000).toInt() / 1000.0);
 
@@ -97,6 +99,12 @@ void LXQtCpuLoadConfiguration::showTextChanged(bool value)
         settings().setValue(QStringLiteral("showText"), value);
 }
 
+void LXQtCpuLoadConfiguration::perCoreChanged(bool value)
+{
+    if (!mLockSettingChanges)
+        settings().setValue(QStringLiteral("perCore"), value);
+}
+
 void LXQtCpuLoadConfiguration::barWidthChanged(int value)
 {
     if (!mLockSettingChanges)
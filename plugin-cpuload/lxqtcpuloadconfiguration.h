@@ -62,6 +62,7 @@ private slots:
     */
     void loadSettings();
     void showTextChanged(bool value);
+    void perCoreChanged(bool value);
     void barWidthChanged(int value);
     void updateIntervalChanged(double value);
     void barOrientationChanged(int index);
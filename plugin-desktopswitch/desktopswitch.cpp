@@ -79,7 +79,7 @@ DesktopSwitch::DesktopSwitch(const ILXQtPanelPluginStartupInfo &startupInfo) :
     connect(mBackend, &ILXQtTaskbarAbstractBackend::currentWorkspaceChanged, this, &DesktopSwitch::onCurrentDesktopChanged);
     connect(mBackend, &ILXQtTaskbarAbstractBackend::workspaceNameChanged,    this, &DesktopSwitch::onDesktopNamesChanged);
 
-    connect(mBackend, &ILXQtTaskbarAbstractBackend::windowPropertyChanged, this, &DesktopSwitch::onWindowChanged);
+    connect(mBackend, &ILXQtTaskbarAbstractBackend::windowPropertiesChanged, this, &DesktopSwitch::onWindowChanged);
 }
 
 void DesktopSwitch::registerShortcuts()
@@ -121,9 +121,9 @@ void DesktopSwitch::shortcutRegistered()
     }
 }
 
-void DesktopSwitch::onWindowChanged(WId id, int prop)
+void DesktopSwitch::onWindowChanged(WId id, int props)
 {
-    if (prop == int(LXQtTaskBarWindowProperty::State))
+    if (props & windowPropertyFlag(LXQtTaskBarWindowProperty::State))
     {
         int desktop = mBackend->getWindowWorkspace(id);
         if (desktop == int(LXQtTaskBarWorkspace::ShowOnAll))
@@ -96,7 +96,7 @@ private slots:
     virtual void settingsChanged();
     void registerShortcuts();
     void shortcutRegistered();
-    void onWindowChanged(WId id, int prop);
+    void onWindowChanged(WId id, int props);
 };
 
 class DesktopSwitchUnsupported : public QObject, public ILXQtPanelPlugin
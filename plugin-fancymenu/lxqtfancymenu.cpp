@@ -30,6 +30,7 @@
 #include "lxqtfancymenuconfiguration.h"
 #include "lxqtfancymenuwindow.h"
 #include "../panel/lxqtpanel.h"
+#include "../panel/lxqtpanellazypopup.h"
 #include <QTimer>
 #include <QMessageBox>
 #include <QEvent>
@@ -56,15 +57,14 @@ LXQtFancyMenu::LXQtFancyMenu(const ILXQtPanelPluginStartupInfo &startupInfo):
     QObject(),
     ILXQtPanelPlugin(startupInfo),
     mWindow(nullptr),
+    mMenuLoaded(false),
     mShortcut(nullptr),
     mFilterClear(false)
 {
-    mWindow = new LXQtFancyMenuWindow(&mButton);
-    mWindow->setObjectName(QStringLiteral("TopLevelFancyMenu"));
-    mWindow->installEventFilter(this);
-    connect(mWindow, &LXQtFancyMenuWindow::aboutToHide, &mHideTimer, QOverload<>::of(&QTimer::start));
-    connect(mWindow, &LXQtFancyMenuWindow::aboutToShow, &mHideTimer, &QTimer::stop);
-    connect(mWindow, &LXQtFancyMenuWindow::favoritesChanged, this, &LXQtFancyMenu::saveFavorites);
+    // the menu window is built on the first hover/activation and released when unused
+    mWindow = new LXQtPanelLazyPopup(this);
+    mWindow->setTrigger(&mButton);
+    mWindow->setFactory([this] { return createWindow(); });
 
     mDelayedPopup.setSingleShot(true);
     mDelayedPopup.setInterval(200);
@@ -125,13 +125,37 @@ LXQtFancyMenu::~LXQtFancyMenu()
 }
 
 
+/************************************************
+
+ ************************************************/
+LXQtFancyMenuWindow *LXQtFancyMenu::createWindow()
+{
+    LXQtFancyMenuWindow *window = new LXQtFancyMenuWindow(&mButton);
+    window->setObjectName(QStringLiteral("TopLevelFancyMenu"));
+    window->installEventFilter(this);
+    connect(window, &LXQtFancyMenuWindow::aboutToHide, &mHideTimer, QOverload<>::of(&QTimer::start));
+    connect(window, &LXQtFancyMenuWindow::aboutToShow, &mHideTimer, &QTimer::stop);
+
+    window->setFavorites(mFavorites);
+    if (mMenuLoaded)
+        window->rebuildMenu(mXdgMenu);
+    applyWindowSettings(window);
+    window->doSearch();
+
+    // connect after setting the favorites, they're already saved
+    connect(window, &LXQtFancyMenuWindow::favoritesChanged, this, &LXQtFancyMenu::saveFavorites);
+    return window;
+}
+
+
 /************************************************
 
  ************************************************/
 void LXQtFancyMenu::showHideMenu()
 {
-    if(mWindow && mWindow->isVisible())
-        mWindow->hide();
+    QWidget *window = mWindow->createdWidget();
+    if(window && window->isVisible())
+        window->hide();
     else
         showMenu();
 }
@@ -141,17 +165,16 @@ void LXQtFancyMenu::showHideMenu()
  ************************************************/
 void LXQtFancyMenu::showMenu()
 {
-    if (!mWindow)
-        return;
+    LXQtFancyMenuWindow *window = mWindow->widget<LXQtFancyMenuWindow>();
 
-    willShowWindow(mWindow);
+    willShowWindow(window);
     // Just using Qt`s activateWindow() won't work on some WMs like Kwin.
     // Solution is to execute menu 1ms later using timer
-    mWindow->move(calculatePopupWindowPos(mWindow->sizeHint()).topLeft());
+    window->move(calculatePopupWindowPos(window->sizeHint()).topLeft());
 
-    emit mWindow->aboutToShow();
-    mWindow->show();
-    mWindow->setSearchEditFocus();
+    emit window->aboutToShow();
+    window->show();
+    window->setSearchEditFocus();
 }
 
 /************************************************
@@ -183,11 +206,11 @@ void LXQtFancyMenu::settingsChanged()
         mXdgMenu.setEnvironments(QStringList() << QStringLiteral("X-LXQT") << QStringLiteral("LXQt"));
         mXdgMenu.setLogDir(mLogDir);
 
-        bool res = mXdgMenu.read(mMenuFile);
+        mMenuLoaded = mXdgMenu.read(mMenuFile);
         connect(&mXdgMenu, &XdgMenu::changed, this, &LXQtFancyMenu::buildMenu);
-        if (res)
+        if (mMenuLoaded)
         {
-            QTimer::singleShot(1000, this, &LXQtFancyMenu::buildMenu);
+            buildMenu();
         }
         else
         {
@@ -197,23 +220,34 @@ void LXQtFancyMenu::settingsChanged()
     }
 
     loadFavorites();
-    setMenuFontSize();
 
     //clear the search to not leaving the menu in wrong state
     mFilterClear = settings()->value(QStringLiteral("filterClear"), false).toBool();
-    mWindow->setFilterClear(mFilterClear);
+
+    if (LXQtFancyMenuWindow *window = mWindow->createdWidget<LXQtFancyMenuWindow>())
+        applyWindowSettings(window);
+
+    realign();
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtFancyMenu::applyWindowSettings(LXQtFancyMenuWindow *window)
+{
+    window->setFilterClear(mFilterClear);
 
     bool buttonsAtTop = settings()->value(QStringLiteral("buttonsAtTop"), false).toBool();
-    mWindow->setButtonPosition(buttonsAtTop ? LXQtFancyMenuButtonPosition::Top : LXQtFancyMenuButtonPosition::Bottom);
+    window->setButtonPosition(buttonsAtTop ? LXQtFancyMenuButtonPosition::Top : LXQtFancyMenuButtonPosition::Bottom);
 
     bool categoriesAtRight = settings()->value(QStringLiteral("categoriesAtRight"), true).toBool();
-    mWindow->setCategoryPosition(categoriesAtRight ? LXQtFancyMenuCategoryPosition::Right : LXQtFancyMenuCategoryPosition::Left);
+    window->setCategoryPosition(categoriesAtRight ? LXQtFancyMenuCategoryPosition::Right : LXQtFancyMenuCategoryPosition::Left);
 
-    mWindow->setAutoSelection(settings()->value(QStringLiteral("autoSel"), false).toBool());
+    window->setAutoSelection(settings()->value(QStringLiteral("autoSel"), false).toBool());
     int delay = qBound(50, settings()->value(QStringLiteral("autoSelDelay"), 250).toInt(), 1000);
-    mWindow->setAutoSelectionDelay(delay);
+    window->setAutoSelectionDelay(delay);
 
-    realign();
+    setMenuFontSize();
 }
 
 /************************************************
@@ -221,9 +255,14 @@ void LXQtFancyMenu::settingsChanged()
  ************************************************/
 void LXQtFancyMenu::buildMenu()
 {
-    mWindow->rebuildMenu(mXdgMenu);
+    // the window (if any) is rebuilt; otherwise the menu is used when the window is built
+    LXQtFancyMenuWindow *window = mWindow->createdWidget<LXQtFancyMenuWindow>();
+    if (!window)
+        return;
+
+    window->rebuildMenu(mXdgMenu);
 
-    mWindow->doSearch();
+    window->doSearch();
     setMenuFontSize();
 }
 
@@ -259,7 +298,9 @@ void LXQtFancyMenu::loadFavorites()
         fileList.append(canonicalPath);
     }
 
-    mWindow->setFavorites(fileList);
+    mFavorites = fileList;
+    if (LXQtFancyMenuWindow *window = mWindow->createdWidget<LXQtFancyMenuWindow>())
+        window->setFavorites(mFavorites);
 
     if(listChanged)
         saveFavorites();
@@ -267,12 +308,13 @@ void LXQtFancyMenu::loadFavorites()
 
 void LXQtFancyMenu::saveFavorites()
 {
-    const QStringList fileList = mWindow->favorites();
+    if (LXQtFancyMenuWindow *window = mWindow->createdWidget<LXQtFancyMenuWindow>())
+        mFavorites = window->favorites();
 
     QList<QMap<QString, QVariant> > list;
-    list.reserve(fileList.size());
+    list.reserve(mFavorites.size());
 
-    for(const QString& file : fileList)
+    for(const QString& file : std::as_const(mFavorites))
     {
         QMap<QString, QVariant> item;
         item.insert(QStringLiteral("desktopFile"), file);
@@ -290,7 +332,8 @@ void LXQtFancyMenu::saveFavorites()
  ************************************************/
 void LXQtFancyMenu::setMenuFontSize()
 {
-    if (!mWindow)
+    LXQtFancyMenuWindow *window = mWindow->createdWidget<LXQtFancyMenuWindow>();
+    if (!window)
         return;
 
     QFont menuFont = mButton.font();
@@ -299,11 +342,11 @@ void LXQtFancyMenu::setMenuFontSize()
 
     if(customFont)
     {
-        menuFont = mWindow->font();
+        menuFont = window->font();
         menuFont.setPointSize(customFontSize);
     }
 
-    mWindow->setCustomFont(menuFont);
+    window->setCustomFont(menuFont);
 }
 
 /************************************************
@@ -341,11 +384,13 @@ bool LXQtFancyMenu::eventFilter(QObject *obj, QEvent *event)
         {
             setMenuFontSize();
             setButtonIcon();
-            mWindow->updateButtonIconSize();
+            if (LXQtFancyMenuWindow *window = mWindow->createdWidget<LXQtFancyMenuWindow>())
+                window->updateButtonIconSize();
         }
     }
-    else if(obj == mWindow)
+    else if(obj == mWindow->createdWidget())
     {
+        QWidget *window = mWindow->createdWidget();
         if(event->type() == QEvent::KeyRelease)
         {
             static const auto key_meta = QMetaEnum::fromType<Qt::Key>();
@@ -373,7 +418,7 @@ bool LXQtFancyMenu::eventFilter(QObject *obj, QEvent *event)
             {
                 //TODO: isn't timer already fired by hide() ???
                 mHideTimer.start();
-                mWindow->hide(); // close the app menu
+                window->hide(); // close the app menu
                 return true;
             }
             //TODO: go to item which starts with pressed letter
@@ -383,7 +428,7 @@ bool LXQtFancyMenu::eventFilter(QObject *obj, QEvent *event)
             QResizeEvent *e = static_cast<QResizeEvent *>(event);
             if (e->oldSize().isValid() && e->oldSize() != e->size())
             {
-                mWindow->move(calculatePopupWindowPos(e->size()).topLeft());
+                window->move(calculatePopupWindowPos(e->size()).topLeft());
             }
         }
     }
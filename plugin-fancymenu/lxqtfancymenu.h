@@ -40,6 +40,7 @@
 #include <QKeySequence>
 
 class LXQtFancyMenuWindow;
+class LXQtPanelLazyPopup;
 class LXQtBar;
 
 namespace LXQt {
@@ -71,13 +72,17 @@ protected:
     bool eventFilter(QObject *obj, QEvent *event);
 
 private:
+    LXQtFancyMenuWindow *createWindow();
+    void applyWindowSettings(LXQtFancyMenuWindow *window);
     void setMenuFontSize();
     void setButtonIcon();
 
 private:
     QToolButton mButton;
     QString mLogDir;
-    LXQtFancyMenuWindow *mWindow;
+    LXQtPanelLazyPopup *mWindow; //!< the LXQtFancyMenuWindow, built when needed
+    QStringList mFavorites;
+    bool mMenuLoaded;
     GlobalKeyShortcut::Action *mShortcut;
     bool mFilterClear; //!< search field should be cleared upon showing the menu
 
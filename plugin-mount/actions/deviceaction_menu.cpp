@@ -32,17 +32,18 @@
 DeviceActionMenu::DeviceActionMenu(LXQtMountPlugin *plugin, QObject *parent):
     DeviceAction(plugin, parent)
 {
-    mPopup = plugin->popup();
-
     mHideTimer.setSingleShot(true);
     mHideTimer.setInterval(5000);
-    connect(&mHideTimer, &QTimer::timeout, mPopup, &Popup::hide);
+    connect(&mHideTimer, &QTimer::timeout, this, [this] {
+        if (Popup *popup = mPlugin->createdPopup())
+            popup->hide();
+    });
 }
 
 void DeviceActionMenu::doDeviceAdded(Solid::Device /*device*/)
 {
     mHideTimer.start();
-    mPopup->show();
+    mPlugin->popup()->show();
 }
 
 void DeviceActionMenu::doDeviceRemoved(Solid::Device /*device*/)
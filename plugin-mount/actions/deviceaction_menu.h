@@ -33,8 +33,6 @@
 #include <QWidget>
 #include <QTimer>
 
-class Popup;
-
 class DeviceActionMenu : public DeviceAction
 {
     Q_OBJECT
@@ -47,7 +45,6 @@ protected:
     void doDeviceRemoved(Solid::Device device);
 
 private:
-    Popup *mPopup;
     QTimer mHideTimer;
 };
 
@@ -27,15 +27,34 @@
 
 #include "lxqtmountplugin.h"
 #include "configuration.h"
+#include "../panel/lxqtpanellazypopup.h"
 
 #include <lxqt-globalkeys.h>
 
 #include <LXQt/Notification>
 
 #include <Solid/DeviceNotifier>
+#include <Solid/StorageAccess>
+#include <Solid/StorageDrive>
 
 #define DEFAULT_EJECT_SHORTCUT "XF86Eject"
 
+// Paulo: I'm not sure what this is for
+static bool hasRemovableParent(Solid::Device device)
+{
+    // qDebug() << "access:" << device.udi();
+    for ( ; !device.udi().isEmpty(); device = device.parent())
+    {
+        Solid::StorageDrive* drive = device.as<Solid::StorageDrive>();
+        if (drive && drive->isRemovable())
+        {
+            // qDebug() << "removable parent drive:" << device.udi();
+            return true;
+        }
+    }
+    return false;
+}
+
 LXQtMountPlugin::LXQtMountPlugin(const ILXQtPanelPluginStartupInfo &startupInfo):
     QObject(),
     ILXQtPanelPlugin(startupInfo),
@@ -45,10 +64,32 @@ LXQtMountPlugin::LXQtMountPlugin(const ILXQtPanelPluginStartupInfo &startupInfo)
     mKeyEject(nullptr)
 {
     mButton = new Button;
-    mPopup = new Popup(this);
 
-    connect(mButton, &QToolButton::clicked, mPopup, &Popup::showHide);
-    connect(mPopup, &Popup::visibilityChanged, mButton, &QToolButton::setDown);
+    // the popup (with its items) is built on the first hover/click and released when unused
+    mPopup = new LXQtPanelLazyPopup(this);
+    mPopup->setTrigger(mButton);
+    mPopup->setFactory([this] {
+        Popup *popup = new Popup(this);
+        connect(popup, &Popup::visibilityChanged, mButton, &QToolButton::setDown);
+        return popup;
+    });
+
+    connect(mButton, &QToolButton::clicked, this, [this] { popup()->showHide(); });
+
+    //Perform the potential long time operation after object construction
+    //Note: the initial devices are not announced (the mDeviceAction doesn't exist yet)
+    QTimer::singleShot(0, this, [this] {
+        const auto devices = Solid::Device::listFromType(Solid::DeviceInterface::StorageAccess);
+        for (const Solid::Device& device : devices)
+            if (hasRemovableParent(device))
+                mDevices.append(device.udi());
+    });
+
+    connect(Solid::DeviceNotifier::instance(), &Solid::DeviceNotifier::deviceAdded,
+            this, &LXQtMountPlugin::onDeviceAdded);
+    connect(Solid::DeviceNotifier::instance(), &Solid::DeviceNotifier::deviceRemoved,
+            this, &LXQtMountPlugin::onDeviceRemoved);
+
     // Note: postpone creation of the mDeviceAction to not fire it in startup time
     QTimer::singleShot(0, this, &LXQtMountPlugin::settingsChanged);
 }
@@ -59,6 +100,35 @@ LXQtMountPlugin::~LXQtMountPlugin()
     delete mPopup;
 }
 
+Popup *LXQtMountPlugin::popup()
+{
+    return mPopup->widget<Popup>();
+}
+
+Popup *LXQtMountPlugin::createdPopup() const
+{
+    return mPopup->createdWidget<Popup>();
+}
+
+void LXQtMountPlugin::onDeviceAdded(QString const & udi)
+{
+    if (mDevices.contains(udi))
+        return;
+
+    Solid::Device device(udi);
+    if (device.is<Solid::StorageAccess>() && hasRemovableParent(device))
+    {
+        mDevices.append(udi);
+        emit deviceAdded(device);
+    }
+}
+
+void LXQtMountPlugin::onDeviceRemoved(QString const & udi)
+{
+    if (mDevices.removeOne(udi))
+        emit deviceRemoved(Solid::Device{udi});
+}
+
 
 void LXQtMountPlugin::shortcutRegistered()
 {
@@ -84,8 +154,8 @@ void LXQtMountPlugin::shortcutRegistered()
 
 QDialog *LXQtMountPlugin::configureDialog()
 {
-    if (mPopup)
-        mPopup->hide();
+    if (Popup *popup = createdPopup())
+        popup->hide();
 
     Configuration *configWindow = new Configuration(settings());
     configWindow->setAttribute(Qt::WA_DeleteOnClose, true);
@@ -107,8 +177,8 @@ void LXQtMountPlugin::settingsChanged()
         delete mDeviceAction;
         mDeviceAction = DeviceAction::create(devActionId, this, this);
 
-        connect(mPopup, &Popup::deviceAdded, mDeviceAction, &DeviceAction::onDeviceAdded);
-        connect(mPopup, &Popup::deviceRemoved, mDeviceAction, &DeviceAction::onDeviceRemoved);
+        connect(this, &LXQtMountPlugin::deviceAdded, mDeviceAction, &DeviceAction::onDeviceAdded);
+        connect(this, &LXQtMountPlugin::deviceRemoved, mDeviceAction, &DeviceAction::onDeviceRemoved);
     }
 
     if(mKeyEject == nullptr)
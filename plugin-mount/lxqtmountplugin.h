@@ -36,6 +36,10 @@
 #include "actions/ejectaction.h"
 
 #include <QIcon>
+#include <QStringList>
+#include <Solid/Device>
+
+class LXQtPanelLazyPopup;
 
 namespace GlobalKeyShortcut
 {
@@ -58,12 +62,36 @@ public:
     virtual QString themeId() const { return QLatin1String("LXQtMount"); }
     virtual ILXQtPanelPlugin::Flags flags() const { return PreferRightAlignment | HaveConfigDialog; }
 
-    Popup *popup() { return mPopup; }
+    /*!
+     * \brief popup Returns the popup, building it if needed.
+     */
+    Popup *popup();
+    /*!
+     * \brief createdPopup Returns the popup if it's built, nullptr otherwise.
+     */
+    Popup *createdPopup() const;
+    /*!
+     * \brief devices The udis of the devices we are interested in
+     * (the storage devices with a removable parent).
+     */
+    const QStringList &devices() const { return mDevices; }
     QIcon icon() { return mButton->icon(); };
     QDialog *configureDialog();
 
+signals:
+    /*!
+     * \brief Signal emitted when a new device we are interested in is added
+     */
+    void deviceAdded(Solid::Device device);
+    /*!
+     * \brief Signal emitted when a device we are interested in is removed
+     */
+    void deviceRemoved(Solid::Device device);
+
 public slots:
     void realign();
+    void onDeviceAdded(QString const & udi);
+    void onDeviceRemoved(QString const & udi);
 
 protected slots:
     virtual void settingsChanged();
@@ -71,7 +99,8 @@ protected slots:
 
 private:
     Button *mButton;
-    Popup *mPopup;
+    LXQtPanelLazyPopup *mPopup;
+    QStringList mDevices;
     DeviceAction *mDeviceAction;
     EjectAction *mEjectAction;
     GlobalKeyShortcut::Action *mKeyEject;
@@ -27,31 +27,11 @@
  * END_COMMON_COPYRIGHT_HEADER */
 
 #include "popup.h"
-#include "../panel/ilxqtpanelplugin.h"
+#include "lxqtmountplugin.h"
 
 #include <QVBoxLayout>
-#include <QTimer>
-#include <Solid/StorageAccess>
-#include <Solid/StorageDrive>
-#include <Solid/DeviceNotifier>
 
-// Paulo: I'm not sure what this is for
-static bool hasRemovableParent(Solid::Device device)
-{
-    // qDebug() << "access:" << device.udi();
-    for ( ; !device.udi().isEmpty(); device = device.parent())
-    {
-        Solid::StorageDrive* drive = device.as<Solid::StorageDrive>();
-        if (drive && drive->isRemovable())
-        {
-            // qDebug() << "removable parent drive:" << device.udi();
-            return true;
-        }
-    }
-    return false;
-}
-
-Popup::Popup(ILXQtPanelPlugin * plugin, QWidget* parent):
+Popup::Popup(LXQtMountPlugin * plugin, QWidget* parent):
     QDialog(parent,  Qt::Window | Qt::WindowStaysOnTopHint | Qt::CustomizeWindowHint | Qt::Popup | Qt::X11BypassWindowManagerHint),
     mPlugin(plugin),
     mPlaceholder(nullptr),
@@ -68,23 +48,12 @@ Popup::Popup(ILXQtPanelPlugin * plugin, QWidget* parent):
     mPlaceholder->setObjectName(QStringLiteral("NoDiskLabel"));
     layout()->addWidget(mPlaceholder);
 
-    //Perform the potential long time operation after object construction
-    //Note: can't use QTimer::singleShot with lambda in pre QT 5.4 code
-    QTimer * aux_timer = new QTimer;
-    connect(aux_timer, &QTimer::timeout, this, [this, aux_timer] {
-        delete aux_timer; //cleanup
-        const auto devices = Solid::Device::listFromType(Solid::DeviceInterface::StorageAccess);
-        for (const Solid::Device& device : devices)
-            if (hasRemovableParent(device))
-                addItem(device);
-    });
-    aux_timer->setSingleShot(true);
-    aux_timer->start(0);
-
-    connect(Solid::DeviceNotifier::instance(), &Solid::DeviceNotifier::deviceAdded,
-            this, &Popup::onDeviceAdded);
-    connect(Solid::DeviceNotifier::instance(), &Solid::DeviceNotifier::deviceRemoved,
-            this, &Popup::onDeviceRemoved);
+    const QStringList devices = mPlugin->devices();
+    for (const QString &udi : devices)
+        addItem(Solid::Device{udi});
+
+    connect(mPlugin, &LXQtMountPlugin::deviceAdded, this, &Popup::addItem);
+    connect(mPlugin, &LXQtMountPlugin::deviceRemoved, this, &Popup::removeItem);
 }
 
 void Popup::showHide()
@@ -97,15 +66,9 @@ void Popup::showHide()
         close();
 }
 
-void Popup::onDeviceAdded(QString const & udi)
-{
-    Solid::Device device(udi);
-    if (device.is<Solid::StorageAccess>() && hasRemovableParent(device))
-        addItem(device);
-}
-
-void Popup::onDeviceRemoved(QString const & udi)
+void Popup::removeItem(Solid::Device device)
 {
+    const QString udi = device.udi();
     MenuDiskItem* item = nullptr;
     const int size = layout()->count() - 1;
     for (int i = size; 0 <= i; --i)
@@ -130,8 +93,6 @@ void Popup::onDeviceRemoved(QString const & udi)
         --mDisplayCount;
         if (mDisplayCount == 0)
             mPlaceholder->show();
-
-        emit deviceRemoved(Solid::Device{udi});
     }
 }
 
@@ -168,7 +129,8 @@ void Popup::hideEvent(QHideEvent *event)
 void Popup::addItem(Solid::Device device)
 {
     MenuDiskItem *item = new MenuDiskItem(device, this);
-    connect(item, &MenuDiskItem::invalid, this, &Popup::onDeviceRemoved);
+    // an invalid device is removed by the plugin (and then from here)
+    connect(item, &MenuDiskItem::invalid, mPlugin, &LXQtMountPlugin::onDeviceRemoved);
     item->setVisible(true);
     layout()->addWidget(item);
 
@@ -178,8 +140,6 @@ void Popup::addItem(Solid::Device device)
 
     if (isVisible())
         realign();
-
-    emit deviceAdded(device);
 }
 
 void Popup::realign()
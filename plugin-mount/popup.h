@@ -35,46 +35,38 @@
 #include <QDialog>
 #include <Solid/Device>
 
-class ILXQtPanelPlugin;
+class LXQtMountPlugin;
 
+/*!
+ * \brief The Popup class shows the devices of the plugin
+ * (LXQtMountPlugin::devices()) and follows their changes.
+ */
 class Popup: public QDialog
 {
     Q_OBJECT
 
 public:
-    explicit Popup(ILXQtPanelPlugin * plugin, QWidget* parent = nullptr);
+    explicit Popup(LXQtMountPlugin * plugin, QWidget* parent = nullptr);
     void realign();
 
 public slots:
     void showHide();
 
 private slots:
-    void onDeviceAdded(QString const & udi);
-    void onDeviceRemoved(QString const & udi);
+    void addItem(Solid::Device device);
+    void removeItem(Solid::Device device);
 
 signals:
     void visibilityChanged(bool visible);
-    /*!
-     * \brief Signal emitted when new device added into the popup
-     * (device which we are interested in)
-     */
-    void deviceAdded(Solid::Device device);
-    /*!
-     * \brief Signal emitted when device is removed from the popup
-     * (device which we are interested in)
-     */
-    void deviceRemoved(Solid::Device device);
 
 protected:
     void showEvent(QShowEvent *event);
     void hideEvent(QHideEvent *event);
 
 private:
-    ILXQtPanelPlugin * mPlugin;
+    LXQtMountPlugin * mPlugin;
     QLabel *mPlaceholder;
     int mDisplayCount;
-
-    void addItem(Solid::Device device);
 };
 
 #endif // POPUP_H
@@ -28,6 +28,7 @@
 #include "lxqtnetworkmonitor.h"
 #include "lxqtnetworkmonitorconfiguration.h"
 #include "../panel/ilxqtpanelplugin.h"
+#include "../panel/lxqtpanelapplication.h"
 
 #include <QEvent>
 #include <QPainter>
@@ -35,33 +36,22 @@
 #include <QLinearGradient>
 #include <QHBoxLayout>
 
-extern "C" {
-#include <statgrab.h>
-}
-
-#ifdef __sg_public
-// since libstatgrab 0.90 this macro is defined, so we use it for version check
-#define STATGRAB_NEWER_THAN_0_90 	1
-#endif
-
 LXQtNetworkMonitor::LXQtNetworkMonitor(ILXQtPanelPlugin *plugin, QWidget* parent):
     QFrame(parent),
+    m_received(0),
+    m_transmitted(0),
+    m_state(Error),
     mPlugin(plugin)
 {
     QHBoxLayout *layout = new QHBoxLayout(this);
     layout->addWidget(&m_stuff);
     setLayout(layout);
-    /* Initialise statgrab */
-#ifdef STATGRAB_NEWER_THAN_0_90
-    sg_init(0);
-#else
-    sg_init();
-#endif
 
     m_iconList << QStringLiteral("modem") << QStringLiteral("monitor")
                << QStringLiteral("network") << QStringLiteral("wireless");
 
-    startTimer(800);
+    static_cast<LXQtPanelApplication *>(qApp)->getSystemSampler()->subscribe(this, SystemSampler::Network, 800,
+        [this] (const SystemSampler::Sample &sample) { networkSampled(sample); });
 
     settingsChanged();
 }
@@ -70,61 +60,39 @@ LXQtNetworkMonitor::~LXQtNetworkMonitor() = default;
 
 void LXQtNetworkMonitor::resizeEvent(QResizeEvent *)
 {
-    m_stuff.setMinimumWidth(m_pic.width() + 2);
-    m_stuff.setMinimumHeight(m_pic.height() + 2);
+    const QPixmap &pic = m_pics[m_state];
+    m_stuff.setMinimumWidth(pic.width() + 2);
+    m_stuff.setMinimumHeight(pic.height() + 2);
 
     update();
 }
 
 
-void LXQtNetworkMonitor::timerEvent(QTimerEvent * /*event*/)
+void LXQtNetworkMonitor::networkSampled(const SystemSampler::Sample &sample)
 {
-    bool matched = false;
-
-#ifdef STATGRAB_NEWER_THAN_0_90
-    size_t num_network_stats;
-    size_t x;
-#else
-    int num_network_stats;
-    int x;
-#endif
-    sg_network_io_stats *network_stats = sg_get_network_io_stats_diff(&num_network_stats);
-
-    for (x = 0; x < num_network_stats; x++)
+    State state = Error;
+    const SystemSampler::NetworkUsage *network_stats = sample.networkUsage(m_interface);
+    if (network_stats)
     {
-        if (m_interface == QString::fromLocal8Bit(network_stats->interface_name))
-        {
-            if (network_stats->rx != 0 && network_stats->tx != 0)
-            {
-                m_pic.load(iconName(QStringLiteral("transmit-receive")));
-            }
-            else if (network_stats->rx != 0 && network_stats->tx == 0)
-            {
-                m_pic.load(iconName(QStringLiteral("receive")));
-            }
-            else if (network_stats->rx == 0 && network_stats->tx != 0)
-            {
-                m_pic.load(iconName(QStringLiteral("transmit")));
-            }
-            else
-            {
-                m_pic.load(iconName(QStringLiteral("idle")));
-            }
-
-            matched = true;
-
-            break;
-        }
-
-        network_stats++;
+        if (network_stats->receiveRate != 0 && network_stats->transmitRate != 0)
+            state = TransmitReceive;
+        else if (network_stats->receiveRate != 0 && network_stats->transmitRate == 0)
+            state = Receive;
+        else if (network_stats->receiveRate == 0 && network_stats->transmitRate != 0)
+            state = Transmit;
+        else
+            state = Idle;
+
+        m_received = network_stats->received;
+        m_transmitted = network_stats->transmitted;
     }
 
-    if (!matched)
+    // the tooltip is built when shown, only the icon needs a repaint
+    if (state != m_state)
     {
-        m_pic.load(iconName(QStringLiteral("error")));
+        m_state = state;
+        update();
     }
-
-    update();
 }
 
 void LXQtNetworkMonitor::paintEvent(QPaintEvent *)
@@ -133,36 +101,21 @@ void LXQtNetworkMonitor::paintEvent(QPaintEvent *)
 
     QRectF r = rect();
 
-    int leftOffset = (r.width() - m_pic.width() + 2) / 2;
-    int topOffset = (r.height() - m_pic.height() + 2) / 2;
+    const QPixmap &pic = m_pics[m_state];
+    int leftOffset = (r.width() - pic.width() + 2) / 2;
+    int topOffset = (r.height() - pic.height() + 2) / 2;
 
-    p.drawPixmap(leftOffset, topOffset, m_pic);
+    p.drawPixmap(leftOffset, topOffset, pic);
 }
 
 bool LXQtNetworkMonitor::event(QEvent *event)
 {
     if (event->type() == QEvent::ToolTip)
     {
-#ifdef STATGRAB_NEWER_THAN_0_90
-        size_t num_network_stats;
-        size_t x;
-#else
-        int num_network_stats;
-        int x;
-#endif
-        sg_network_io_stats *network_stats = sg_get_network_io_stats(&num_network_stats);
-
-        for (x = 0; x < num_network_stats; x++)
-        {
-            if (m_interface == QString::fromLocal8Bit(network_stats->interface_name))
-            {
-                setToolTip(tr("Network interface <b>%1</b>").arg(m_interface) + QStringLiteral("<br>")
-                           + tr("Transmitted %1").arg(convertUnits(network_stats->tx)) + QStringLiteral("<br>")
-                           + tr("Received %1").arg(convertUnits(network_stats->rx))
-                          );
-            }
-            network_stats++;
-        }
+        setToolTip(tr("Network interface <b>%1</b>").arg(m_interface) + QStringLiteral("<br>")
+                   + tr("Transmitted %1").arg(convertUnits(m_transmitted)) + QStringLiteral("<br>")
+                   + tr("Received %1").arg(convertUnits(m_received))
+                  );
     }
     return QFrame::event(event);
 }
@@ -187,18 +140,16 @@ void LXQtNetworkMonitor::settingsChanged()
     m_iconIndex = mPlugin->settings()->value(QStringLiteral("icon"), 1).toInt();
     m_interface = mPlugin->settings()->value(QStringLiteral("interface")).toString();
     if (m_interface.isEmpty())
-    {
-#ifdef STATGRAB_NEWER_THAN_0_90
-        size_t count;
-#else
-        int count;
-#endif
-        sg_network_iface_stats* stats = sg_get_network_iface_stats(&count);
-        if (count > 0)
-            m_interface = QString(QLatin1String(stats[0].interface_name));
-    }
-
-    m_pic.load(iconName(QStringLiteral("error")));
+        m_interface = static_cast<LXQtPanelApplication *>(qApp)->getSystemSampler()->sourceNames(SystemSampler::Network).value(0);
+    m_received = 0;
+    m_transmitted = 0;
+
+    // decoded once per icon set, the samples only switch between them
+    static const char *const states[StateCount] = {"error", "idle", "receive", "transmit", "transmit-receive"};
+    for (int state = 0; state < StateCount; ++state)
+        m_pics[state].load(iconName(QLatin1String(states[state])));
+    m_state = Error;
+    update();
 }
 
 QString LXQtNetworkMonitor::convertUnits(double num)
@@ -29,6 +29,8 @@
 #define LXQTNETWORKMONITOR_H
 #include <QFrame>
 
+#include "../panel/systemsampler.h"
+
 class ILXQtPanelPlugin;
 
 /*!
@@ -43,13 +45,23 @@ public:
     virtual void settingsChanged();
 
 protected:
-    void virtual timerEvent(QTimerEvent *event);
     void virtual paintEvent(QPaintEvent * event);
     void virtual resizeEvent(QResizeEvent *);
     bool virtual event(QEvent *event);
 
 
 private:
+    enum State
+    {
+        Error, //!< no such interface
+        Idle,
+        Receive,
+        Transmit,
+        TransmitReceive,
+        StateCount
+    };
+
+    void networkSampled(const SystemSampler::Sample &sample);
     static QString convertUnits(double num);
     QString iconName(const QString& state) const
     {
@@ -64,7 +76,10 @@ private:
     int m_iconIndex;
 
     QString m_interface;
-    QPixmap m_pic;
+    quint64 m_received; //!< bytes, for the tooltip
+    quint64 m_transmitted;
+    QPixmap m_pics[StateCount]; //!< of the icon set, by State
+    State m_state;
     ILXQtPanelPlugin *mPlugin;
 };
 
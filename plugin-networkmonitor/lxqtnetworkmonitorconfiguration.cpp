@@ -28,15 +28,8 @@
 
 #include "lxqtnetworkmonitorconfiguration.h"
 #include "ui_lxqtnetworkmonitorconfiguration.h"
-
-extern "C" {
-#include <statgrab.h>
-}
-
-#ifdef __sg_public
-// since libstatgrab 0.90 this macro is defined, so we use it for version check
-#define STATGRAB_NEWER_THAN_0_90     1
-#endif
+#include "../panel/lxqtpanelapplication.h"
+#include "../panel/systemsampler.h"
 
 LXQtNetworkMonitorConfiguration::LXQtNetworkMonitorConfiguration(PluginSettings *settings, QWidget *parent) :
     LXQtPanelPluginConfigDialog(settings, parent),
@@ -74,16 +67,9 @@ void LXQtNetworkMonitorConfiguration::loadSettings()
 
     ui->iconCB->setCurrentIndex(settings().value(QStringLiteral("icon"), 1).toInt());
 
-    int count;
-#ifdef STATGRAB_NEWER_THAN_0_90
-    size_t ret_count;
-    sg_network_iface_stats* stats = sg_get_network_iface_stats(&ret_count);
-    count = (int)ret_count;
-#else
-    sg_network_iface_stats* stats = sg_get_network_iface_stats(&count);
-#endif
-    for (int ix = 0; ix < count; ix++)
-        ui->interfaceCB->addItem(QLatin1String(stats[ix].interface_name));
+    const QStringList interfaces = static_cast<LXQtPanelApplication *>(qApp)->getSystemSampler()->sourceNames(SystemSampler::Network);
+    const int count = interfaces.size();
+    ui->interfaceCB->addItems(interfaces);
 
     QString interface = settings().value(QStringLiteral("interface")).toString();
     ui->interfaceCB->setCurrentIndex(qMax(qMin(0, count - 1), ui->interfaceCB->findText(interface)));
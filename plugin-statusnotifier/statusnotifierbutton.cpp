@@ -32,6 +32,7 @@
 #include <QFile>
 #include <dbusmenu-lxqt/dbusmenuimporter.h>
 #include "../panel/ilxqtpanelplugin.h"
+#include "../panel/lxqtpanellazypopup.h"
 #include "sniasync.h"
 #include <XdgIcon>
 
@@ -56,6 +57,7 @@ namespace
 StatusNotifierButton::StatusNotifierButton(QString service, QString objectPath, ILXQtPanelPlugin* plugin, QWidget *parent)
     : QToolButton(parent),
     mMenu(nullptr),
+    mMenuImporter(nullptr),
     mStatus(Passive),
     mFallbackIcon(QIcon::fromTheme(QLatin1String("application-x-executable"))),
     mPlugin(plugin),
@@ -80,12 +82,25 @@ StatusNotifierButton::StatusNotifierButton(QString service, QString objectPath,
         });
     });
 
+    // the menu is imported on the first hover or right click and
+    // released when it's not used for a while
+    mMenu = new LXQtPanelLazyPopup(this);
+    mMenu->setTrigger(this);
+    mMenu->setFactory([this] () -> QWidget * {
+        if (mMenuPath.isEmpty())
+            return nullptr;
+        mMenuImporter = new MenuImporter{interface->service(), mMenuPath, this};
+        QMenu *menu = mMenuImporter->menu();
+        menu->setObjectName(QLatin1String("StatusNotifierMenu"));
+        return menu;
+    }, [this] (QWidget * /*menu*/) {
+        // the importer deletes its menu
+        mMenuImporter->deleteLater();
+        mMenuImporter = nullptr;
+    });
+
     interface->propertyGetAsync(QLatin1String("Menu"), [this] (QDBusObjectPath path) {
-        if (!path.path().isEmpty())
-        {
-            mMenu = (new MenuImporter{interface->service(), path.path(), this})->menu();
-            mMenu->setObjectName(QLatin1String("StatusNotifierMenu"));
-        }
+        mMenuPath = path.path();
     });
 
     interface->propertyGetAsync(QLatin1String("Status"), [this] (QString status) {
@@ -324,10 +339,10 @@ void StatusNotifierButton::mouseReleaseEvent(QMouseEvent *event)
         interface->SecondaryActivate(QCursor::pos().x(), QCursor::pos().y());
     else if (Qt::RightButton == event->button())
     {
-        if (mMenu)
+        if (QMenu *menu = mMenu->widget<QMenu>())
         {
-            mPlugin->willShowWindow(mMenu);
-            mMenu->popup(mPlugin->panel()->calculatePopupWindowPos(QCursor::pos(), mMenu->sizeHint()).topLeft());
+            mPlugin->willShowWindow(menu);
+            menu->popup(mPlugin->panel()->calculatePopupWindowPos(QCursor::pos(), menu->sizeHint()).topLeft());
         } else
             interface->ContextMenu(QCursor::pos().x(), QCursor::pos().y());
     }
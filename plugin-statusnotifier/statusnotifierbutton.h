@@ -39,6 +39,8 @@
 #include <QTimer>
 
 class ILXQtPanelPlugin;
+class LXQtPanelLazyPopup;
+class DBusMenuImporter;
 class SniAsync;
 
 class StatusNotifierButton : public QToolButton
@@ -75,7 +77,9 @@ private:
     void onNeedingAttention();
 
     SniAsync *interface;
-    QMenu *mMenu;
+    LXQtPanelLazyPopup *mMenu;
+    DBusMenuImporter *mMenuImporter;
+    QString mMenuPath;
     Status mStatus;
 
     QIcon mIcon, mOverlayIcon, mAttentionIcon, mFallbackIcon;
@@ -28,17 +28,27 @@
 #include "lxqtsysstat.h"
 #include "lxqtsysstatutils.h"
 
-#include <SysStat/CpuStat>
-#include <SysStat/MemStat>
-#include <SysStat/NetStat>
+#include "../panel/lxqtpanelapplication.h"
+#include "../panel/systemsampler.h"
 
 #include <QTimer>
 #include <qmath.h>
+#include <QLocale>
 #include <QPainter>
 #include <QResizeEvent>
 #include <QVBoxLayout>
 #include <QCoreApplication>
 
+#include <algorithm>
+
+namespace
+{
+// series of the history, by data type; the swap has only one
+enum CpuSeries { CpuSystem, CpuUser, CpuNice, CpuOther, CpuFrequencyRate, CpuSeriesCount };
+enum MemorySeries { MemoryApps, MemoryBuffers, MemoryCached, MemorySeriesCount };
+enum NetworkSeries { NetworkReceived, NetworkTransmitted, NetworkSeriesCount };
+}
+
 LXQtSysStat::LXQtSysStat(const ILXQtPanelPluginStartupInfo &startupInfo):
     QObject(),
     ILXQtPanelPlugin(startupInfo),
@@ -112,12 +122,13 @@ bool LXQtSysStatTitle::event(QEvent *e)
 LXQtSysStatContent::LXQtSysStatContent(ILXQtPanelPlugin *plugin, QWidget *parent):
     QWidget(parent),
     mPlugin(plugin),
-    mStat(nullptr),
+    mSubscription(0),
     mUpdateInterval(0),
     mMinimalSize(0),
     mGridLines(0),
     mTitleFontPixelHeight(0),
     mUseFrequency(true),
+    mCoresHeatmap(false),
     mNetMaximumSpeed(0),
     mNetRealMaximumSpeed(0),
     mLogarithmicScale(true),
@@ -127,6 +138,7 @@ LXQtSysStatContent::LXQtSysStatContent(ILXQtPanelPlugin *plugin, QWidget *parent
     mHistoryOffset(0)
 {
     setObjectName(QStringLiteral("SysStat_Graph"));
+    updateGraphColours();
 }
 
 LXQtSysStatContent::~LXQtSysStatContent() = default;
@@ -148,7 +160,10 @@ void LXQtSysStatContent::SETNAME##Colour(QColor value) \
 { \
     mThemeColours.GETNAME##Colour = value; \
     if (mUseThemeColours) \
+    { \
         mColours.GETNAME##Colour = mThemeColours.GETNAME##Colour; \
+        graphColoursChanged(); \
+    } \
 }
 
 #undef QSS_NET_COLOUR
@@ -161,6 +176,7 @@ void LXQtSysStatContent::SETNAME##Colour(QColor value) \
     { \
         mColours.GETNAME##Colour = mThemeColours.GETNAME##Colour; \
         mixNetColours(); \
+        graphColoursChanged(); \
     } \
 }
 
@@ -240,6 +256,8 @@ void LXQtSysStatContent::updateSettings(const PluginSettings *settings)
 
     mUseFrequency = settings->value(QStringLiteral("cpu/useFrequency"), true).toBool();
 
+    mCoresHeatmap = mDataType == QLatin1String("CPU") && mDataSource == QLatin1String("cores");
+
     mNetMaximumSpeed = PluginSysStat::netSpeedFromString(settings->value(QStringLiteral("net/maximumSpeed"), QStringLiteral("1 MB/s")).toString());
     mLogarithmicScale = settings->value(QStringLiteral("net/logarithmicScale"), true).toBool();
 
@@ -274,6 +292,7 @@ void LXQtSysStatContent::updateSettings(const PluginSettings *settings)
         mColours = mSettingsColours;
 
     mixNetColours();
+    updateGraphColours();
 
     updateTitleFontPixelHeight();
 
@@ -291,74 +310,77 @@ void LXQtSysStatContent::updateSettings(const PluginSettings *settings)
     bool needFullReset       = needTimerRestarting || minimalSizeChanged || logScaleStepsChanged || logarithmicScaleChanged;
 
 
-    if (mStat)
-    {
-        if (needTimerRestarting)
-            mStat->stopUpdating();
-
-        if (needReconnecting)
-            mStat->disconnect(this);
-    }
-
-    if (dataTypeChanged)
+    if (needTimerRestarting)
     {
-        if (mStat)
-        {
-            mStat->deleteLater();
-            mStat = nullptr;
-        }
-
-        if (mDataType == QLatin1String("CPU"))
-            mStat = new SysStat::CpuStat(this);
+        SystemSampler *sampler = static_cast<LXQtPanelApplication *>(qApp)->getSystemSampler();
+        if (mSubscription)
+            sampler->unsubscribe(mSubscription);
+        mSubscription = 0;
+
+        SystemSampler::Sources sources;
+        if (mCoresHeatmap)
+            sources = SystemSampler::Cpu;
+        else if (mDataType == QLatin1String("CPU"))
+            sources = mUseFrequency ? SystemSampler::Cpu | SystemSampler::CpuFrequency : SystemSampler::Cpu;
         else if (mDataType == QLatin1String("Memory"))
-            mStat = new SysStat::MemStat(this);
+            sources = SystemSampler::Memory;
         else if (mDataType == QLatin1String("Network"))
-            mStat = new SysStat::NetStat(this);
-    }
+            sources = SystemSampler::Network;
 
-    if (mStat)
-    {
-        if (needReconnecting)
+        if (sources)
         {
-            if (mDataType == QLatin1String("CPU"))
-            {
-                SysStat::CpuStat* cpustat = qobject_cast<SysStat::CpuStat*>(mStat);
-                if (mUseFrequency)
-                {
-                    cpustat->setMonitoring(SysStat::CpuStat::LoadAndFrequency);
-                    connect(cpustat, QOverload<float, float, float, float, float, uint>::of(&SysStat::CpuStat::update), this, &LXQtSysStatContent::cpuLoadFrequencyUpdate);
-                }
-                else
-                {
-                    cpustat->setMonitoring(SysStat::CpuStat::LoadOnly);
-                    connect(cpustat, QOverload<float, float, float, float>::of(&SysStat::CpuStat::update), this, &LXQtSysStatContent::cpuLoadUpdate);
-                }
-            }
-            else if (mDataType == QLatin1String("Memory"))
-            {
-                SysStat::MemStat* memstat = qobject_cast<SysStat::MemStat*>(mStat);
-                if (mDataSource == QLatin1String("memory"))
-                    connect(memstat, &SysStat::MemStat::memoryUpdate, this, &LXQtSysStatContent::memoryUpdate);
-                else
-                    connect(memstat, &SysStat::MemStat::swapUpdate,   this, &LXQtSysStatContent::swapUpdate);
-            }
-            else if (mDataType == QLatin1String("Network"))
-            {
-                SysStat::NetStat* netstat = qobject_cast<SysStat::NetStat*>(mStat);
-                connect(netstat, &SysStat::NetStat::update, this, &LXQtSysStatContent::networkUpdate);
-            }
-
-            mStat->setMonitoredSource(mDataSource);
+            mSubscription = sampler->subscribe(this, sources, static_cast<int>(mUpdateInterval * 1000.0),
+                                               [this] (const SystemSampler::Sample &sample) { sampled(sample); });
         }
 
-        if (needTimerRestarting)
-            mStat->setUpdateInterval(static_cast<int>(mUpdateInterval * 1000.0));
+        // the old samples are of something else, or at another pace
+        mHistory.reset(historySeriesCount(), qMax(width(), 1));
     }
 
     if (needFullReset)
         reset();
     else
+    {
+        // the colours or the network scale may have changed
+        redraw();
         update();
+    }
+}
+
+void LXQtSysStatContent::sampled(const SystemSampler::Sample &sample)
+{
+    if (mCoresHeatmap)
+        coresUpdate(sample.cpu);
+    else if (mDataType == QLatin1String("CPU"))
+    {
+        // "cpu" is the first one, then "cpu0"...
+        bool ok = true;
+        const int index = mDataSource == QLatin1String("cpu") ? 0 : mDataSource.mid(3).toInt(&ok) + 1;
+        if (!ok || index >= sample.cpu.size())
+            return;
+
+        const SystemSampler::CpuLoad &load = sample.cpu.at(index);
+        // no cpufreq, no frequency
+        if (mUseFrequency && load.frequencyRate > 0)
+            cpuLoadFrequencyUpdate(load.user, load.nice, load.system, load.other, load.frequencyRate, load.frequency);
+        else
+            cpuLoadUpdate(load.user, load.nice, load.system, load.other);
+    }
+    else if (mDataType == QLatin1String("Memory"))
+    {
+        if (mDataSource == QLatin1String("memory"))
+            memoryUpdate(sample.memory.apps, sample.memory.buffers, sample.memory.cached);
+        else
+            swapUpdate(sample.memory.swapUsed);
+    }
+    else if (mDataType == QLatin1String("Network"))
+    {
+        const SystemSampler::NetworkUsage *usage = sample.networkUsage(mDataSource);
+        if (usage)
+            networkUpdate(static_cast<unsigned>(usage->receiveRate), static_cast<unsigned>(usage->transmitRate));
+        else
+            networkUpdate(0, 0);
+    }
 }
 
 void LXQtSysStatContent::resizeEvent(QResizeEvent * /*event*/)
@@ -371,15 +393,10 @@ void LXQtSysStatContent::reset()
     setMinimumSize(mPlugin->panel()->isHorizontal() ? mMinimalSize : 2,
                    mPlugin->panel()->isHorizontal() ? 2 : mMinimalSize);
 
-    if (width() > mHistoryImage.width())
-    {
-        QImage newImage{width(), 100, QImage::Format_ARGB32};
-        newImage.fill(Qt::transparent);
-        QPainter p{&newImage};
-        p.drawImage(mHistoryImage.rect(), mHistoryImage, mHistoryImage.rect());
-        mHistoryImage = newImage;
-        update();
-    }
+    // shrinking keeps the samples, they are shown again when growing back
+    mHistory.setCapacity(qMax(mHistory.capacity(), width()));
+    redraw();
+    update();
 }
 
 template <typename T>
@@ -388,62 +405,194 @@ T clamp(const T &value, const T &min, const T &max)
     return qMin(qMax(value, min), max);
 }
 
-// QPainter.drawLine with pen set to Qt::transparent doesn't clear anything
-void LXQtSysStatContent::clearLine()
+int LXQtSysStatContent::historySeriesCount() const
 {
-    QRgb bg = QColor(Qt::transparent).rgba();
-    for (int i = 0; i < 100; ++i)
-        reinterpret_cast<QRgb*>(mHistoryImage.scanLine(i))[mHistoryOffset] = bg;
+    // set by the first sample
+    if (mCoresHeatmap)
+        return 0;
+    if (mDataType == QLatin1String("CPU"))
+        return CpuSeriesCount;
+    if (mDataType == QLatin1String("Memory"))
+        return mDataSource == QLatin1String("memory") ? MemorySeriesCount : 1;
+    if (mDataType == QLatin1String("Network"))
+        return NetworkSeriesCount;
+    return 0;
 }
 
-void LXQtSysStatContent::cpuLoadFrequencyUpdate(float user, float nice, float system, float other, float frequencyRate, uint)
+void LXQtSysStatContent::appendSample(std::initializer_list<float> values)
 {
-    int y_system = static_cast<int>(system * 100.0 * frequencyRate);
-    int y_user   = static_cast<int>(user   * 100.0 * frequencyRate);
-    int y_nice   = static_cast<int>(nice   * 100.0 * frequencyRate);
-    int y_other  = static_cast<int>(other  * 100.0 * frequencyRate);
-    int y_freq   = static_cast<int>(         100.0 * frequencyRate);
+    appendSample(values.begin(), static_cast<int>(values.size()));
+}
 
-    toolTipInfo(tr("system: %1%<br>user: %2%<br>nice: %3%<br>other: %4%<br>freq: %5%", "CPU tooltip information")
-            .arg(y_system).arg(y_user).arg(y_nice).arg(y_other).arg(y_freq));
+void LXQtSysStatContent::appendSample(const float *values, int count)
+{
+    mHistory.append(values, count);
+    if (mHistoryImage.isNull())
+        return;
+
+    drawColumn(mHistoryOffset, 0);
+    mHistoryOffset = (mHistoryOffset + 1) % mHistoryImage.width();
 
-    y_system = clamp(y_system, 0, 99);
-    y_user   = clamp(y_user + y_system, 0, 99);
-    y_nice   = clamp(y_nice + y_user  , 0, 99);
-    y_other  = clamp(y_other, 0, 99);
-    y_freq   = clamp(y_freq, 0, 99);
+    // one image column per pixel: the backing store moves the graph by one
+    // and only the new column on the right is painted (when the widget is
+    // not opaque, Qt repaints the whole area instead)
+    scroll(-1, 0, QRect(0, mTitleFontPixelHeight, width(), height() - mTitleFontPixelHeight));
+}
 
-    clearLine();
-    QPainter painter(&mHistoryImage);
-    if (y_system != 0)
+void LXQtSysStatContent::redraw()
+{
+    const int w = qMax(width(), 1);
+    // a row per core for the heatmap, else a row per percent
+    const int h = mCoresHeatmap ? qMax(mHistory.seriesCount(), 1) : 100;
+    if (mHistoryImage.width() != w || mHistoryImage.height() != h)
     {
-        painter.setPen(mColours.cpuSystemColour);
-        painter.drawLine(mHistoryOffset, y_system, mHistoryOffset, 0);
+        mHistoryImage = QImage(w, h, QImage::Format_ARGB32_Premultiplied);
+        mColumn.resize(h);
     }
-    if (y_user != y_system)
+
+    // the newest sample on the right
+    mHistoryOffset = 0;
+    for (int x = 0; x < w; ++x)
+        drawColumn(x, w - 1 - x);
+}
+
+void LXQtSysStatContent::updateGraphColours()
+{
+    mGraphColours[CpuSystemColour]      = qPremultiply(mColours.cpuSystemColour.rgba());
+    mGraphColours[CpuUserColour]        = qPremultiply(mColours.cpuUserColour.rgba());
+    mGraphColours[CpuNiceColour]        = qPremultiply(mColours.cpuNiceColour.rgba());
+    mGraphColours[CpuOtherColour]       = qPremultiply(mColours.cpuOtherColour.rgba());
+    mGraphColours[FrequencyColour]      = qPremultiply(mColours.frequencyColour.rgba());
+    mGraphColours[MemAppsColour]        = qPremultiply(mColours.memAppsColour.rgba());
+    mGraphColours[MemBuffersColour]     = qPremultiply(mColours.memBuffersColour.rgba());
+    mGraphColours[MemCachedColour]      = qPremultiply(mColours.memCachedColour.rgba());
+    mGraphColours[SwapUsedColour]       = qPremultiply(mColours.swapUsedColour.rgba());
+    mGraphColours[NetReceivedColour]    = qPremultiply(mColours.netReceivedColour.rgba());
+    mGraphColours[NetTransmittedColour] = qPremultiply(mColours.netTransmittedColour.rgba());
+    mGraphColours[NetBothColour]        = qPremultiply(mNetBothColour.rgba());
+
+    // idle cores fade into the background, the busy ones go from the user
+    // to the system colour
+    const QColor &cold = mColours.cpuUserColour;
+    const QColor &hot = mColours.cpuSystemColour;
+    for (int level = 0; level <= 100; ++level)
     {
-        painter.setPen(mColours.cpuUserColour);
-        painter.drawLine(mHistoryOffset, y_user, mHistoryOffset, y_system);
+        const float f = level / 100.0f;
+        const QColor colour = QColor::fromRgbF(cold.redF()   + (hot.redF()   - cold.redF())   * f,
+                                               cold.greenF() + (hot.greenF() - cold.greenF()) * f,
+                                               cold.blueF()  + (hot.blueF()  - cold.blueF())  * f,
+                                               qMin(1.0f, f * 4.0f));
+        mHeatColours[level] = qPremultiply(colour.rgba());
     }
-    if (y_nice != y_user)
+}
+
+void LXQtSysStatContent::graphColoursChanged()
+{
+    updateGraphColours();
+    redraw();
+    update();
+}
+
+// the segments are filled in a contiguous buffer, then each pixel of the
+// image column is written once
+void LXQtSysStatContent::drawColumn(int x, int age)
+{
+    QRgb *column = mColumn.data();
+    const int height = mColumn.size();
+    std::fill(column, column + height, 0);
+    if (age < mHistory.size())
+        rasterizeSample(age, column);
+
+    const qsizetype stride = mHistoryImage.bytesPerLine();
+    uchar *line = mHistoryImage.bits() + x * sizeof(QRgb);
+    for (int y = 0; y < height; ++y, line += stride)
+        *reinterpret_cast<QRgb*>(line) = column[y];
+}
+
+void LXQtSysStatContent::rasterizeSample(int age, QRgb *column) const
+{
+    // [from, to] like QPainter::drawLine() with a cosmetic pen, when not empty
+    auto segment = [this, column] (int bottom, int top, GraphColour colour)
+    {
+        if (top != bottom)
+            std::fill(column + qMin(bottom, top), column + qMax(bottom, top) + 1, mGraphColours[colour]);
+    };
+
+    if (mCoresHeatmap)
     {
-        painter.setPen(mColours.cpuNiceColour);
-        painter.drawLine(mHistoryOffset, y_nice, mHistoryOffset, y_user);
+        for (int core = 0; core < mHistory.seriesCount(); ++core)
+            column[core] = mHeatColours[clamp(static_cast<int>(mHistory.value(core, age) * 100.0), 0, 100)];
     }
-    if (y_other != y_nice)
+    else if (mDataType == QLatin1String("CPU"))
     {
-        painter.setPen(mColours.cpuOtherColour);
-        painter.drawLine(mHistoryOffset, y_other, mHistoryOffset, y_nice);
+        const float frequencyRate = mHistory.value(CpuFrequencyRate, age);
+        const qreal scale = frequencyRate > 0 ? 100.0 * frequencyRate : 100.0;
+        int y_system = clamp(static_cast<int>(mHistory.value(CpuSystem, age) * scale), 0, 99);
+        int y_user   = clamp(static_cast<int>(mHistory.value(CpuUser,   age) * scale) + y_system, 0, 99);
+        int y_nice   = clamp(static_cast<int>(mHistory.value(CpuNice,   age) * scale) + y_user,   0, 99);
+        int y_other  = static_cast<int>(mHistory.value(CpuOther, age) * scale);
+
+        segment(0, y_system, CpuSystemColour);
+        segment(y_system, y_user, CpuUserColour);
+        segment(y_user, y_nice, CpuNiceColour);
+        if (frequencyRate > 0)
+        {
+            // the frequency is drawn behind the load
+            y_other = clamp(y_other, 0, 99);
+            int y_freq = clamp(static_cast<int>(scale), 0, 99);
+            segment(y_nice, y_other, CpuOtherColour);
+            segment(y_other, y_freq, FrequencyColour);
+        }
+        else
+            segment(y_nice, clamp(y_other + y_nice, 0, 99), CpuOtherColour);
     }
-    if (y_freq != y_other)
+    else if (mDataType == QLatin1String("Memory"))
     {
-        painter.setPen(mColours.frequencyColour);
-        painter.drawLine(mHistoryOffset, y_freq, mHistoryOffset, y_other);
+        if (mHistory.seriesCount() == MemorySeriesCount)
+        {
+            int y_apps    = clamp(static_cast<int>(mHistory.value(MemoryApps,    age) * 100.0), 0, 99);
+            int y_buffers = clamp(static_cast<int>(mHistory.value(MemoryBuffers, age) * 100.0) + y_apps, 0, 99);
+            int y_cached  = clamp(static_cast<int>(mHistory.value(MemoryCached,  age) * 100.0) + y_buffers, 0, 99);
+
+            segment(0, y_apps, MemAppsColour);
+            segment(y_apps, y_buffers, MemBuffersColour);
+            segment(y_buffers, y_cached, MemCachedColour);
+        }
+        else
+            segment(0, clamp(static_cast<int>(mHistory.value(0, age) * 100.0), 0, 99), SwapUsedColour);
     }
+    else if (mDataType == QLatin1String("Network"))
+    {
+        const float received = mHistory.value(NetworkReceived, age);
+        const float transmitted = mHistory.value(NetworkTransmitted, age);
+        int y_min_value = clamp(static_cast<int>(netScale(qMin(received, transmitted)) * 100.0), 0, 99);
+        int y_max_value = clamp(static_cast<int>(netScale(qMax(received, transmitted)) * 100.0) + y_min_value, 0, 99);
 
-    mHistoryOffset = (mHistoryOffset + 1) % mHistoryImage.width();
+        segment(0, y_min_value, NetBothColour);
+        segment(y_min_value, y_max_value, (received > transmitted) ? NetReceivedColour : NetTransmittedColour);
+    }
+}
 
-    update(0, mTitleFontPixelHeight, width(), height() - mTitleFontPixelHeight);
+qreal LXQtSysStatContent::netScale(qreal speed) const
+{
+    qreal value = qMin(qMax(speed / mNetRealMaximumSpeed, static_cast<qreal>(0.0)), static_cast<qreal>(1.0));
+    if (mLogarithmicScale)
+        value = qLn(value * (mLogScaleMax - 1.0) + 1.0) / qLn(2.0) / static_cast<qreal>(mLogScaleSteps);
+    return value;
+}
+
+void LXQtSysStatContent::cpuLoadFrequencyUpdate(float user, float nice, float system, float other, float frequencyRate, uint)
+{
+    int y_system = static_cast<int>(system * 100.0 * frequencyRate);
+    int y_user   = static_cast<int>(user   * 100.0 * frequencyRate);
+    int y_nice   = static_cast<int>(nice   * 100.0 * frequencyRate);
+    int y_other  = static_cast<int>(other  * 100.0 * frequencyRate);
+    int y_freq   = static_cast<int>(         100.0 * frequencyRate);
+
+    toolTipInfo(tr("system: %1%<br>user: %2%<br>nice: %3%<br>other: %4%<br>freq: %5%", "CPU tooltip information")
+            .arg(y_system).arg(y_user).arg(y_nice).arg(y_other).arg(y_freq));
+
+    appendSample({system, user, nice, other, frequencyRate});
 }
 
 void LXQtSysStatContent::cpuLoadUpdate(float user, float nice, float system, float other)
@@ -456,37 +605,8 @@ void LXQtSysStatContent::cpuLoadUpdate(float user, float nice, float system, flo
     toolTipInfo(tr("system: %1%<br>user: %2%<br>nice: %3%<br>other: %4%<br>freq: n/a", "CPU tooltip information")
             .arg(y_system).arg(y_user).arg(y_nice).arg(y_other));
 
-    y_system = clamp(y_system, 0, 99);
-    y_user   = clamp(y_user + y_system, 0, 99);
-    y_nice   = clamp(y_nice + y_user, 0, 99);
-    y_other  = clamp(y_other + y_nice, 0, 99);
-
-    clearLine();
-    QPainter painter(&mHistoryImage);
-    if (y_system != 0)
-    {
-        painter.setPen(mColours.cpuSystemColour);
-        painter.drawLine(mHistoryOffset, y_system, mHistoryOffset, 0);
-    }
-    if (y_user != y_system)
-    {
-        painter.setPen(mColours.cpuUserColour);
-        painter.drawLine(mHistoryOffset, y_user, mHistoryOffset, y_system);
-    }
-    if (y_nice != y_user)
-    {
-        painter.setPen(mColours.cpuNiceColour);
-        painter.drawLine(mHistoryOffset, y_nice, mHistoryOffset, y_user);
-    }
-    if (y_other != y_nice)
-    {
-        painter.setPen(mColours.cpuOtherColour);
-        painter.drawLine(mHistoryOffset, y_other, mHistoryOffset, y_nice);
-    }
-
-    mHistoryOffset = (mHistoryOffset + 1) % mHistoryImage.width();
-
-    update(0, mTitleFontPixelHeight, width(), height() - mTitleFontPixelHeight);
+    // no frequency rate
+    appendSample({system, user, nice, other, 0});
 }
 
 void LXQtSysStatContent::memoryUpdate(float apps, float buffers, float cached)
@@ -498,31 +618,7 @@ void LXQtSysStatContent::memoryUpdate(float apps, float buffers, float cached)
     toolTipInfo(tr("apps: %1%<br>buffers: %2%<br>cached: %3%", "Memory tooltip information")
         .arg(y_apps).arg(y_buffers).arg(y_cached));
 
-    y_apps    = clamp(y_apps, 0, 99);
-    y_buffers = clamp(y_buffers + y_apps, 0, 99);
-    y_cached  = clamp(y_cached + y_buffers, 0, 99);
-
-    clearLine();
-    QPainter painter(&mHistoryImage);
-    if (y_apps != 0)
-    {
-        painter.setPen(mColours.memAppsColour);
-        painter.drawLine(mHistoryOffset, y_apps, mHistoryOffset, 0);
-    }
-    if (y_buffers != y_apps)
-    {
-        painter.setPen(mColours.memBuffersColour);
-        painter.drawLine(mHistoryOffset, y_buffers, mHistoryOffset, y_apps);
-    }
-    if (y_cached != y_buffers)
-    {
-        painter.setPen(mColours.memCachedColour);
-        painter.drawLine(mHistoryOffset, y_cached, mHistoryOffset, y_buffers);
-    }
-
-    mHistoryOffset = (mHistoryOffset + 1) % mHistoryImage.width();
-
-    update(0, mTitleFontPixelHeight, width(), height() - mTitleFontPixelHeight);
+    appendSample({apps, buffers, cached});
 }
 
 void LXQtSysStatContent::swapUpdate(float used)
@@ -531,55 +627,40 @@ void LXQtSysStatContent::swapUpdate(float used)
 
     toolTipInfo(tr("used: %1%", "Swap tooltip information").arg(y_used));
 
-    y_used = clamp(y_used, 0, 99);
+    appendSample({used});
+}
 
-    clearLine();
-    QPainter painter(&mHistoryImage);
-    if (y_used != 0)
+void LXQtSysStatContent::coresUpdate(const QVector<SystemSampler::CpuLoad> &cpu)
+{
+    // "cpu" is the first one, then "cpu0"...
+    const int cores = qMax(static_cast<int>(cpu.size()) - 1, 0);
+    if (cores != mHistory.seriesCount())
     {
-        painter.setPen(mColours.swapUsedColour);
-        painter.drawLine(mHistoryOffset, y_used, mHistoryOffset, 0);
+        // the first sample, or a core was plugged
+        mHistory.reset(cores, qMax(mHistory.capacity(), width()));
+        redraw();
+        update();
     }
 
-    mHistoryOffset = (mHistoryOffset + 1) % mHistoryImage.width();
+    mCoreLoads.resize(cores);
+    for (int core = 0; core < cores; ++core)
+    {
+        const SystemSampler::CpuLoad &load = cpu.at(core + 1);
+        mCoreLoads[core] = load.user + load.nice + load.system + load.other;
+    }
 
-    update(0, mTitleFontPixelHeight, width(), height() - mTitleFontPixelHeight);
+    // the tooltip is built from the history when shown
+    appendSample(mCoreLoads.constData(), cores);
 }
 
 void LXQtSysStatContent::networkUpdate(unsigned received, unsigned transmitted)
 {
-    qreal min_value = qMin(qMax(static_cast<qreal>(qMin(received, transmitted)) / mNetRealMaximumSpeed, static_cast<qreal>(0.0)), static_cast<qreal>(1.0));
-    qreal max_value = qMin(qMax(static_cast<qreal>(qMax(received, transmitted)) / mNetRealMaximumSpeed, static_cast<qreal>(0.0)), static_cast<qreal>(1.0));
-    if (mLogarithmicScale)
-    {
-        min_value = qLn(min_value * (mLogScaleMax - 1.0) + 1.0) / qLn(2.0) / static_cast<qreal>(mLogScaleSteps);
-        max_value = qLn(max_value * (mLogScaleMax - 1.0) + 1.0) / qLn(2.0) / static_cast<qreal>(mLogScaleSteps);
-    }
-
-    int y_min_value = static_cast<int>(min_value * 100.0);
-    int y_max_value = static_cast<int>(max_value * 100.0);
+    int y_min_value = static_cast<int>(netScale(qMin(received, transmitted)) * 100.0);
+    int y_max_value = static_cast<int>(netScale(qMax(received, transmitted)) * 100.0);
 
     toolTipInfo(tr("min: %1%<br>max: %2%", "Network tooltip information").arg(y_min_value).arg(y_max_value));
 
-    y_min_value = clamp(y_min_value, 0, 99);
-    y_max_value = clamp(y_max_value + y_min_value, 0, 99);
-
-    clearLine();
-    QPainter painter(&mHistoryImage);
-    if (y_min_value != 0)
-    {
-        painter.setPen(mNetBothColour);
-        painter.drawLine(mHistoryOffset, y_min_value, mHistoryOffset, 0);
-    }
-    if (y_max_value != y_min_value)
-    {
-        painter.setPen((received > transmitted) ? mColours.netReceivedColour : mColours.netTransmittedColour);
-        painter.drawLine(mHistoryOffset, y_max_value, mHistoryOffset, y_min_value);
-    }
-
-    mHistoryOffset = (mHistoryOffset + 1) % mHistoryImage.width();
-
-    update(0, mTitleFontPixelHeight, width(), height() - mTitleFontPixelHeight);
+    appendSample({static_cast<float>(received), static_cast<float>(transmitted)});
 }
 
 void LXQtSysStatContent::paintEvent(QPaintEvent *event)
@@ -609,9 +690,17 @@ void LXQtSysStatContent::paintEvent(QPaintEvent *event)
 
     p.scale(1.0, -1.0);
 
-    p.drawImage(QRect(0, -height(), width() - mHistoryOffset, graphHeight), mHistoryImage, QRect(mHistoryOffset, 0, width() - mHistoryOffset, 100));
-    if (mHistoryOffset)
-        p.drawImage(QRect(width() - mHistoryOffset, -height(), mHistoryOffset, graphHeight), mHistoryImage, QRect(0, 0, mHistoryOffset, 100));
+    // only the columns to paint, usually the newest one; the widget column x
+    // shows the image column (x + mHistoryOffset) % width
+    const int historyWidth = mHistoryImage.width();
+    const QRect dirty = event->rect();
+    for (int x = qMax(dirty.left(), 0), end = qMin(dirty.right() + 1, historyWidth); x < end; )
+    {
+        const int column = (x + mHistoryOffset) % historyWidth;
+        const int count = qMin(end - x, historyWidth - column);
+        p.drawImage(QRect(x, -height(), count, graphHeight), mHistoryImage, QRect(column, 0, count, mHistoryImage.height()));
+        x += count;
+    }
 
     p.resetTransform();
 
@@ -628,10 +717,89 @@ void LXQtSysStatContent::paintEvent(QPaintEvent *event)
     }
 }
 
+bool LXQtSysStatContent::event(QEvent *event)
+{
+    // built only when shown, the history has to be walked
+    if (event->type() == QEvent::ToolTip)
+    {
+        QString history = historyToolTip();
+        setToolTip(QStringLiteral("<b>%1(%2)</b><br>%3%4")
+                .arg(QCoreApplication::translate("LXQtSysStatConfiguration", mDataType.toStdString().c_str()))
+                .arg(QCoreApplication::translate("LXQtSysStatConfiguration", mDataSource.toStdString().c_str()))
+                .arg(mCoresHeatmap ? coresToolTip() : mToolTipInfo)
+                .arg(history.isEmpty() ? history : QStringLiteral("<hr>") + history));
+    }
+    return QWidget::event(event);
+}
+
 void LXQtSysStatContent::toolTipInfo(QString const & tooltip)
 {
-    setToolTip(QStringLiteral("<b>%1(%2)</b><br>%3")
-            .arg(QCoreApplication::translate("LXQtSysStatConfiguration", mDataType.toStdString().c_str()))
-            .arg(QCoreApplication::translate("LXQtSysStatConfiguration", mDataSource.toStdString().c_str()))
-            .arg(tooltip));
+    mToolTipInfo = tooltip;
+}
+
+QString LXQtSysStatContent::historyToolTip() const
+{
+    if (mHistory.size() < 2)
+        return QString();
+
+    const int seconds = qRound(mHistory.size() * mUpdateInterval);
+    if (mDataType == QLatin1String("Network"))
+    {
+        const QLocale locale;
+        auto speed = [&locale] (float value)
+        {
+            return tr("%1/s", "Network speed").arg(locale.formattedDataSize(static_cast<qint64>(value)));
+        };
+        const LXQtSysStatHistory::Statistics received = mHistory.statistics(NetworkReceived, 1);
+        const LXQtSysStatHistory::Statistics transmitted = mHistory.statistics(NetworkTransmitted, 1);
+        return tr("last %1 s<br>received avg: %2, max: %3<br>transmitted avg: %4, max: %5", "Network history tooltip information")
+                .arg(seconds)
+                .arg(speed(received.average)).arg(speed(received.maximum))
+                .arg(speed(transmitted.average)).arg(speed(transmitted.maximum));
+    }
+
+    // the load, without the frequency; of all the cores for the heatmap
+    const int count = mDataType == QLatin1String("CPU") && !mCoresHeatmap ? CpuOther + 1 : mHistory.seriesCount();
+    const qreal scale = mCoresHeatmap ? 100.0 / qMax(count, 1) : 100.0;
+    const LXQtSysStatHistory::Statistics used = mHistory.statistics(0, count);
+    return tr("last %1 s<br>min: %2%<br>avg: %3%<br>max: %4%", "History tooltip information")
+            .arg(seconds)
+            .arg(static_cast<int>(used.minimum * scale))
+            .arg(static_cast<int>(used.average * scale))
+            .arg(static_cast<int>(used.maximum * scale));
+}
+
+QString LXQtSysStatContent::coresToolTip() const
+{
+    const int cores = mHistory.seriesCount();
+    if (mHistory.size() == 0 || cores == 0)
+        return QString();
+
+    // the busiest cores of the newest sample
+    int busiest[3] = {-1, -1, -1};
+    float total = 0;
+    for (int core = 0; core < cores; ++core)
+    {
+        const float load = mHistory.value(core, 0);
+        total += load;
+        for (int i = 0; i < 3; ++i)
+        {
+            if (busiest[i] < 0 || load > mHistory.value(busiest[i], 0))
+            {
+                for (int j = 2; j > i; --j)
+                    busiest[j] = busiest[j - 1];
+                busiest[i] = core;
+                break;
+            }
+        }
+    }
+
+    QString info = tr("cores: %1<br>average: %2%", "Cores tooltip information")
+            .arg(cores).arg(static_cast<int>(total / cores * 100.0));
+    for (const int core : busiest)
+    {
+        if (core >= 0)
+            info += QStringLiteral("<br>cpu%1: %2%").arg(core).arg(static_cast<int>(mHistory.value(core, 0) * 100.0));
+    }
+    return info;
 }
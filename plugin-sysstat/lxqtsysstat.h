@@ -29,7 +29,9 @@
 #define LXQTPANELSYSSTAT_H
 
 #include "../panel/ilxqtpanelplugin.h"
+#include "../panel/systemsampler.h"
 #include "lxqtsysstatconfiguration.h"
+#include "lxqtsysstathistory.h"
 
 #include <QLabel>
 
@@ -38,10 +40,6 @@ class LXQtSysStatTitle;
 class LXQtSysStatContent;
 class LXQtPanel;
 
-namespace SysStat {
-    class BaseStat;
-}
-
 class LXQtSysStat : public QObject, public ILXQtPanelPlugin
 {
     Q_OBJECT
@@ -133,6 +131,7 @@ public slots:
     void reset();
 
 protected:
+    bool event(QEvent *event) override;
     void paintEvent(QPaintEvent *);
     void resizeEvent(QResizeEvent *);
 
@@ -142,14 +141,18 @@ protected slots:
     void memoryUpdate(float apps, float buffers, float cached);
     void swapUpdate(float used);
     void networkUpdate(unsigned received, unsigned transmitted);
+    void coresUpdate(const QVector<SystemSampler::CpuLoad> &cpu);
 
 private:
+    void sampled(const SystemSampler::Sample &sample);
     void toolTipInfo(QString const & tooltip);
+    QString historyToolTip() const;
+    QString coresToolTip() const;
 
 private:
     ILXQtPanelPlugin *mPlugin;
 
-    SysStat::BaseStat *mStat;
+    int mSubscription; //!< to SystemSampler, 0 if none
 
     typedef struct ColourPalette
     {
@@ -186,6 +189,7 @@ private:
     QString mDataSource;
 
     bool mUseFrequency;
+    bool mCoresHeatmap; //!< the "cores" CPU source: a row per core, coloured by its load
 
     int mNetMaximumSpeed;
     qreal mNetRealMaximumSpeed;
@@ -201,11 +205,49 @@ private:
     QColor mNetBothColour;
 
 
-    int mHistoryOffset;
+    LXQtSysStatHistory mHistory; //!< what the graph shows
+    int mHistoryOffset; //!< column of mHistoryImage for the next sample
     QImage mHistoryImage;
 
+    QString mToolTipInfo; //!< of the newest sample
+
+    QVector<float> mCoreLoads; //!< reused for each sample of the heatmap
+    QVector<QRgb> mColumn; //!< reused for each column of mHistoryImage
+
 
-    void clearLine();
+    int historySeriesCount() const;
+    void appendSample(std::initializer_list<float> values);
+    void appendSample(const float *values, int count);
+    //! Draws all the columns of mHistoryImage again, at the width of the widget
+    void redraw();
+    //! \param age of the sample in mHistory, the column is cleared if there is none
+    void drawColumn(int x, int age);
+    //! Fills \p column (a pixel per row of mHistoryImage), from the bottom, with the sample
+    void rasterizeSample(int age, QRgb *column) const;
+    qreal netScale(qreal speed) const;
+
+    // mColours of the graph, premultiplied like mHistoryImage
+    enum GraphColour
+    {
+        CpuSystemColour,
+        CpuUserColour,
+        CpuNiceColour,
+        CpuOtherColour,
+        FrequencyColour,
+        MemAppsColour,
+        MemBuffersColour,
+        MemCachedColour,
+        SwapUsedColour,
+        NetReceivedColour,
+        NetTransmittedColour,
+        NetBothColour,
+        GraphColourCount
+    };
+    QRgb mGraphColours[GraphColourCount];
+    QRgb mHeatColours[101]; //!< by load percentage, for the heatmap
+    void updateGraphColours();
+    //! Applies new mColours to the whole graph
+    void graphColoursChanged();
 
     void mixNetColours();
     void updateTitleFontPixelHeight();
@@ -31,9 +31,8 @@
 #include "lxqtsysstatutils.h"
 #include "lxqtsysstatcolours.h"
 
-#include <SysStat/CpuStat>
-#include <SysStat/MemStat>
-#include <SysStat/NetStat>
+#include "../panel/lxqtpanelapplication.h"
+#include "../panel/systemsampler.h"
 
 //Note: strings can't actually be translated here (in static initialization time)
 //      the QT_TR_NOOP here is just for qt translate tools to get the strings for translation
@@ -52,6 +51,7 @@ namespace
     void localizationWorkaround()
     {
         static_cast<void>(QT_TRANSLATE_NOOP("LXQtSysStatConfiguration", "cpu"));
+        static_cast<void>(QT_TRANSLATE_NOOP("LXQtSysStatConfiguration", "cores"));
         static_cast<void>(QT_TRANSLATE_NOOP("LXQtSysStatConfiguration", "cpu0"));
         static_cast<void>(QT_TRANSLATE_NOOP("LXQtSysStatConfiguration", "cpu1"));
         static_cast<void>(QT_TRANSLATE_NOOP("LXQtSysStatConfiguration", "cpu2"));
@@ -85,7 +85,6 @@ namespace
 LXQtSysStatConfiguration::LXQtSysStatConfiguration(PluginSettings *settings, QWidget *parent) :
     LXQtPanelPluginConfigDialog(settings, parent),
     ui(new Ui::LXQtSysStatConfiguration),
-    mStat(nullptr),
     mColoursDialog(nullptr),
     mLockSettingChanges(false)
 {
@@ -177,26 +176,24 @@ void LXQtSysStatConfiguration::saveSettings()
 
 void LXQtSysStatConfiguration::on_typeCOB_currentIndexChanged(int index)
 {
-    if (mStat)
-        mStat->deleteLater();
+    SystemSampler::Source source = SystemSampler::Cpu;
     switch (index)
     {
-    case 0:
-        mStat = new SysStat::CpuStat(this);
-        break;
-
     case 1:
-        mStat = new SysStat::MemStat(this);
+        source = SystemSampler::Memory;
         break;
 
     case 2:
-        mStat = new SysStat::NetStat(this);
+        source = SystemSampler::Network;
         break;
     }
 
     ui->sourceCOB->blockSignals(true);
     ui->sourceCOB->clear();
-    const auto sources = mStat->sources();
+    QStringList sources = static_cast<LXQtPanelApplication *>(qApp)->getSystemSampler()->sourceNames(source);
+    // all the cores at once, as a heatmap, after the average of "cpu"
+    if (source == SystemSampler::Cpu && !sources.isEmpty())
+        sources.insert(1, QStringLiteral("cores"));
     for (auto const & s : sources)
         ui->sourceCOB->addItem(tr(s.toStdString().c_str()), s);
     ui->sourceCOB->blockSignals(false);
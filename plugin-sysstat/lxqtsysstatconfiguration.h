@@ -38,10 +38,6 @@ namespace Ui {
     class LXQtSysStatConfiguration;
 }
 
-namespace SysStat {
-    class BaseStat;
-}
-
 class LXQtSysStatColours;
 
 class LXQtSysStatConfiguration : public LXQtPanelPluginConfigDialog
@@ -70,7 +66,6 @@ signals:
 private:
     Ui::LXQtSysStatConfiguration *ui;
 
-    SysStat::BaseStat *mStat;
     LXQtSysStatColours *mColoursDialog;
 
     bool mLockSettingChanges;
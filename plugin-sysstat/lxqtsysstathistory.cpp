@@ -0,0 +1,110 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt.org
+ *
+ * Copyright: 2026 LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "lxqtsysstathistory.h"
+
+#include <limits>
+
+LXQtSysStatHistory::LXQtSysStatHistory()
+    : mSeriesCount(0)
+    , mCapacity(0)
+    , mHead(0)
+    , mSize(0)
+{
+}
+
+void LXQtSysStatHistory::reset(int seriesCount, int capacity)
+{
+    mSeriesCount = qMax(0, seriesCount);
+    mCapacity = qMax(1, capacity);
+    mValues.fill(0, mSeriesCount * mCapacity);
+    mHead = 0;
+    mSize = 0;
+}
+
+void LXQtSysStatHistory::clear()
+{
+    mHead = 0;
+    mSize = 0;
+}
+
+void LXQtSysStatHistory::setCapacity(int capacity)
+{
+    capacity = qMax(1, capacity);
+    if (capacity == mCapacity)
+        return;
+
+    // oldest first, so that the ring starts at 0 again
+    const int kept = qMin(mSize, capacity);
+    QVector<float> values(mSeriesCount * capacity, 0);
+    for (int series = 0; series < mSeriesCount; ++series)
+    {
+        float *row = values.data() + series * capacity;
+        for (int age = kept - 1; age >= 0; --age)
+            *row++ = value(series, age);
+    }
+
+    mValues.swap(values);
+    mCapacity = capacity;
+    mSize = kept;
+    mHead = kept % capacity;
+}
+
+void LXQtSysStatHistory::append(const float *values, int count)
+{
+    if (!mSeriesCount)
+        return;
+
+    float *data = mValues.data() + mHead;
+    for (int series = 0; series < mSeriesCount; ++series, data += mCapacity)
+        *data = series < count ? values[series] : 0;
+
+    mHead = (mHead + 1) % mCapacity;
+    mSize = qMin(mSize + 1, mCapacity);
+}
+
+LXQtSysStatHistory::Statistics LXQtSysStatHistory::statistics(int first, int count) const
+{
+    Statistics result;
+    first = qBound(0, first, mSeriesCount);
+    count = qBound(0, count, mSeriesCount - first);
+    if (!mSize || !count)
+        return result;
+
+    result.minimum = std::numeric_limits<float>::max();
+    result.maximum = std::numeric_limits<float>::lowest();
+    double total = 0;
+    for (int age = 0; age < mSize; ++age)
+    {
+        float sum = 0;
+        for (int series = first; series < first + count; ++series)
+            sum += value(series, age);
+        result.minimum = qMin(result.minimum, sum);
+        result.maximum = qMax(result.maximum, sum);
+        total += sum;
+    }
+    result.average = static_cast<float>(total / mSize);
+    return result;
+}
@@ -0,0 +1,89 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt.org
+ *
+ * Copyright: 2026 LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#ifndef LXQTSYSSTATHISTORY_H
+#define LXQTSYSSTATHISTORY_H
+
+#include <QVector>
+
+#include <initializer_list>
+
+/*!
+ * \brief The samples shown by the graph, kept as numbers so that the graph
+ * can be drawn again at any size and with any colours or scale.
+ *
+ * Each series (e.g. user, nice, system... for the CPU) is a contiguous ring of
+ * capacity() values; the oldest samples are dropped first.
+ */
+class LXQtSysStatHistory
+{
+public:
+    struct Statistics
+    {
+        float minimum = 0;
+        float average = 0;
+        float maximum = 0;
+    };
+
+    LXQtSysStatHistory();
+
+    //! Drops all the samples
+    void reset(int seriesCount, int capacity);
+    void clear();
+    //! Keeps the newest samples that fit
+    void setCapacity(int capacity);
+
+    int seriesCount() const { return mSeriesCount; }
+    int capacity() const { return mCapacity; }
+    int size() const { return mSize; }
+
+    //! One value per series, missing ones are 0
+    void append(std::initializer_list<float> values)
+    {
+        append(values.begin(), static_cast<int>(values.size()));
+    }
+    void append(const float *values, int count);
+
+    //! \param age 0 for the newest sample, less than size()
+    float value(int series, int age) const
+    {
+        int index = mHead - 1 - age;
+        if (index < 0)
+            index += mCapacity;
+        return mValues[series * mCapacity + index];
+    }
+
+    //! Of the sums of the series [first, first + count) over all the samples
+    Statistics statistics(int first, int count) const;
+
+private:
+    QVector<float> mValues; //!< series after series
+    int mSeriesCount;
+    int mCapacity;
+    int mHead; //!< where the next sample goes
+    int mSize;
+};
+
+#endif // LXQTSYSSTATHISTORY_H
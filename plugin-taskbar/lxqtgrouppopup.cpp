@@ -30,6 +30,9 @@
 
 #include "lxqtgrouppopup.h"
 #include "lxqttaskgroup.h"
+#include "lxqttaskbar.h"
+
+#include "../panel/backends/ilxqttaskbarabstractbackend.h"
 
 #include <QEnterEvent>
 #include <QDrag>
@@ -152,6 +155,37 @@ void LXQtGroupPopup::paintEvent(QPaintEvent * /*event*/)
     style()->drawPrimitive(QStyle::PE_Widget, &opt, &p, this);
 }
 
+/************************************************
+ * The windows are captured only while the popup is shown
+ ************************************************/
+void LXQtGroupPopup::showEvent(QShowEvent *event)
+{
+    setThumbnailsVisible(showsThumbnails());
+    QFrame::showEvent(event);
+}
+
+void LXQtGroupPopup::hideEvent(QHideEvent *event)
+{
+    setThumbnailsVisible(false);
+    QFrame::hideEvent(event);
+}
+
+bool LXQtGroupPopup::showsThumbnails() const
+{
+    LXQtTaskBar *taskBar = mGroup->parentTaskBar();
+    return taskBar->isShowThumbnails() && taskBar->getBackend()->supportsWindowThumbnails();
+}
+
+void LXQtGroupPopup::setThumbnailsVisible(bool visible)
+{
+    QLayout* l = layout();
+    for (int i = 0; l->count() > i; ++i)
+    {
+        if (LXQtTaskButton *button = qobject_cast<LXQtTaskButton *>(l->itemAt(i)->widget()))
+            button->setThumbnailVisible(visible);
+    }
+}
+
 void LXQtGroupPopup::hide(bool fast)
 {
     if (fast)
@@ -174,6 +208,8 @@ int LXQtGroupPopup::indexOf(LXQtTaskButton *button)
 void LXQtGroupPopup::addButton(LXQtTaskButton *button)
 {
     layout()->addWidget(button);
+    if (isVisible())
+        button->setThumbnailVisible(showsThumbnails());
 }
 
 void LXQtGroupPopup::closeTimerSlot()
@@ -59,6 +59,9 @@ public:
     void addButton(LXQtTaskButton* button);
     void removeWidget(QWidget *button) { layout()->removeWidget(button); }
 
+    // The buttons show window thumbnails (enabled and supported by the backend)
+    bool showsThumbnails() const;
+
 protected:
     void dragEnterEvent(QDragEnterEvent * event);
     void dragLeaveEvent(QDragLeaveEvent *event);
@@ -66,10 +69,14 @@ protected:
     void leaveEvent(QEvent * event);
     void enterEvent(QEnterEvent *event);
     void paintEvent(QPaintEvent * event);
+    void showEvent(QShowEvent * event);
+    void hideEvent(QHideEvent * event);
 
     void closeTimerSlot();
 
 private:
+    void setThumbnailsVisible(bool visible);
+
     LXQtTaskGroup *mGroup;
     QTimer mCloseTimer;
 };
@@ -40,6 +40,7 @@
 #include <QWheelEvent>
 #include <QFlag>
 #include <QTimer>
+#include <QScreen>
 
 #include "../panel/ilxqtpanelplugin.h"
 #include "../panel/pluginsettings.h"
@@ -48,6 +49,8 @@
 #include <LXQt/GridLayout>
 
 #include "lxqttaskgroup.h"
+#include "../panel/backends/lxqttaskbariconcache.h"
+#include "lxqttaskbarview.h"
 #include "../panel/pluginsettings.h"
 
 #include "../panel/backends/ilxqttaskbarabstractbackend.h"
@@ -73,14 +76,20 @@ LXQtTaskBar::LXQtTaskBar(ILXQtPanelPlugin *plugin, QWidget *parent) :
     mAutoRotate(true),
     mGroupingEnabled(true),
     mShowGroupOnHover(true),
+    mShowThumbnails(false),
+    mThumbnailWidth(192),
     mUngroupedNextToExisting(false),
     mIconByClass(false),
+    mLightweightView(false),
     mWheelEventsAction(1),
     mWheelDeltaThreshold(300),
+    mUpdateInterval(0),
     mPlugin(plugin),
     mPlaceHolder(new QWidget(this)),
     mStyle(new LeftAlignedTextStyle()),
-    mBackend(nullptr)
+    mBackend(nullptr),
+    mTaskModel(nullptr),
+    mView(nullptr)
 {
     setStyle(mStyle);
     mLayout = new LXQt::GridLayout(this);
@@ -97,6 +106,7 @@ LXQtTaskBar::LXQtTaskBar(ILXQtPanelPlugin *plugin, QWidget *parent) :
     // Get backend
     LXQtPanelApplication *a = static_cast<LXQtPanelApplication*>(qApp);
     mBackend = a->getWMBackend();
+    mTaskModel = a->getTaskModel();
 
     QTimer::singleShot(0, this, &LXQtTaskBar::settingsChanged);
     setAcceptDrops(true);
@@ -104,18 +114,43 @@ LXQtTaskBar::LXQtTaskBar(ILXQtPanelPlugin *plugin, QWidget *parent) :
     connect(mSignalMapper, &QSignalMapper::mappedInt, this, &LXQtTaskBar::activateTask);
     QTimer::singleShot(0, this, &LXQtTaskBar::registerShortcuts);
 
-    connect(mBackend, &ILXQtTaskbarAbstractBackend::windowPropertyChanged, this, &LXQtTaskBar::onWindowChanged);
-    connect(mBackend, &ILXQtTaskbarAbstractBackend::windowAdded, this, &LXQtTaskBar::onWindowAdded);
-    connect(mBackend, &ILXQtTaskbarAbstractBackend::windowRemoved, this, &LXQtTaskBar::onWindowRemoved);
+    connect(mTaskModel, &LXQtTaskModel::windowChanged, this, &LXQtTaskBar::onWindowChanged);
+    connect(mTaskModel, &LXQtTaskModel::windowAdded, this, &LXQtTaskBar::onWindowAdded);
+    connect(mTaskModel, &LXQtTaskModel::windowRemoved, this, &LXQtTaskBar::onWindowRemoved);
+
+    // a decoded icon is ready, update the buttons without invalidating it again
+    connect(mTaskModel->iconCache(), &LXQtTaskBarIconCache::iconChanged, this, [this] (WId window) {
+        auto i = mKnownWindows.constFind(window);
+        if (mKnownWindows.cend() != i)
+            (*i)->onWindowChanged(window, windowPropertyFlag(LXQtTaskBarWindowProperty::Icon));
+    });
+
+    // Don't create the buttons only to replace them with the view in settingsChanged()
+    mLightweightView = mPlugin->settings()->value(QStringLiteral("lightweightView"), false).toBool();
+    if (mLightweightView)
+    {
+        createView();
+        return;
+    }
 
     // Consider already fetched windows
-    const auto initialWindows = mBackend->getCurrentWindows();
+    const auto initialWindows = mTaskModel->windows();
     for(WId windowId : initialWindows)
     {
         onWindowAdded(windowId);
     }
 }
 
+/************************************************
+
+ ************************************************/
+void LXQtTaskBar::createView()
+{
+    mView = new LXQtTaskBarView(this);
+    mLayout->addWidget(mView);
+    refreshPlaceholderVisibility();
+}
+
 /************************************************
 
  ************************************************/
@@ -124,6 +159,27 @@ LXQtTaskBar::~LXQtTaskBar()
     delete mStyle;
 }
 
+/************************************************
+
+ ************************************************/
+LXQtTaskBarIconCache *LXQtTaskBar::iconCache() const
+{
+    return mTaskModel->iconCache();
+}
+
+/************************************************
+
+ ************************************************/
+LXQtTaskModel::Filter LXQtTaskBar::windowFilter() const
+{
+    LXQtTaskModel::Filter filter;
+    filter.workspaceOnly = mShowOnlyOneDesktopTasks;
+    filter.workspace = mShowDesktopNum;
+    filter.screen = mShowOnlyCurrentScreenTasks ? screen() : nullptr;
+    filter.minimizedOnly = mShowOnlyMinimizedTasks;
+    return filter;
+}
+
 /************************************************
 
  ************************************************/
@@ -239,6 +295,9 @@ void LXQtTaskBar::groupBecomeEmptySlot()
         else
             ++i;
     }
+    if (mGroups.value(group->groupName()) == group)
+        mGroups.remove(group->groupName());
+    mGroupsByClass.remove(group->windowClass(), group);
     mLayout->removeWidget(group);
     group->deleteLater();
 }
@@ -248,8 +307,9 @@ void LXQtTaskBar::groupBecomeEmptySlot()
  ************************************************/
 void LXQtTaskBar::addWindow(WId window)
 {
+    const QString window_class = mTaskModel->windowClass(window);
     // If grouping disabled group behaves like regular button
-    const QString group_id = mGroupingEnabled ? mBackend->getWindowClass(window) : QString::number(window);
+    const QString group_id = mGroupingEnabled ? window_class : QString::number(window);
 
     LXQtTaskGroup *group = nullptr;
     auto i_group = mKnownWindows.find(window);
@@ -263,20 +323,11 @@ void LXQtTaskBar::addWindow(WId window)
 
     //check if window belongs to some existing group
     if (!group && mGroupingEnabled)
-    {
-        for (auto i = mKnownWindows.cbegin(), i_e = mKnownWindows.cend(); i != i_e; ++i)
-        {
-            if ((*i)->groupName() == group_id)
-            {
-                group = *i;
-                break;
-            }
-        }
-    }
+        group = mGroups.value(group_id);
 
     if (!group)
     {
-        group = new LXQtTaskGroup(group_id, window, this);
+        group = new LXQtTaskGroup(group_id, window_class, window, this);
         connect(group, &LXQtTaskGroup::groupBecomeEmpty,  this, &LXQtTaskBar::groupBecomeEmptySlot);
         connect(group, &LXQtTaskGroup::visibilityChanged, this, &LXQtTaskBar::refreshPlaceholderVisibility);
         connect(group, &LXQtTaskGroup::popupShown,        this, &LXQtTaskBar::popupShown);
@@ -288,28 +339,23 @@ void LXQtTaskBar::addWindow(WId window)
 
         if (mUngroupedNextToExisting)
         {
-            const QString window_class = mBackend->getWindowClass(window);
             int src_index = mLayout->count() - 1;
             int dst_index = src_index;
-            for (int i = mLayout->count() - 2; 0 <= i; --i)
-            {
-                LXQtTaskGroup * current_group = qobject_cast<LXQtTaskGroup*>(mLayout->itemAt(i)->widget());
-                if (nullptr != current_group)
-                {
-                    const QString current_class = mBackend->getWindowClass(current_group->groupName().toUInt());
-                    if(current_class == window_class)
-                    {
-                        dst_index = i + 1;
-                        break;
-                    }
-                }
-            }
+            // place it after the last group of the same class
+            int last_index = -1;
+            for (auto i = mGroupsByClass.constFind(window_class), i_e = mGroupsByClass.cend(); i != i_e && i.key() == window_class; ++i)
+                last_index = qMax(last_index, mLayout->indexOf(*i));
+            if (last_index != -1)
+                dst_index = last_index + 1;
 
             if (dst_index != src_index)
             {
                 mLayout->moveItem(src_index, dst_index, false);
             }
         }
+
+        mGroups.insert(group_id, group);
+        mGroupsByClass.insert(window_class, group);
     }
     mKnownWindows[window] = group;
     group->addWindow(window);
@@ -330,21 +376,45 @@ auto LXQtTaskBar::removeWindow(windowMap_t::iterator pos) -> windowMap_t::iterat
 /************************************************
 
  ************************************************/
-void LXQtTaskBar::onWindowChanged(WId window, int prop)
+void LXQtTaskBar::onWindowChanged(WId window, int props)
 {
     auto i = mKnownWindows.find(window);
     if (mKnownWindows.end() != i)
     {
-        if (!(*i)->onWindowChanged(window, LXQtTaskBarWindowProperty(prop)))
+        if (!(*i)->onWindowChanged(window, props))
         {
             // window is removed from a group because of class change, so we should add it again
             addWindow(window);
         }
+        else if (props & windowPropertyFlag(LXQtTaskBarWindowProperty::WindowClass))
+        {
+            updateGroupClass(*i);
+        }
     }
 }
 
+/************************************************
+
+ ************************************************/
+void LXQtTaskBar::updateGroupClass(LXQtTaskGroup * group)
+{
+    // groups keep their class when grouping is enabled,
+    // ungrouped buttons follow the class of their window
+    const QString window_class = mTaskModel->windowClass(group->windowId());
+    if (mGroupingEnabled || group->windowClass() == window_class)
+        return;
+
+    mGroupsByClass.remove(group->windowClass(), group);
+    group->setWindowClass(window_class);
+    mGroupsByClass.insert(window_class, group);
+}
+
 void LXQtTaskBar::onWindowAdded(WId window)
 {
+    // the view has its own model
+    if (mView)
+        return;
+
     auto const pos = mKnownWindows.find(window);
     if (mKnownWindows.end() == pos)
         addWindow(window);
@@ -378,6 +448,12 @@ void LXQtTaskBar::refreshButtonRotation()
  ************************************************/
 void LXQtTaskBar::refreshPlaceholderVisibility()
 {
+    if (mView)
+    {
+        mPlaceHolder->setVisible(false);
+        return;
+    }
+
     // if no visible group button show placeholder widget
     bool haveVisibleWindow = false;
     for (auto i = mKnownWindows.cbegin(), i_e = mKnownWindows.cend(); i_e != i; ++i)
@@ -422,6 +498,7 @@ void LXQtTaskBar::settingsChanged()
     bool showOnlyCurrentScreenTasksOld = mShowOnlyCurrentScreenTasks;
     bool showOnlyMinimizedTasksOld = mShowOnlyMinimizedTasks;
     const bool iconByClassOld = mIconByClass;
+    const bool lightweightViewOld = mLightweightView;
 
     mButtonWidth = mPlugin->settings()->value(QStringLiteral("buttonWidth"), 400).toInt();
     mButtonHeight = mPlugin->settings()->value(QStringLiteral("buttonHeight"), 100).toInt();
@@ -443,13 +520,18 @@ void LXQtTaskBar::settingsChanged()
     mRaiseOnCurrentDesktop = mPlugin->settings()->value(QStringLiteral("raiseOnCurrentDesktop"), false).toBool();
     mGroupingEnabled = mPlugin->settings()->value(QStringLiteral("groupingEnabled"),true).toBool();
     mShowGroupOnHover = mPlugin->settings()->value(QStringLiteral("showGroupOnHover"),true).toBool();
+    mShowThumbnails = mPlugin->settings()->value(QStringLiteral("showThumbnails"), false).toBool();
+    mThumbnailWidth = qBound(64, mPlugin->settings()->value(QStringLiteral("thumbnailWidth"), 192).toInt(), 640);
     mUngroupedNextToExisting = mPlugin->settings()->value(QStringLiteral("ungroupedNextToExisting"),false).toBool();
     mIconByClass = mPlugin->settings()->value(QStringLiteral("iconByClass"), false).toBool();
+    mLightweightView = mPlugin->settings()->value(QStringLiteral("lightweightView"), false).toBool();
     mWheelEventsAction = mPlugin->settings()->value(QStringLiteral("wheelEventsAction"), 1).toInt();
     mWheelDeltaThreshold = mPlugin->settings()->value(QStringLiteral("wheelDeltaThreshold"), 300).toInt();
+    mUpdateInterval = qMax(0, mPlugin->settings()->value(QStringLiteral("updateInterval"), 0).toInt());
 
-    // Delete all groups if grouping or ungrouped next to existing feature toggled and start over
-    if (groupingEnabledOld != mGroupingEnabled || ungroupedNextToExistingOld != mUngroupedNextToExisting)
+    // Delete all groups if grouping, ungrouped next to existing or lightweight view feature toggled and start over
+    if (groupingEnabledOld != mGroupingEnabled || ungroupedNextToExistingOld != mUngroupedNextToExisting
+            || lightweightViewOld != mLightweightView)
     {
         for (int i = mLayout->count() - 1; 0 <= i; --i)
         {
@@ -461,6 +543,32 @@ void LXQtTaskBar::settingsChanged()
             }
         }
         mKnownWindows.clear();
+        mGroups.clear();
+        mGroupsByClass.clear();
+    }
+
+    if (lightweightViewOld != mLightweightView)
+    {
+        if (mView)
+        {
+            mLayout->removeWidget(mView);
+            delete mView;
+            mView = nullptr;
+
+            // Create the buttons of the windows
+            const auto windows = mTaskModel->windows();
+            for (WId windowId : windows)
+                onWindowAdded(windowId);
+        }
+        else
+        {
+            createView();
+        }
+        realign();
+    }
+    else if (mView)
+    {
+        mView->settingsChanged();
     }
 
     if (showOnlyOneDesktopTasksOld != mShowOnlyOneDesktopTasks
@@ -484,6 +592,19 @@ void LXQtTaskBar::realign()
     mLayout->setEnabled(false);
     refreshButtonRotation();
 
+    if (mView)
+    {
+        // a single cell with the view, it lays out the windows itself
+        mLayout->setRowCount(1);
+        mLayout->setColumnCount(1);
+        mLayout->setCellMinimumSize(QSize(0, 0));
+        mLayout->setCellMaximumSize(QSize(QWIDGETSIZE_MAX, QWIDGETSIZE_MAX));
+        mLayout->setEnabled(true);
+        mView->realign();
+        emit refreshIconGeometry();
+        return;
+    }
+
     ILXQtPanel *panel = mPlugin->panel();
     QSize maxSize = QSize(mButtonWidth, mButtonHeight);
     QSize minSize = QSize(0, 0);
@@ -538,6 +659,20 @@ ILXQtPanel *LXQtTaskBar::panel() const
     return mPlugin->panel();
 }
 
+/************************************************
+
+ ************************************************/
+int LXQtTaskBar::updateInterval() const
+{
+    if (mUpdateInterval > 0)
+        return mUpdateInterval;
+
+    // one frame of the screen the panel is on
+    const QScreen *scr = screen();
+    const qreal rate = scr ? scr->refreshRate() : 0.0;
+    return rate > 0.0 ? qMax(1, qRound(1000.0 / rate)) : 16;
+}
+
 /************************************************
 
  ************************************************/
@@ -34,9 +34,11 @@
 
 #include <QFrame>
 #include <QBoxLayout>
-#include <QMap>
+#include <QHash>
+#include <QMultiHash>
 
 #include "../panel/ilxqtpanel.h"
+#include "../panel/backends/lxqttaskmodel.h"
 
 class ILXQtPanel;
 class ILXQtPanelPlugin;
@@ -48,6 +50,8 @@ class LXQtTaskGroup;
 class LeftAlignedTextStyle;
 
 class ILXQtTaskbarAbstractBackend;
+class LXQtTaskBarIconCache;
+class LXQtTaskBarView;
 
 namespace LXQt {
 class GridLayout;
@@ -79,14 +83,24 @@ public:
     bool isAutoRotate() const { return mAutoRotate; }
     bool isGroupingEnabled() const { return mGroupingEnabled; }
     bool isShowGroupOnHover() const { return mShowGroupOnHover; }
+    bool isShowThumbnails() const { return mShowThumbnails; }
+    //! Maximum size of the window thumbnails in the group popups
+    QSize thumbnailSize() const { return QSize(mThumbnailWidth, mThumbnailWidth * 9 / 16); }
     bool isIconByClass() const { return mIconByClass; }
+    bool isLightweightView() const { return mLightweightView; }
     int wheelEventsAction() const { return mWheelEventsAction; }
     int wheelDeltaThreshold() const { return mWheelDeltaThreshold; }
+    int updateInterval() const;
 
     ILXQtPanel * panel() const;
     inline ILXQtPanelPlugin * plugin() const { return mPlugin; }
 
     inline ILXQtTaskbarAbstractBackend *getBackend() const { return mBackend; }
+    //! Shared by the taskbars of all the panels
+    inline LXQtTaskModel *taskModel() const { return mTaskModel; }
+    LXQtTaskBarIconCache *iconCache() const;
+    //! The windows of taskModel() shown by this taskbar
+    LXQtTaskModel::Filter windowFilter() const;
 
 public slots:
     void settingsChanged();
@@ -108,7 +122,7 @@ private slots:
     void refreshPlaceholderVisibility();
     void groupBecomeEmptySlot();
 
-    void onWindowChanged(WId window, int prop);
+    void onWindowChanged(WId window, int props);
     void onWindowAdded(WId window);
     void onWindowRemoved(WId window);
 
@@ -117,15 +131,19 @@ private slots:
     void activateTask(int pos);
 
 private:
-    typedef QMap<WId, LXQtTaskGroup*> windowMap_t;
+    typedef QHash<WId, LXQtTaskGroup*> windowMap_t;
 
 private:
+    void createView();
     void addWindow(WId window);
     windowMap_t::iterator removeWindow(windowMap_t::iterator pos);
+    void updateGroupClass(LXQtTaskGroup * group);
     void buttonMove(LXQtTaskGroup * dst, LXQtTaskGroup * src, QPoint const & pos);
 
 private:
-    QMap<WId, LXQtTaskGroup*> mKnownWindows; //!< Ids of known windows (mapping to buttons/groups)
+    windowMap_t mKnownWindows; //!< Ids of known windows (mapping to buttons/groups)
+    QHash<QString, LXQtTaskGroup*> mGroups; //!< groups by their groupName()
+    QMultiHash<QString, LXQtTaskGroup*> mGroupsByClass; //!< groups by their windowClass()
     LXQt::GridLayout *mLayout;
     QList<GlobalKeyShortcut::Action*> mKeys;
     QSignalMapper *mSignalMapper;
@@ -143,10 +161,14 @@ private:
     bool mAutoRotate;
     bool mGroupingEnabled;
     bool mShowGroupOnHover;
+    bool mShowThumbnails;
+    int mThumbnailWidth;
     bool mUngroupedNextToExisting;
     bool mIconByClass;
+    bool mLightweightView;
     int mWheelEventsAction;
     int mWheelDeltaThreshold;
+    int mUpdateInterval; //!< ms between two title/icon updates of a button, 0 = one display frame
 
     void setButtonStyle(Qt::ToolButtonStyle buttonStyle);
 
@@ -159,6 +181,8 @@ private:
     LeftAlignedTextStyle *mStyle;
 
     ILXQtTaskbarAbstractBackend *mBackend;
+    LXQtTaskModel *mTaskModel;
+    LXQtTaskBarView *mView; //!< replaces the groups in the lightweight view mode
 };
 
 #endif // LXQTTASKBAR_H
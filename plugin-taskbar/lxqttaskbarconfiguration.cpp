@@ -78,11 +78,13 @@ LXQtTaskbarConfiguration::LXQtTaskbarConfiguration(PluginSettings *settings, QWi
     connect(ui->buttonHeightSB, &QAbstractSpinBox::editingFinished, this, &LXQtTaskbarConfiguration::saveSettings);
     connect(ui->autoRotateCB, &QAbstractButton::clicked, this, &LXQtTaskbarConfiguration::saveSettings);
     connect(ui->middleClickCB, &QAbstractButton::clicked, this, &LXQtTaskbarConfiguration::saveSettings);
+    connect(ui->lightweightViewCB, &QAbstractButton::clicked, this, &LXQtTaskbarConfiguration::saveSettings);
     connect(ui->groupingGB, &QGroupBox::clicked, this, [this] {
         saveSettings();
         ui->ungroupedNextToExistingCB->setEnabled(!(ui->groupingGB->isChecked()));
     });
     connect(ui->showGroupOnHoverCB, &QAbstractButton::clicked, this, &LXQtTaskbarConfiguration::saveSettings);
+    connect(ui->showThumbnailsCB, &QAbstractButton::clicked, this, &LXQtTaskbarConfiguration::saveSettings);
     connect(ui->ungroupedNextToExistingCB, &QAbstractButton::clicked, this, &LXQtTaskbarConfiguration::saveSettings);
     connect(ui->iconByClassCB, &QAbstractButton::clicked, this, &LXQtTaskbarConfiguration::saveSettings);
     connect(ui->wheelEventsActionCB, QOverload<int>::of(&QComboBox::activated), this, &LXQtTaskbarConfiguration::saveSettings);
@@ -105,12 +107,14 @@ void LXQtTaskbarConfiguration::loadSettings()
 
     ui->autoRotateCB->setChecked(settings().value(QStringLiteral("autoRotate"), true).toBool());
     ui->middleClickCB->setChecked(settings().value(QStringLiteral("closeOnMiddleClick"), true).toBool());
+    ui->lightweightViewCB->setChecked(settings().value(QStringLiteral("lightweightView"), false).toBool());
     ui->raiseOnCurrentDesktopCB->setChecked(settings().value(QStringLiteral("raiseOnCurrentDesktop"), false).toBool());
     ui->buttonStyleCB->setCurrentIndex(ui->buttonStyleCB->findData(settings().value(QStringLiteral("buttonStyle"), QLatin1String("IconText"))));
     ui->buttonWidthSB->setValue(settings().value(QStringLiteral("buttonWidth"), 400).toInt());
     ui->buttonHeightSB->setValue(settings().value(QStringLiteral("buttonHeight"), 100).toInt());
     ui->groupingGB->setChecked(settings().value(QStringLiteral("groupingEnabled"),true).toBool());
     ui->showGroupOnHoverCB->setChecked(settings().value(QStringLiteral("showGroupOnHover"),true).toBool());
+    ui->showThumbnailsCB->setChecked(settings().value(QStringLiteral("showThumbnails"), false).toBool());
     ui->ungroupedNextToExistingCB->setChecked(settings().value(QStringLiteral("ungroupedNextToExisting"),false).toBool());
     ui->iconByClassCB->setChecked(settings().value(QStringLiteral("iconByClass"), false).toBool());
     ui->wheelEventsActionCB->setCurrentIndex(ui->wheelEventsActionCB->findData(settings().value(QStringLiteral("wheelEventsAction"), 0).toInt()));
@@ -128,9 +132,11 @@ void LXQtTaskbarConfiguration::saveSettings()
     settings().setValue(QStringLiteral("buttonHeight"), ui->buttonHeightSB->value());
     settings().setValue(QStringLiteral("autoRotate"), ui->autoRotateCB->isChecked());
     settings().setValue(QStringLiteral("closeOnMiddleClick"), ui->middleClickCB->isChecked());
+    settings().setValue(QStringLiteral("lightweightView"), ui->lightweightViewCB->isChecked());
     settings().setValue(QStringLiteral("raiseOnCurrentDesktop"), ui->raiseOnCurrentDesktopCB->isChecked());
     settings().setValue(QStringLiteral("groupingEnabled"),ui->groupingGB->isChecked());
     settings().setValue(QStringLiteral("showGroupOnHover"),ui->showGroupOnHoverCB->isChecked());
+    settings().setValue(QStringLiteral("showThumbnails"), ui->showThumbnailsCB->isChecked());
     settings().setValue(QStringLiteral("ungroupedNextToExisting"),ui->ungroupedNextToExistingCB->isChecked());
     settings().setValue(QStringLiteral("iconByClass"),ui->iconByClassCB->isChecked());
     settings().setValue(QStringLiteral("wheelEventsAction"),ui->wheelEventsActionCB->itemData(ui->wheelEventsActionCB->currentIndex()));
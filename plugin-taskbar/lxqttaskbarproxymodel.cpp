@@ -1,12 +1,13 @@
 #include "lxqttaskbarproxymodel.h"
 
-#include "../panel/backends/ilxqttaskbarabstractbackend.h"
+#include "../panel/backends/lxqttaskbariconcache.h"
+#include "../panel/backends/lxqttaskmodel.h"
 
 #include <QIcon>
 
 LXQtTaskBarProxyModel::LXQtTaskBarProxyModel(QObject *parent)
     : QAbstractListModel(parent)
-    , m_backend(nullptr)
+    , m_taskModel(nullptr)
     , m_groupByWindowClass(false)
 {
 
@@ -27,7 +28,12 @@ QVariant LXQtTaskBarProxyModel::data(const QModelIndex &idx, int role) const
     switch (role)
     {
     case Qt::DisplayRole:
+    case Qt::ToolTipRole:
         return item.windows.count() == 1 ? item.windows.first().title : item.windowClass;
+    case WindowCountRole:
+        return int(item.windows.count());
+    case DemandsAttentionRole:
+        return item.demandsAttention();
     default:
         break;
     }
@@ -37,7 +43,7 @@ QVariant LXQtTaskBarProxyModel::data(const QModelIndex &idx, int role) const
 
 QIcon LXQtTaskBarProxyModel::getWindowIcon(int itemRow, int windowIdxInGroup, int devicePixels) const
 {
-    if(!m_backend || itemRow < 0 || itemRow >= m_items.size() || windowIdxInGroup < 0)
+    if(!m_taskModel || itemRow < 0 || itemRow >= m_items.size() || windowIdxInGroup < 0)
         return QIcon();
 
     const LXQtTaskBarProxyModelItem& item = m_items.at(itemRow);
@@ -45,124 +51,200 @@ QIcon LXQtTaskBarProxyModel::getWindowIcon(int itemRow, int windowIdxInGroup, in
         return QIcon();
 
     const LXQtTaskBarProxyModelWindow& window = item.windows.at(windowIdxInGroup);
-    return m_backend->getApplicationIcon(window.windowId, devicePixels);
+    return m_taskModel->iconCache()->windowIcon(window.windowId, devicePixels, false);
 }
 
-void LXQtTaskBarProxyModel::onWindowAdded(WId windowId)
+WId LXQtTaskBarProxyModel::windowIdAt(int itemRow, int windowIdxInGroup) const
 {
-    QString windowClass = m_backend->getWindowClass(windowId);
-    bool willAddRow = !m_groupByWindowClass || !hasWindowClass(windowClass);
+    if(itemRow < 0 || itemRow >= m_items.size())
+        return 0;
 
-    if(willAddRow)
-    {
-        const int row = m_items.count();
-        beginInsertRows(QModelIndex(), row, row);
-    }
+    const LXQtTaskBarProxyModelItem& item = m_items.at(itemRow);
+    if(windowIdxInGroup < 0 || windowIdxInGroup >= item.windows.size())
+        return 0;
 
-    addWindow_internal(windowId);
+    return item.windows.at(windowIdxInGroup).windowId;
+}
 
-    if(willAddRow)
-        endInsertRows();
+int LXQtTaskBarProxyModel::rowOfWindow(WId windowId) const
+{
+    auto pos = m_windowPositions.constFind(windowId);
+    return pos == m_windowPositions.cend() ? -1 : pos->row;
 }
 
-void LXQtTaskBarProxyModel::onWindowRemoved(WId windowId)
+void LXQtTaskBarProxyModel::onWindowAdded(WId windowId)
 {
-    int row = -1;
-    int windowIdxInGroup = -1;
-    for(int i = 0; i < m_items.count(); i++)
+    if(m_windowPositions.contains(windowId))
+        return;
+
+    const QString windowClass = m_taskModel->windowClass(windowId);
+    const int row = m_groupByWindowClass ? m_classRows.value(windowClass, -1) : -1;
+
+    if(row == -1)
     {
-        windowIdxInGroup = m_items.at(i).indexOfWindow(windowId);
-        if(windowIdxInGroup != -1)
-        {
-            row = i;
-            break;
-        }
+        const int newRow = m_items.count();
+        beginInsertRows(QModelIndex(), newRow, newRow);
+        addWindow_internal(windowId, windowClass);
+        endInsertRows();
+        return;
     }
 
-    if(row == -1)
+    addWindow_internal(windowId, windowClass);
+    emitWindowsChanged(row);
+}
+
+void LXQtTaskBarProxyModel::onWindowRemoved(WId windowId)
+{
+    auto pos = m_windowPositions.constFind(windowId);
+    if(pos == m_windowPositions.cend())
         return;
 
-    LXQtTaskBarProxyModelItem& item = m_items[row];
-    item.windows.removeAt(windowIdxInGroup);
+    const int row = pos->row;
+    takeWindow_internal(windowId);
 
-    if(item.windows.isEmpty())
+    if(m_items.at(row).windows.isEmpty())
     {
         // Remove the group
         beginRemoveRows(QModelIndex(), row, row);
-        m_items.removeAt(row);
+        removeRow_internal(row);
         endRemoveRows();
     }
+    else
+    {
+        emitWindowsChanged(row);
+    }
 }
 
-void LXQtTaskBarProxyModel::onWindowPropertyChanged(WId windowId, int prop)
+void LXQtTaskBarProxyModel::onWindowPropertyChanged(WId windowId, int props)
 {
-    int row = -1;
-    int windowIdxInGroup = -1;
-    for(int i = 0; i < m_items.count(); i++)
+    auto pos = m_windowPositions.constFind(windowId);
+    if(pos == m_windowPositions.cend())
+        return;
+
+    if (props & windowPropertyFlag(LXQtTaskBarWindowProperty::WindowClass))
     {
-        windowIdxInGroup = m_items.at(i).indexOfWindow(windowId);
-        if(windowIdxInGroup != -1)
-        {
-            row = i;
-            break;
-        }
+        // If window class is changed, window won't be part of same group
+        changeWindowClass(windowId);
+        pos = m_windowPositions.constFind(windowId);
     }
 
-    if(row == -1)
-        return;
-
+    const int row = pos->row;
     LXQtTaskBarProxyModelItem& item = m_items[row];
-    LXQtTaskBarProxyModelWindow& window = item.windows[windowIdxInGroup];
+    LXQtTaskBarProxyModelWindow& window = item.windows[pos->index];
 
-    switch (LXQtTaskBarWindowProperty(prop))
+    QList<int> roles;
+    if (props & windowPropertyFlag(LXQtTaskBarWindowProperty::Title))
     {
-    case LXQtTaskBarWindowProperty::Title:
-        window.title = m_backend->getWindowTitle(window.windowId);
-        break;
+        window.title = m_taskModel->title(window.windowId);
 
-    case LXQtTaskBarWindowProperty::Urgency:
-        window.demandsAttention = m_backend->applicationDemandsAttention(window.windowId);
-        break;
+        // Groups show the class
+        if(item.windows.count() == 1)
+            roles.append(Qt::DisplayRole);
+    }
 
-    case LXQtTaskBarWindowProperty::WindowClass:
+    if (props & windowPropertyFlag(LXQtTaskBarWindowProperty::Urgency))
     {
-        // If window class is changed, window won't be part of same group
-        //TODO: optimize
-        onWindowRemoved(windowId);
-        onWindowAdded(windowId);
+        const bool itemDemandedAttention = item.demandsAttention();
+        window.demandsAttention = m_taskModel->demandsAttention(window.windowId);
+        if(item.demandsAttention() != itemDemandedAttention)
+            roles.append(DemandsAttentionRole);
     }
 
-    default:
-        break;
-    }
+    if (props & windowPropertyFlag(LXQtTaskBarWindowProperty::Icon))
+        roles.append(Qt::DecorationRole);
 
-    const QModelIndex idx = index(row);
-    emit dataChanged(idx, idx, {Qt::DisplayRole, Qt::DecorationRole});
+    if(!roles.isEmpty())
+    {
+        const QModelIndex idx = index(row);
+        emit dataChanged(idx, idx, roles);
+    }
 }
 
-void LXQtTaskBarProxyModel::addWindow_internal(WId windowId)
+void LXQtTaskBarProxyModel::changeWindowClass(WId windowId)
 {
-    LXQtTaskBarProxyModelWindow window;
-    window.windowId = windowId;
-    window.title = m_backend->getWindowTitle(window.windowId);
-    window.demandsAttention = m_backend->applicationDemandsAttention(window.windowId);
+    const QString windowClass = m_taskModel->windowClass(windowId);
+    const WindowPosition pos = m_windowPositions.value(windowId);
+    LXQtTaskBarProxyModelItem& item = m_items[pos.row];
+    if(item.windowClass == windowClass)
+        return;
+
+    if(!m_groupByWindowClass)
+    {
+        // Every window has its own row, just rename it
+        item.windowClass = windowClass;
+        return;
+    }
 
-    QString windowClass = m_backend->getWindowClass(window.windowId);
+    const int targetRow = m_classRows.value(windowClass, -1);
 
-    int row = -1;
-    if(m_groupByWindowClass)
+    if(item.windows.count() == 1)
     {
-        // Find existing group
-        for(int i = 0; i < m_items.count(); i++)
+        if(targetRow == -1)
         {
-            if(m_items.at(i).windowClass == windowClass)
+            // Becomes a new group: keep the row, move it where new groups are added
+            m_classRows.remove(item.windowClass);
+            item.windowClass = windowClass;
+            m_classRows.insert(windowClass, pos.row);
+
+            const int last = m_items.count() - 1;
+            if(pos.row != last)
             {
-                row = i;
-                break;
+                beginMoveRows(QModelIndex(), pos.row, pos.row, QModelIndex(), m_items.count());
+                m_items.move(pos.row, last);
+                reindexRows(pos.row, last);
+                endMoveRows();
             }
+            return;
         }
+
+        // Joins an existing group, its row disappears
+        LXQtTaskBarProxyModelWindow window = takeWindow_internal(windowId);
+        beginRemoveRows(QModelIndex(), pos.row, pos.row);
+        removeRow_internal(pos.row);
+        endRemoveRows();
+        const int row = m_classRows.value(windowClass);
+        insertWindow_internal(window, row);
+        emitWindowsChanged(row);
+        return;
+    }
+
+    // Leaves a group with other windows
+    LXQtTaskBarProxyModelWindow window = takeWindow_internal(windowId);
+    emitWindowsChanged(pos.row);
+
+    if(targetRow == -1)
+    {
+        const int newRow = m_items.count();
+        beginInsertRows(QModelIndex(), newRow, newRow);
+        LXQtTaskBarProxyModelItem newItem;
+        newItem.windowClass = windowClass;
+        m_items.append(newItem);
+        m_classRows.insert(windowClass, newRow);
+        insertWindow_internal(window, newRow);
+        endInsertRows();
+        return;
     }
 
+    insertWindow_internal(window, targetRow);
+    emitWindowsChanged(targetRow);
+}
+
+void LXQtTaskBarProxyModel::emitWindowsChanged(int row)
+{
+    // A group shows the window title only while it has a single window, the
+    // view shows a row as long as one of its windows is shown
+    const QModelIndex idx = index(row);
+    emit dataChanged(idx, idx, {Qt::DisplayRole, Qt::ToolTipRole, WindowCountRole, DemandsAttentionRole});
+}
+
+void LXQtTaskBarProxyModel::addWindow_internal(WId windowId, const QString& windowClass)
+{
+    LXQtTaskBarProxyModelWindow window;
+    window.windowId = windowId;
+    window.title = m_taskModel->title(window.windowId);
+    window.demandsAttention = m_taskModel->demandsAttention(window.windowId);
+
+    int row = m_groupByWindowClass ? m_classRows.value(windowClass, -1) : -1;
     if(row == -1)
     {
         // Create new group
@@ -170,13 +252,77 @@ void LXQtTaskBarProxyModel::addWindow_internal(WId windowId)
         item.windowClass = windowClass;
         m_items.append(item);
         row = m_items.size() - 1;
+        if(m_groupByWindowClass)
+            m_classRows.insert(windowClass, row);
     }
 
     // Add window to group
+    insertWindow_internal(window, row);
+}
+
+void LXQtTaskBarProxyModel::insertWindow_internal(const LXQtTaskBarProxyModelWindow& window, int row)
+{
     LXQtTaskBarProxyModelItem& item = m_items[row];
+    m_windowPositions.insert(window.windowId, {row, int(item.windows.size())});
     item.windows.append(window);
 }
 
+LXQtTaskBarProxyModelWindow LXQtTaskBarProxyModel::takeWindow_internal(WId windowId)
+{
+    const WindowPosition pos = m_windowPositions.take(windowId);
+    LXQtTaskBarProxyModelItem& item = m_items[pos.row];
+    LXQtTaskBarProxyModelWindow window = item.windows.takeAt(pos.index);
+
+    // Following windows of the group move up
+    for(int i = pos.index; i < item.windows.size(); i++)
+        m_windowPositions[item.windows.at(i).windowId].index = i;
+
+    return window;
+}
+
+void LXQtTaskBarProxyModel::removeRow_internal(int row)
+{
+    if(m_groupByWindowClass)
+        m_classRows.remove(m_items.at(row).windowClass);
+    m_items.removeAt(row);
+    reindexRows(row, m_items.count() - 1);
+}
+
+void LXQtTaskBarProxyModel::reindexRows(int first, int last)
+{
+    for(int row = first; row <= last; row++)
+    {
+        const LXQtTaskBarProxyModelItem& item = m_items.at(row);
+        if(m_groupByWindowClass)
+            m_classRows[item.windowClass] = row;
+        for(const LXQtTaskBarProxyModelWindow& window : item.windows)
+            m_windowPositions[window.windowId].row = row;
+    }
+}
+
+void LXQtTaskBarProxyModel::reload_internal()
+{
+    m_items.clear();
+    m_windowPositions.clear();
+    m_classRows.clear();
+
+    if(!m_taskModel)
+        return;
+
+    // Reload current windows
+    const QVector<WId> windows = m_taskModel->windows();
+    m_items.reserve(windows.size());
+    m_windowPositions.reserve(windows.size());
+
+    for(WId windowId : windows)
+    {
+        if(!m_windowPositions.contains(windowId))
+            addWindow_internal(windowId, m_taskModel->windowClass(windowId));
+    }
+
+    m_items.squeeze();
+}
+
 bool LXQtTaskBarProxyModel::groupByWindowClass() const
 {
     return m_groupByWindowClass;
@@ -189,69 +335,40 @@ void LXQtTaskBarProxyModel::setGroupByWindowClass(bool newGroupByWindowClass)
 
     m_groupByWindowClass = newGroupByWindowClass;
 
-    if(m_backend && !m_items.isEmpty())
+    if(m_taskModel && !m_items.isEmpty())
     {
         beginResetModel();
-
-        m_items.clear();
-
-        // Reload current windows
-        const QVector<WId> windows = m_backend->getCurrentWindows();
-        m_items.reserve(windows.size());
-
-        for(WId windowId : windows)
-            onWindowAdded(windowId);
-
-        m_items.squeeze();
-
+        reload_internal();
         endResetModel();
     }
 
 }
 
-ILXQtTaskbarAbstractBackend *LXQtTaskBarProxyModel::backend() const
+LXQtTaskModel *LXQtTaskBarProxyModel::taskModel() const
 {
-    return m_backend;
+    return m_taskModel;
 }
 
-void LXQtTaskBarProxyModel::setBackend(ILXQtTaskbarAbstractBackend *newBackend)
+void LXQtTaskBarProxyModel::setTaskModel(LXQtTaskModel *newTaskModel)
 {
     beginResetModel();
 
-    m_items.clear();
-
-    if(m_backend)
-    {
-        disconnect(m_backend, &ILXQtTaskbarAbstractBackend::windowAdded,
-                   this, &LXQtTaskBarProxyModel::onWindowAdded);
-        disconnect(m_backend, &ILXQtTaskbarAbstractBackend::windowRemoved,
-                   this, &LXQtTaskBarProxyModel::onWindowRemoved);
-        disconnect(m_backend, &ILXQtTaskbarAbstractBackend::windowPropertyChanged,
-                   this, &LXQtTaskBarProxyModel::onWindowPropertyChanged);
-    }
+    if(m_taskModel)
+        disconnect(m_taskModel, nullptr, this, nullptr);
 
-    m_backend = newBackend;
+    m_taskModel = newTaskModel;
 
-    if(m_backend)
+    if(m_taskModel)
     {
-        connect(m_backend, &ILXQtTaskbarAbstractBackend::windowAdded,
+        connect(m_taskModel, &LXQtTaskModel::windowAdded,
                 this, &LXQtTaskBarProxyModel::onWindowAdded);
-        connect(m_backend, &ILXQtTaskbarAbstractBackend::windowRemoved,
+        connect(m_taskModel, &LXQtTaskModel::windowRemoved,
                 this, &LXQtTaskBarProxyModel::onWindowRemoved);
-        connect(m_backend, &ILXQtTaskbarAbstractBackend::windowPropertyChanged,
+        connect(m_taskModel, &LXQtTaskModel::windowChanged,
                 this, &LXQtTaskBarProxyModel::onWindowPropertyChanged);
-
-        // Reload current windows
-        const QVector<WId> windows = m_backend->getCurrentWindows();
-        m_items.reserve(windows.size());
-
-        for(WId windowId : windows)
-            onWindowAdded(windowId);
-
-        m_items.squeeze();
     }
 
-    m_items.squeeze();
+    reload_internal();
 
     endResetModel();
 }
@@ -2,11 +2,12 @@
 #define LXQTTASKBARPROXYMODEL_H
 
 #include <QAbstractListModel>
+#include <QHash>
 #include <QVector>
 
 #include "../panel/backends/lxqttaskbartypes.h"
 
-class ILXQtTaskbarAbstractBackend;
+class LXQtTaskModel;
 
 class LXQtTaskBarProxyModelWindow
 {
@@ -55,6 +56,12 @@ class LXQtTaskBarProxyModel : public QAbstractListModel
     Q_OBJECT
 
 public:
+    enum Roles
+    {
+        WindowCountRole = Qt::UserRole + 1,
+        DemandsAttentionRole
+    };
+
     explicit LXQtTaskBarProxyModel(QObject *parent = nullptr);
 
     // Basic functionality:
@@ -64,8 +71,12 @@ public:
 
     QIcon getWindowIcon(int itemRow, int windowIdxInGroup, int devicePixels) const;
 
-    ILXQtTaskbarAbstractBackend *backend() const;
-    void setBackend(ILXQtTaskbarAbstractBackend *newBackend);
+    WId windowIdAt(int itemRow, int windowIdxInGroup) const;
+    int rowOfWindow(WId windowId) const;
+
+    // Shared with the other taskbars, it provides the windows and their icons
+    LXQtTaskModel *taskModel() const;
+    void setTaskModel(LXQtTaskModel *newTaskModel);
 
     bool groupByWindowClass() const;
     void setGroupByWindowClass(bool newGroupByWindowClass);
@@ -73,27 +84,35 @@ public:
 private slots:
     void onWindowAdded(WId windowId);
     void onWindowRemoved(WId windowId);
-    void onWindowPropertyChanged(WId windowId, int prop);
+    void onWindowPropertyChanged(WId windowId, int props);
 
 private:
-    void addWindow_internal(WId windowId);
+    void changeWindowClass(WId windowId);
+    // Windows of the row added or removed
+    void emitWindowsChanged(int row);
 
-    inline bool hasWindowClass(const QString& windowClass) const
-    {
-        for(const LXQtTaskBarProxyModelItem& item : m_items)
-        {
-            if(item.windowClass == windowClass)
-                return true;
-        }
-
-        return false;
-    }
+    void addWindow_internal(WId windowId, const QString& windowClass);
+    void insertWindow_internal(const LXQtTaskBarProxyModelWindow& window, int row);
+    LXQtTaskBarProxyModelWindow takeWindow_internal(WId windowId);
+    void removeRow_internal(int row);
+    void reindexRows(int first, int last);
+    void reload_internal();
 
 private:
-    ILXQtTaskbarAbstractBackend *m_backend;
+    LXQtTaskModel *m_taskModel;
 
     QVector<LXQtTaskBarProxyModelItem> m_items;
 
+    struct WindowPosition
+    {
+        int row;
+        int index; // in the group
+    };
+
+    // Kept in sync with m_items
+    QHash<WId, WindowPosition> m_windowPositions;
+    QHash<QString, int> m_classRows; // only when grouping by class
+
     bool m_groupByWindowClass;
 };
 
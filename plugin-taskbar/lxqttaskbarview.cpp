@@ -0,0 +1,524 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt.org
+ *
+ * Copyright: 2026 LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "lxqttaskbarview.h"
+#include "lxqttaskbar.h"
+#include "../panel/backends/lxqttaskbariconcache.h"
+#include "lxqttaskbarproxymodel.h"
+
+#include "../panel/ilxqtpanel.h"
+#include "../panel/ilxqtpanelplugin.h"
+#include "../panel/backends/ilxqttaskbarabstractbackend.h"
+
+#include <XdgIcon>
+
+#include <QApplication>
+#include <QContextMenuEvent>
+#include <QMenu>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QStyleOption>
+#include <QWheelEvent>
+
+/************************************************
+
+ ************************************************/
+LXQtTaskBarDelegate::LXQtTaskBarDelegate(LXQtTaskBar *taskBar, QObject *parent)
+    : QStyledItemDelegate(parent),
+    mTaskBar(taskBar),
+    mActiveRow(-1)
+{
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtTaskBarDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    const QWidget *widget = option.widget;
+    QStyle *style = widget ? widget->style() : QApplication::style();
+    const LXQtTaskBarProxyModel *model = static_cast<const LXQtTaskBarProxyModel *>(index.model());
+    const Qt::ToolButtonStyle buttonStyle = mTaskBar->buttonStyle();
+    const int margin = 3;
+
+    // Looks like the auto-raise tool buttons of the widget based taskbar
+    QStyleOptionToolButton opt;
+    opt.rect = option.rect;
+    opt.palette = option.palette;
+    opt.fontMetrics = option.fontMetrics;
+    opt.direction = option.direction;
+    opt.state = QStyle::State_Enabled | QStyle::State_AutoRaise;
+    if (option.state & QStyle::State_MouseOver)
+        opt.state |= QStyle::State_MouseOver | QStyle::State_Raised;
+    const bool active = index.row() == mActiveRow;
+    if (active)
+        opt.state |= QStyle::State_On | QStyle::State_Sunken;
+
+    painter->save();
+    if (index.data(LXQtTaskBarProxyModel::DemandsAttentionRole).toBool())
+    {
+        QColor color = opt.palette.color(QPalette::Highlight);
+        color.setAlpha(128);
+        painter->fillRect(opt.rect, color);
+    }
+    if (opt.state & (QStyle::State_MouseOver | QStyle::State_On))
+        style->drawPrimitive(QStyle::PE_PanelButtonTool, &opt, painter, widget);
+
+    QRect content = opt.rect.adjusted(margin, margin, -margin, -margin);
+    if (buttonStyle != Qt::ToolButtonTextOnly)
+    {
+        const int iconSize = qMin(mTaskBar->panel()->iconSize(), qMin(content.width(), content.height()));
+        const qreal dpr = widget ? widget->devicePixelRatioF() : qApp->devicePixelRatio();
+        QIcon icon = model->getWindowIcon(index.row(), 0, iconSize * dpr);
+        if (icon.isNull())
+            icon = XdgIcon::defaultApplicationIcon();
+
+        const Qt::Alignment align = buttonStyle == Qt::ToolButtonIconOnly ? Qt::AlignCenter : Qt::AlignLeft | Qt::AlignVCenter;
+        const QRect iconRect = QStyle::alignedRect(opt.direction, align, QSize(iconSize, iconSize), content);
+        icon.paint(painter, iconRect);
+
+        if (opt.direction == Qt::RightToLeft)
+            content.setRight(iconRect.left() - margin);
+        else
+            content.setLeft(iconRect.right() + margin);
+    }
+
+    if (buttonStyle != Qt::ToolButtonIconOnly && content.width() > 0)
+    {
+        const QString text = opt.fontMetrics.elidedText(index.data(Qt::DisplayRole).toString(), Qt::ElideRight, content.width());
+        style->drawItemText(painter, content, Qt::AlignLeft | Qt::AlignVCenter, opt.palette, true, text, QPalette::ButtonText);
+    }
+    painter->restore();
+}
+
+/************************************************
+
+ ************************************************/
+QSize LXQtTaskBarDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &/*index*/) const
+{
+    // All the items share the grid size computed by the view
+    if (const QListView *view = qobject_cast<const QListView *>(option.widget))
+        return view->gridSize();
+    const int size = mTaskBar->panel()->iconSize();
+    return QSize(size, size);
+}
+
+/************************************************
+
+ ************************************************/
+LXQtTaskBarView::LXQtTaskBarView(LXQtTaskBar *taskBar)
+    : QListView(taskBar),
+    mTaskBar(taskBar),
+    mBackend(taskBar->getBackend()),
+    mModel(new LXQtTaskBarProxyModel(this)),
+    mDelegate(new LXQtTaskBarDelegate(taskBar, this)),
+    mActiveRow(-1)
+{
+    setObjectName(QStringLiteral("TaskBarView"));
+    setFrameShape(QFrame::NoFrame);
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    setSelectionMode(QAbstractItemView::NoSelection);
+    setEditTriggers(QAbstractItemView::NoEditTriggers);
+    setFocusPolicy(Qt::NoFocus);
+    setMovement(QListView::Static);
+    setResizeMode(QListView::Adjust);
+    setUniformItemSizes(true);
+    setWrapping(true);
+    setMouseTracking(true);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+    setAutoFillBackground(false);
+    viewport()->setAutoFillBackground(false);
+    viewport()->setAttribute(Qt::WA_Hover);
+
+    mModel->setGroupByWindowClass(mTaskBar->isGroupingEnabled());
+    mModel->setTaskModel(mTaskBar->taskModel());
+    setModel(mModel);
+    setItemDelegate(mDelegate);
+
+    connect(mModel, &QAbstractItemModel::rowsInserted, this, [this] (const QModelIndex &, int first, int last) {
+        for (int row = first; row <= last; ++row)
+            refreshRowVisibility(row);
+        onActiveWindowChanged(mBackend->getActiveWindow());
+        updateGridSize();
+    });
+    connect(mModel, &QAbstractItemModel::rowsRemoved, this, [this] {
+        onActiveWindowChanged(mBackend->getActiveWindow());
+        updateGridSize();
+    });
+    connect(mModel, &QAbstractItemModel::rowsMoved, this, [this] {
+        onActiveWindowChanged(mBackend->getActiveWindow());
+    });
+    connect(mModel, &QAbstractItemModel::dataChanged, this, [this] (const QModelIndex &topLeft, const QModelIndex &bottomRight, const QList<int> &roles) {
+        // windows joined or left these rows (a new window, a removed one, or
+        // a window moved to another group when its class changed)
+        if (!roles.isEmpty() && !roles.contains(LXQtTaskBarProxyModel::WindowCountRole))
+            return;
+        refreshRowsVisibility(topLeft.row(), bottomRight.row());
+        onActiveWindowChanged(mBackend->getActiveWindow());
+    });
+    connect(mModel, &QAbstractItemModel::modelReset, this, &LXQtTaskBarView::refreshVisibility);
+
+    connect(mBackend, &ILXQtTaskbarAbstractBackend::activeWindowChanged, this, &LXQtTaskBarView::onActiveWindowChanged);
+    connect(mTaskBar->taskModel(), &LXQtTaskModel::windowChanged, this, &LXQtTaskBarView::onWindowPropertiesChanged);
+    connect(mBackend, &ILXQtTaskbarAbstractBackend::currentWorkspaceChanged, this, &LXQtTaskBarView::refreshVisibility);
+    connect(mTaskBar, &LXQtTaskBar::showOnlySettingChanged, this, &LXQtTaskBarView::refreshVisibility);
+    connect(mTaskBar, &LXQtTaskBar::refreshIconGeometry, this, &LXQtTaskBarView::refreshIconsGeometry);
+    connect(mTaskBar->iconCache(), &LXQtTaskBarIconCache::iconChanged, this, &LXQtTaskBarView::onIconChanged);
+
+    refreshVisibility();
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtTaskBarView::realign()
+{
+    const bool iconOnly = mTaskBar->buttonStyle() == Qt::ToolButtonIconOnly;
+    // vertical panel with text: a single column
+    setFlow(!mTaskBar->panel()->isHorizontal() && !iconOnly ? QListView::TopToBottom : QListView::LeftToRight);
+    updateGridSize();
+    viewport()->update();
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtTaskBarView::settingsChanged()
+{
+    mModel->setGroupByWindowClass(mTaskBar->isGroupingEnabled());
+    realign();
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtTaskBarView::mousePressEvent(QMouseEvent *event)
+{
+    // no selection, no drag: the base class is not involved
+    const QModelIndex idx = indexAt(event->pos());
+    if (idx.isValid() && event->button() == Qt::MiddleButton && mTaskBar->closeOnMiddleClick()
+        && idx.data(LXQtTaskBarProxyModel::WindowCountRole).toInt() == 1)
+    {
+        mBackend->closeWindow(mModel->windowIdAt(idx.row(), 0));
+    }
+    event->accept();
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtTaskBarView::mouseReleaseEvent(QMouseEvent *event)
+{
+    const QModelIndex idx = indexAt(event->pos());
+    if (idx.isValid() && event->button() == Qt::LeftButton)
+    {
+        if (idx.data(LXQtTaskBarProxyModel::WindowCountRole).toInt() == 1)
+        {
+            const WId window = mModel->windowIdAt(idx.row(), 0);
+            if (mBackend->isWindowActive(window))
+                mBackend->setWindowState(window, LXQtTaskBarWindowState::Minimized, true);
+            else
+                activateWindow(window);
+        }
+        else
+        {
+            showWindowsMenu(idx.row(), event->globalPosition().toPoint());
+        }
+    }
+    event->accept();
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtTaskBarView::wheelEvent(QWheelEvent *event)
+{
+    // all the items are always shown, never scroll
+    event->accept();
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtTaskBarView::contextMenuEvent(QContextMenuEvent *event)
+{
+    const QModelIndex idx = indexAt(event->pos());
+    if (!idx.isValid())
+    {
+        event->ignore();
+        return;
+    }
+
+    const int row = idx.row();
+    const int count = idx.data(LXQtTaskBarProxyModel::WindowCountRole).toInt();
+
+    QMenu *menu = new QMenu(this);
+    menu->setAttribute(Qt::WA_DeleteOnClose);
+    if (count == 1)
+    {
+        const WId window = mModel->windowIdAt(row, 0);
+        if (mBackend->getWindowState(window) == LXQtTaskBarWindowState::Minimized)
+        {
+            connect(menu->addAction(tr("&Restore")), &QAction::triggered, this, [this, window] {
+                activateWindow(window);
+            });
+        }
+        else
+        {
+            connect(menu->addAction(tr("Mi&nimize")), &QAction::triggered, this, [this, window] {
+                mBackend->setWindowState(window, LXQtTaskBarWindowState::Minimized, true);
+            });
+        }
+        menu->addSeparator();
+        connect(menu->addAction(XdgIcon::fromTheme(QStringLiteral("process-stop")), tr("&Close")), &QAction::triggered, this, [this, window] {
+            mBackend->closeWindow(window);
+        });
+    }
+    else
+    {
+        QList<WId> windows;
+        for (int i = 0; i < count; ++i)
+            windows.append(mModel->windowIdAt(row, i));
+        connect(menu->addAction(XdgIcon::fromTheme(QStringLiteral("process-stop")), tr("Close group")), &QAction::triggered, this, [this, windows] {
+            for (const WId window : windows)
+                mBackend->closeWindow(window);
+        });
+    }
+
+    ILXQtPanelPlugin *plugin = mTaskBar->plugin();
+    menu->setGeometry(plugin->panel()->calculatePopupWindowPos(event->globalPos(), menu->sizeHint()));
+    plugin->willShowWindow(menu);
+    menu->show();
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtTaskBarView::resizeEvent(QResizeEvent *event)
+{
+    QListView::resizeEvent(event);
+    updateGridSize();
+    refreshIconsGeometry();
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtTaskBarView::onActiveWindowChanged(WId window)
+{
+    const int row = mModel->rowOfWindow(window);
+    if (row == mActiveRow)
+        return;
+
+    const int oldRow = mActiveRow;
+    mActiveRow = row;
+    mDelegate->setActiveRow(row);
+    updateRow(oldRow);
+    updateRow(row);
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtTaskBarView::onWindowPropertiesChanged(WId window, int props)
+{
+    const int visibilityProps = windowPropertyFlag(LXQtTaskBarWindowProperty::Workspace)
+                                | windowPropertyFlag(LXQtTaskBarWindowProperty::State)
+                                | windowPropertyFlag(LXQtTaskBarWindowProperty::Geometry);
+    if (!(props & visibilityProps))
+        return;
+
+    const int row = mModel->rowOfWindow(window);
+    if (row != -1)
+        refreshRowsVisibility(row, row);
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtTaskBarView::onIconChanged(WId window)
+{
+    updateRow(mModel->rowOfWindow(window));
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtTaskBarView::refreshVisibility()
+{
+    const int rows = mModel->rowCount();
+    for (int row = 0; row < rows; ++row)
+        refreshRowVisibility(row);
+    onActiveWindowChanged(mBackend->getActiveWindow());
+    updateGridSize();
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtTaskBarView::refreshIconsGeometry()
+{
+    const int rows = mModel->rowCount();
+    for (int row = 0; row < rows; ++row)
+    {
+        if (isRowHidden(row))
+            continue;
+
+        const QModelIndex idx = mModel->index(row);
+        const QRect rect = visualRect(idx);
+        const QRect globalRect(viewport()->mapToGlobal(rect.topLeft()), rect.size());
+        const int count = idx.data(LXQtTaskBarProxyModel::WindowCountRole).toInt();
+        for (int i = 0; i < count; ++i)
+            mBackend->refreshIconGeometry(mModel->windowIdAt(row, i), globalRect);
+    }
+}
+
+/************************************************
+
+ ************************************************/
+bool LXQtTaskBarView::isWindowShown(WId window) const
+{
+    // same rules as LXQtTaskGroup::refreshVisibility()
+    return mTaskBar->taskModel()->matches(window, mTaskBar->windowFilter());
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtTaskBarView::refreshRowVisibility(int row)
+{
+    const int count = mModel->index(row).data(LXQtTaskBarProxyModel::WindowCountRole).toInt();
+    bool visible = false;
+    for (int i = 0; i < count && !visible; ++i)
+        visible = isWindowShown(mModel->windowIdAt(row, i));
+    setRowHidden(row, !visible);
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtTaskBarView::refreshRowsVisibility(int first, int last)
+{
+    bool changed = false;
+    for (int row = first; row <= last; ++row)
+    {
+        const bool wasHidden = isRowHidden(row);
+        refreshRowVisibility(row);
+        changed = changed || wasHidden != isRowHidden(row);
+    }
+    if (changed)
+        updateGridSize();
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtTaskBarView::updateRow(int row)
+{
+    if (row >= 0 && row < mModel->rowCount())
+        update(mModel->index(row));
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtTaskBarView::updateGridSize()
+{
+    ILXQtPanel *panel = mTaskBar->panel();
+    const int lines = qMax(1, panel->lineCount());
+    const QSize area = viewport()->size();
+    const bool iconOnly = mTaskBar->buttonStyle() == Qt::ToolButtonIconOnly;
+
+    int count = 0;
+    const int rows = mModel->rowCount();
+    for (int row = 0; row < rows; ++row)
+    {
+        if (!isRowHidden(row))
+            ++count;
+    }
+    const int perLine = qMax(1, (count + lines - 1) / lines);
+
+    // Like the widget buttons: limited by the configured size,
+    // shrunk to show all the windows
+    QSize grid;
+    if (panel->isHorizontal())
+    {
+        grid.setHeight(qMax(1, area.height() / lines));
+        grid.setWidth(qBound(1, area.width() / perLine, iconOnly ? grid.height() : mTaskBar->buttonWidth()));
+    }
+    else if (iconOnly)
+    {
+        grid.setWidth(qMax(1, area.width() / lines));
+        grid.setHeight(qBound(1, area.height() / perLine, grid.width()));
+    }
+    else
+    {
+        const int buttonHeight = qMax(panel->iconSize(), fontMetrics().height()) + 6;
+        grid.setWidth(qMax(1, area.width()));
+        grid.setHeight(qBound(1, area.height() / qMax(1, count), qMin(buttonHeight, mTaskBar->buttonHeight())));
+    }
+
+    if (grid != gridSize())
+        setGridSize(grid);
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtTaskBarView::showWindowsMenu(int row, const QPoint &globalPos)
+{
+    const int count = mModel->index(row).data(LXQtTaskBarProxyModel::WindowCountRole).toInt();
+    const int devicePixels = mTaskBar->panel()->iconSize() * devicePixelRatioF();
+
+    // Only the windows of this group get a menu entry, and only while it's shown
+    QMenu *menu = new QMenu(this);
+    menu->setAttribute(Qt::WA_DeleteOnClose);
+    for (int i = 0; i < count; ++i)
+    {
+        const WId window = mModel->windowIdAt(row, i);
+        if (!isWindowShown(window))
+            continue;
+        QAction *a = menu->addAction(mModel->getWindowIcon(row, i, devicePixels), mTaskBar->taskModel()->title(window));
+        a->setCheckable(true);
+        a->setChecked(mBackend->isWindowActive(window));
+        connect(a, &QAction::triggered, this, [this, window] {
+            activateWindow(window);
+        });
+    }
+
+    ILXQtPanelPlugin *plugin = mTaskBar->plugin();
+    menu->setGeometry(plugin->panel()->calculatePopupWindowPos(globalPos, menu->sizeHint()));
+    plugin->willShowWindow(menu);
+    menu->show();
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtTaskBarView::activateWindow(WId window)
+{
+    mBackend->raiseWindow(window, mTaskBar->raiseOnCurrentDesktop());
+}
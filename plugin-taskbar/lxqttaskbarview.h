@@ -0,0 +1,106 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt.org
+ *
+ * Copyright: 2026 LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#ifndef LXQTTASKBARVIEW_H
+#define LXQTTASKBARVIEW_H
+
+#include <QListView>
+#include <QStyledItemDelegate>
+
+#include "../panel/backends/lxqttaskbartypes.h"
+
+class LXQtTaskBar;
+class LXQtTaskBarProxyModel;
+class ILXQtTaskbarAbstractBackend;
+
+/*!
+ * \brief Paints the rows of the LXQtTaskBarView like flat tool buttons:
+ * icon and elided title, highlighted when active or demanding attention.
+ */
+class LXQtTaskBarDelegate : public QStyledItemDelegate
+{
+public:
+    explicit LXQtTaskBarDelegate(LXQtTaskBar *taskBar, QObject *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+    void setActiveRow(int row) { mActiveRow = row; }
+
+private:
+    LXQtTaskBar *mTaskBar;
+    int mActiveRow;
+};
+
+/*!
+ * \brief Lightweight alternative to the LXQtTaskGroup/LXQtTaskButton widgets.
+ *
+ * A single view over LXQtTaskBarProxyModel: the windows (or groups of windows)
+ * are painted by LXQtTaskBarDelegate, so no widget is created per window and
+ * only the visible rows are laid out and painted. The windows of a group are
+ * listed in a menu on click. Enabled with the "lightweightView" setting.
+ */
+class LXQtTaskBarView : public QListView
+{
+    Q_OBJECT
+
+public:
+    explicit LXQtTaskBarView(LXQtTaskBar *taskBar);
+
+    void realign();
+    void settingsChanged();
+
+protected:
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void contextMenuEvent(QContextMenuEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private slots:
+    void onActiveWindowChanged(WId window);
+    void onWindowPropertiesChanged(WId window, int props);
+    void onIconChanged(WId window);
+    void refreshVisibility();
+    void refreshIconsGeometry();
+
+private:
+    bool isWindowShown(WId window) const;
+    void refreshRowVisibility(int row);
+    void refreshRowsVisibility(int first, int last);
+    void updateRow(int row);
+    void updateGridSize();
+    void showWindowsMenu(int row, const QPoint &globalPos);
+    void activateWindow(WId window);
+
+private:
+    LXQtTaskBar *mTaskBar;
+    ILXQtTaskbarAbstractBackend *mBackend;
+    LXQtTaskBarProxyModel *mModel;
+    LXQtTaskBarDelegate *mDelegate;
+    int mActiveRow;
+};
+
+#endif // LXQTTASKBARVIEW_H
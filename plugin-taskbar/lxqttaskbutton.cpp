@@ -29,6 +29,7 @@
 
 #include "lxqttaskbutton.h"
 #include "lxqttaskbar.h"
+#include "../panel/backends/lxqttaskbariconcache.h"
 
 #include "../panel/ilxqtpanelplugin.h"
 
@@ -49,6 +50,9 @@
 #include <QStylePainter>
 #include <QStyleOptionToolButton>
 #include <QScreen>
+#include <QImage>
+
+#include <utility>
 
 #include "../panel/backends/ilxqttaskbarabstractbackend.h"
 
@@ -65,9 +69,14 @@ void LeftAlignedTextStyle::drawItemText(QPainter * painter, const QRect & rect,
 {
     QString txt = text;
     // get the button text because the text that's given to this function may be middle-elided
-    if (const QToolButton *tb = dynamic_cast<const QToolButton*>(painter->device()))
-        txt = tb->text();
-    txt = QFontMetrics(painter->font()).elidedText(txt, Qt::ElideRight, rect.width());
+    if (const LXQtTaskButton *button = dynamic_cast<const LXQtTaskButton*>(painter->device()))
+        txt = button->elidedText(painter->font(), rect.width(), Qt::ElideRight);
+    else
+    {
+        if (const QToolButton *tb = dynamic_cast<const QToolButton*>(painter->device()))
+            txt = tb->text();
+        txt = QFontMetrics(painter->font()).elidedText(txt, Qt::ElideRight, rect.width());
+    }
     QProxyStyle::drawItemText(painter, rect, (flags & ~Qt::AlignHCenter) | Qt::AlignLeft, pal, enabled, txt, textRole);
 }
 
@@ -86,7 +95,12 @@ LXQtTaskButton::LXQtTaskButton(const WId window, LXQtTaskBar * taskbar, QWidget
     mIconSize(mPlugin->panel()->iconSize()),
     mWheelDelta(0),
     mDNDTimer(new QTimer(this)),
-    mWheelTimer(new QTimer(this))
+    mWheelTimer(new QTimer(this)),
+    mPendingUpdates(0),
+    mUpdateTimer(new QTimer(this)),
+    mElidedWidth(-1),
+    mElidedMode(Qt::ElideNone),
+    mThumbnailVisible(false)
 {
     Q_ASSERT(taskbar);
 
@@ -111,7 +125,10 @@ LXQtTaskButton::LXQtTaskButton(const WId window, LXQtTaskBar * taskbar, QWidget
         mWheelDelta = 0; // forget previous wheel deltas
     });
 
-    setUrgencyHint(mBackend->applicationDemandsAttention(mWindow));
+    mUpdateTimer->setSingleShot(true);
+    connect(mUpdateTimer, &QTimer::timeout, this, &LXQtTaskButton::applyPendingUpdates);
+
+    setUrgencyHint(mParentTaskBar->taskModel()->demandsAttention(mWindow));
 
     connect(LXQt::Settings::globalSettings(), &LXQt::GlobalSettings::iconThemeChanged, this, &LXQtTaskButton::updateIcon);
     connect(mParentTaskBar,                   &LXQtTaskBar::iconByClassChanged,        this, &LXQtTaskButton::updateIcon);
@@ -120,14 +137,17 @@ LXQtTaskButton::LXQtTaskButton(const WId window, LXQtTaskBar * taskbar, QWidget
 /************************************************
 
 ************************************************/
-LXQtTaskButton::~LXQtTaskButton() = default;
+LXQtTaskButton::~LXQtTaskButton()
+{
+    setThumbnailVisible(false);
+}
 
 /************************************************
 
  ************************************************/
 void LXQtTaskButton::updateText()
 {
-    QString title = mBackend->getWindowTitle(mWindow);
+    QString title = mParentTaskBar->taskModel()->title(mWindow);
     setText(title.replace(QStringLiteral("&"), QStringLiteral("&&")));
     setToolTip(title);
 }
@@ -135,18 +155,101 @@ void LXQtTaskButton::updateText()
 /************************************************
 
  ************************************************/
-void LXQtTaskButton::updateIcon()
+void LXQtTaskButton::scheduleUpdate(int updates)
+{
+    if (mUpdateTimer->isActive())
+    {
+        mPendingUpdates |= updates;
+        return;
+    }
+
+    mPendingUpdates = updates;
+    applyPendingUpdates();
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtTaskButton::applyPendingUpdates()
 {
-    QIcon ico;
-    if (mParentTaskBar->isIconByClass())
+    // nothing changed during the last interval, the next change is applied at once
+    if (mPendingUpdates == 0)
+        return;
+
+    const int updates = std::exchange(mPendingUpdates, 0);
+    if (updates & TextUpdate)
+        updateText();
+    if (updates & IconUpdate)
+        updateIcon();
+
+    mUpdateTimer->start(mParentTaskBar->updateInterval());
+}
+
+/************************************************
+
+ ************************************************/
+QString LXQtTaskButton::elidedText(const QFont &font, int width, Qt::TextElideMode mode) const
+{
+    const QString txt = text();
+    if (width != mElidedWidth || mode != mElidedMode || txt != mElidedSource || font != mElidedFont)
+    {
+        mElidedSource = txt;
+        mElidedFont = font;
+        mElidedWidth = width;
+        mElidedMode = mode;
+        mElidedText = QFontMetrics(font).elidedText(txt, mode, width);
+    }
+    return mElidedText;
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtTaskButton::setThumbnailVisible(bool visible)
+{
+    if (visible == mThumbnailVisible)
+        return;
+    mThumbnailVisible = visible;
+
+    if (visible)
     {
-        ico = XdgIcon::fromTheme(mBackend->getWindowClass(mWindow).toLower());
+        mThumbnailConnection = connect(mBackend, &ILXQtTaskbarAbstractBackend::windowThumbnailChanged, this, [this] (WId window) {
+            if (window == mWindow)
+                updateThumbnail();
+        });
+        // windowThumbnailChanged() follows soon
+        mBackend->watchWindowThumbnail(mWindow, true);
+        update();
     }
-    if (ico.isNull())
+    else
     {
-        int devicePixels = mIconSize * devicePixelRatioF();
-        ico = mBackend->getApplicationIcon(mWindow, devicePixels);
+        disconnect(mThumbnailConnection);
+        mBackend->watchWindowThumbnail(mWindow, false);
+        mThumbnail = QPixmap();
+        update();
     }
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtTaskButton::updateThumbnail()
+{
+    const qreal dpr = devicePixelRatioF();
+    const QImage image = mBackend->getWindowThumbnail(mWindow, mParentTaskBar->thumbnailSize() * dpr);
+    mThumbnail = QPixmap::fromImage(image);
+    mThumbnail.setDevicePixelRatio(dpr);
+    update();
+}
+
+/************************************************
+
+ ************************************************/
+void LXQtTaskButton::updateIcon()
+{
+    // shared with the other buttons of the window, decoded off the GUI thread
+    int devicePixels = mIconSize * devicePixelRatioF();
+    QIcon ico = mParentTaskBar->iconCache()->windowIcon(mWindow, devicePixels, mParentTaskBar->isIconByClass());
     setIcon(ico.isNull() ? XdgIcon::defaultApplicationIcon() : ico);
 }
 
@@ -713,7 +816,7 @@ void LXQtTaskButton::setUrgencyHint(bool set)
  ************************************************/
 bool LXQtTaskButton::isOnDesktop(int desktop) const
 {
-    return mBackend->getWindowWorkspace(mWindow) == desktop;
+    return mParentTaskBar->taskModel()->workspace(mWindow) == desktop;
 }
 
 bool LXQtTaskButton::isOnCurrentScreen() const
@@ -724,7 +827,7 @@ bool LXQtTaskButton::isOnCurrentScreen() const
 
 bool LXQtTaskButton::isMinimized() const
 {
-    return mBackend->getWindowState(mWindow) == LXQtTaskBarWindowState::Minimized;
+    return mParentTaskBar->taskModel()->isMinimized(mWindow);
 }
 
 Qt::Corner LXQtTaskButton::origin() const
@@ -767,6 +870,12 @@ void LXQtTaskButton::setAutoRotation(bool value, ILXQtPanel::Position position)
 
 void LXQtTaskButton::paintEvent(QPaintEvent *event)
 {
+    if (mThumbnailVisible)
+    {
+        paintWithThumbnail();
+        return;
+    }
+
     if (mOrigin == Qt::TopLeftCorner)
     {
         QToolButton::paintEvent(event);
@@ -809,6 +918,41 @@ void LXQtTaskButton::paintEvent(QPaintEvent *event)
     painter.drawComplexControl(QStyle::CC_ToolButton, opt);
 }
 
+/************************************************
+
+ ************************************************/
+void LXQtTaskButton::paintWithThumbnail()
+{
+    QStylePainter painter(this);
+    QStyleOptionToolButton opt;
+    initStyleOption(&opt);
+
+    // the frame covers the whole button, the title stays on top of the thumbnail
+    QStyleOptionToolButton frameOpt(opt);
+    frameOpt.text.clear();
+    frameOpt.icon = QIcon();
+    painter.drawComplexControl(QStyle::CC_ToolButton, frameOpt);
+
+    const int fw = style()->pixelMetric(QStyle::PM_DefaultFrameWidth, &opt, this);
+    const int thumbnailHeight = mParentTaskBar->thumbnailSize().height();
+    const QRect contents = rect().adjusted(fw, fw, -fw, -fw);
+    opt.rect = contents;
+    opt.rect.setBottom(contents.bottom() - thumbnailHeight);
+    painter.drawControl(QStyle::CE_ToolButtonLabel, opt);
+
+    if (mThumbnail.isNull())
+        return;
+
+    QRect area = contents;
+    area.setTop(opt.rect.bottom() + 1);
+    QSize size = mThumbnail.deviceIndependentSize().toSize();
+    if (size.width() > area.width() || size.height() > area.height())
+        size.scale(area.size(), Qt::KeepAspectRatio);
+    QRect target(QPoint(0, 0), size);
+    target.moveCenter(area.center());
+    painter.drawPixmap(target, mThumbnail);
+}
+
 bool LXQtTaskButton::hasDragAndDropHover() const
 {
     return mDNDTimer->isActive();
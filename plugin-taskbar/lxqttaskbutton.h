@@ -33,6 +33,7 @@
 
 #include <QToolButton>
 #include <QProxyStyle>
+#include <QPixmap>
 
 #include "../panel/ilxqtpanel.h"
 
@@ -61,6 +62,12 @@ class LXQtTaskButton : public QToolButton
     Q_PROPERTY(Qt::Corner origin READ origin WRITE setOrigin)
 
 public:
+    enum PendingUpdate
+    {
+        TextUpdate = 0x1,
+        IconUpdate = 0x2
+    };
+
     explicit LXQtTaskButton(const WId window, LXQtTaskBar * taskBar, QWidget *parent = nullptr);
     virtual ~LXQtTaskButton();
 
@@ -76,6 +83,26 @@ public:
     bool isMinimized() const;
     void updateText();
 
+    /*! \brief Rate-limited updateText()/updateIcon().
+     * The first change is applied at once, the following ones are merged and
+     * applied at most once per LXQtTaskBar::updateInterval(), so that windows
+     * rewriting their title many times per second don't repaint the button
+     * (and possibly relayout the panel) for every change.
+     * \param updates PendingUpdate flags
+     */
+    void scheduleUpdate(int updates);
+
+    /*! \brief Returns text() elided to fit \p width.
+     * The result is cached until the text, the width or the font change.
+     */
+    QString elidedText(const QFont &font, int width, Qt::TextElideMode mode) const;
+
+    /*! \brief Shows a live thumbnail of the window below the title.
+     * The window is captured only while the thumbnail is visible.
+     */
+    void setThumbnailVisible(bool visible);
+    bool isThumbnailVisible() const { return mThumbnailVisible; }
+
     Qt::Corner origin() const;
     virtual void setAutoRotation(bool value, ILXQtPanel::Position position);
 
@@ -129,6 +156,10 @@ protected:
 private:
     void moveApplicationToPrevNextDesktop(bool next);
     void moveApplicationToPrevNextMonitor(bool next);
+    void applyPendingUpdates();
+    void updateThumbnail();
+    void paintWithThumbnail();
+
     WId mWindow;
     bool mUrgencyHint;
     QPoint mDragStartPosition;
@@ -145,6 +176,21 @@ private:
     // Timer for distinguishing between separate mouse wheel rotations
     QTimer * mWheelTimer;
 
+    // Title/icon changes merged by scheduleUpdate()
+    int mPendingUpdates;
+    QTimer * mUpdateTimer;
+
+    // Cache of elidedText()
+    mutable QString mElidedSource;
+    mutable QString mElidedText;
+    mutable QFont mElidedFont;
+    mutable int mElidedWidth;
+    mutable Qt::TextElideMode mElidedMode;
+
+    bool mThumbnailVisible;
+    QPixmap mThumbnail;
+    QMetaObject::Connection mThumbnailConnection;
+
 signals:
     void dropped(QObject * dragSource, QPoint const & pos);
     void dragging(QObject * dragSource, QPoint const & pos);
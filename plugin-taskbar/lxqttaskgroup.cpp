@@ -47,9 +47,10 @@
 /************************************************
 
  ************************************************/
-LXQtTaskGroup::LXQtTaskGroup(const QString &groupName, WId window, LXQtTaskBar *parent)
+LXQtTaskGroup::LXQtTaskGroup(const QString &groupName, const QString &windowClass, WId window, LXQtTaskBar *parent)
     : LXQtTaskButton(window, parent, parent),
     mGroupName(groupName),
+    mWindowClass(windowClass),
     mPopup(new LXQtGroupPopup(this)),
     mPreventPopup(false),
     mSingleButton(true)
@@ -383,12 +384,11 @@ void LXQtTaskGroup::refreshVisibility()
 {
     bool will = false;
     LXQtTaskBar const * taskbar = parentTaskBar();
-    const int showDesktop = taskbar->showDesktopNum();
+    const LXQtTaskModel *model = taskbar->taskModel();
+    const LXQtTaskModel::Filter filter = taskbar->windowFilter();
     for(LXQtTaskButton * btn : std::as_const(mButtonHash))
     {
-        bool visible = taskbar->isShowOnlyOneDesktopTasks() ? btn->isOnDesktop(0 == showDesktop ? mBackend->getCurrentWorkspace() : showDesktop) : true;
-        visible &= taskbar->isShowOnlyCurrentScreenTasks() ? btn->isOnCurrentScreen() : true;
-        visible &= taskbar->isShowOnlyMinimizedTasks() ? btn->isMinimized() : true;
+        bool visible = model->matches(btn->windowId(), filter);
         btn->setVisible(visible);
         will |= visible;
     }
@@ -483,6 +483,8 @@ int LXQtTaskGroup::recalculateFrameHeight() const
 {
     int cont = visibleButtonsCount();
     int h = !plugin()->panel()->isHorizontal() && parentTaskBar()->isAutoRotate() ? width() : height();
+    if (mPopup->showsThumbnails())
+        h += parentTaskBar()->thumbnailSize().height();
     return cont * h + (cont + 1) * mPopup->spacing();
 }
 
@@ -496,7 +498,10 @@ int LXQtTaskGroup::recalculateFrameWidth() const
     int txtWidth = 0;
     for (LXQtTaskButton *btn : std::as_const(mButtonHash))
         txtWidth = qMax(fm.horizontalAdvance(btn->text()), txtWidth);
-    return iconSize().width() + qMin(txtWidth, max) + 30/* give enough room to margins and borders*/;
+    int contentsWidth = iconSize().width() + qMin(txtWidth, max);
+    if (mPopup->showsThumbnails())
+        contentsWidth = qMax(contentsWidth, parentTaskBar()->thumbnailSize().width());
+    return contentsWidth + 30/* give enough room to margins and borders*/;
 }
 
 /************************************************
@@ -616,7 +621,7 @@ void LXQtTaskGroup::wheelEvent(QWheelEvent* event)
 /************************************************
 
  ************************************************/
-bool LXQtTaskGroup::onWindowChanged(WId window, LXQtTaskBarWindowProperty prop)
+bool LXQtTaskGroup::onWindowChanged(WId window, int props)
 {
     // Returns true if the class is preserved
 
@@ -632,16 +637,16 @@ bool LXQtTaskGroup::onWindowChanged(WId window, LXQtTaskBarWindowProperty prop)
     if (!buttons.isEmpty())
     {
         // if class is changed the window won't belong to our group any more
-        if (parentTaskBar()->isGroupingEnabled() && prop == LXQtTaskBarWindowProperty::WindowClass)
+        if (parentTaskBar()->isGroupingEnabled() && (props & windowPropertyFlag(LXQtTaskBarWindowProperty::WindowClass)))
         {
-            if (mBackend->getWindowClass(windowId()) != mGroupName)
+            if (parentTaskBar()->taskModel()->windowClass(window) != mGroupName)
             {
                 onWindowRemoved(window);
                 return false;
             }
         }
         // window changed virtual desktop
-        if (prop == LXQtTaskBarWindowProperty::Workspace)
+        if (props & windowPropertyFlag(LXQtTaskBarWindowProperty::Workspace))
         {
             if (parentTaskBar()->isShowOnlyOneDesktopTasks()
                 || parentTaskBar()->isShowOnlyCurrentScreenTasks())
@@ -650,27 +655,32 @@ bool LXQtTaskGroup::onWindowChanged(WId window, LXQtTaskBarWindowProperty prop)
             }
         }
 
-        if (prop == LXQtTaskBarWindowProperty::Title)
-            std::for_each(buttons.begin(), buttons.end(), std::mem_fn(&LXQtTaskButton::updateText));
+        // Title and icon changes can come in bursts, they are rate-limited by the buttons
+        int updates = 0;
+        if (props & windowPropertyFlag(LXQtTaskBarWindowProperty::Title))
+            updates |= LXQtTaskButton::TextUpdate;
 
         // XXX: we are setting window icon geometry -> don't need to handle NET::WMIconGeometry
         // Icon of the button can be based on windowClass
-        if (prop == LXQtTaskBarWindowProperty::Icon)
-            std::for_each(buttons.begin(), buttons.end(), std::mem_fn(&LXQtTaskButton::updateIcon));
+        if (props & windowPropertyFlag(LXQtTaskBarWindowProperty::Icon))
+            updates |= LXQtTaskButton::IconUpdate;
+
+        if (updates != 0)
+            std::for_each(buttons.begin(), buttons.end(), std::bind(&LXQtTaskButton::scheduleUpdate, std::placeholders::_1, updates));
 
         bool set_urgency = false;
         bool urgency = false;
 
-        if (prop == LXQtTaskBarWindowProperty::Urgency)
+        if (props & windowPropertyFlag(LXQtTaskBarWindowProperty::Urgency))
         {
             set_urgency = true;
             //FIXME: original code here did not consider "demand attention", was it intentional?
-            urgency = mBackend->applicationDemandsAttention(window);
+            urgency = parentTaskBar()->taskModel()->demandsAttention(window);
         }
-        if (prop == LXQtTaskBarWindowProperty::State)
+        if (props & windowPropertyFlag(LXQtTaskBarWindowProperty::State))
         {
             if (!set_urgency)
-                urgency = mBackend->applicationDemandsAttention(window);
+                urgency = parentTaskBar()->taskModel()->demandsAttention(window);
             std::for_each(buttons.begin(), buttons.end(), std::bind(&LXQtTaskButton::setUrgencyHint, std::placeholders::_1, urgency));
             set_urgency = false;
 
@@ -46,9 +46,12 @@ class LXQtTaskGroup: public LXQtTaskButton
     Q_OBJECT
 
 public:
-    LXQtTaskGroup(const QString & groupName, WId window, LXQtTaskBar * parent);
+    LXQtTaskGroup(const QString & groupName, const QString & windowClass, WId window, LXQtTaskBar * parent);
 
     QString groupName() const { return mGroupName; }
+    // Class of the windows, the same as groupName() unless grouping is disabled
+    QString windowClass() const { return mWindowClass; }
+    void setWindowClass(const QString & windowClass) { mWindowClass = windowClass; }
 
     int buttonsCount() const;
     int visibleButtonsCount() const;
@@ -60,7 +63,8 @@ public:
     // if circular is true, then it will go around the list of buttons
     LXQtTaskButton * getNextPrevChildButton(bool next, bool circular);
 
-    bool onWindowChanged(WId window, LXQtTaskBarWindowProperty prop);
+    // props is a mask of windowPropertyFlag()
+    bool onWindowChanged(WId window, int props);
 
     void setAutoRotation(bool value, ILXQtPanel::Position position);
     Qt::ToolButtonStyle popupButtonStyle() const;
@@ -105,6 +109,7 @@ signals:
 
 private:
     QString mGroupName;
+    QString mWindowClass;
     LXQtGroupPopup * mPopup;
     LXQtTaskButtonHash mButtonHash;
     bool mPreventPopup;
@@ -154,7 +154,7 @@ void LXQtVolume::setAudioEngine(AudioEngine *engine)
             disconnect(m_defaultSink, nullptr, this, nullptr);
             m_defaultSink = nullptr;
         }
-        m_volumeButton->volumePopup()->setDevice(m_defaultSink);
+        m_volumeButton->setDevice(m_defaultSink);
 
         disconnect(m_engine, nullptr, nullptr, nullptr);
         delete m_engine;
@@ -199,7 +199,7 @@ void LXQtVolume::settingsChanged()
 
     m_volumeButton->setMuteOnMiddleClick(settings()->value(QStringLiteral(SETTINGS_MUTE_ON_MIDDLECLICK), SETTINGS_DEFAULT_MUTE_ON_MIDDLECLICK).toBool());
     m_volumeButton->setMixerCommand(settings()->value(QStringLiteral(SETTINGS_MIXER_COMMAND), QStringLiteral(SETTINGS_DEFAULT_MIXER_COMMAND)).toString());
-    m_volumeButton->volumePopup()->setSliderStep(settings()->value(QStringLiteral(SETTINGS_STEP), SETTINGS_DEFAULT_STEP).toInt());
+    m_volumeButton->setSliderStep(settings()->value(QStringLiteral(SETTINGS_STEP), SETTINGS_DEFAULT_STEP).toInt());
     m_alwaysShowNotifications = settings()->value(QStringLiteral(SETTINGS_ALWAYS_SHOW_NOTIFICATIONS), SETTINGS_DEFAULT_ALWAYS_SHOW_NOTIFICATIONS).toBool();
     m_showKeyboardNotifications = settings()->value(QStringLiteral(SETTINGS_SHOW_KEYBOARD_NOTIFICATIONS), SETTINGS_DEFAULT_SHOW_KEYBOARD_NOTIFICATIONS).toBool()
                                   // in case the config file was edited manually (see LXQtVolumeConfiguration)
@@ -216,7 +216,7 @@ void LXQtVolume::handleSinkListChanged()
         if (m_engine->sinks().count() > 0)
         {
             m_defaultSink = m_engine->sinks().at(qBound(0, m_defaultSinkIndex, m_engine->sinks().count()-1));
-            m_volumeButton->volumePopup()->setDevice(m_defaultSink);
+            m_volumeButton->setDevice(m_defaultSink);
             connect(m_defaultSink, &AudioDevice::volumeChanged, this, [this] { LXQtVolume::showNotification(false); });
             connect(m_defaultSink, &AudioDevice::muteChanged, this, [this] { LXQtVolume::showNotification(false); });
 
@@ -38,9 +38,12 @@
 #include <XdgIcon>
 #include "../panel/ilxqtpanel.h"
 #include "../panel/ilxqtpanelplugin.h"
+#include "../panel/lxqtpanellazypopup.h"
 
 VolumeButton::VolumeButton(ILXQtPanelPlugin *plugin, QWidget* parent):
         QToolButton(parent),
+        m_device(nullptr),
+        m_sliderStep(1),
         mPlugin(plugin),
         m_muteOnMiddleClick(true)
 {
@@ -51,20 +54,71 @@ VolumeButton::VolumeButton(ILXQtPanelPlugin *plugin, QWidget* parent):
     // In the worst case - no soundcard/pulse - is found it remains
     // in the button but at least the button is not blank ("invisible")
     handleStockIconChanged(QStringLiteral("dialog-error"));
-    m_volumePopup = new VolumePopup(this);
+
+    // the popup is built on the first hover/click and released when unused
+    m_volumePopup = new LXQtPanelLazyPopup(this);
+    m_volumePopup->setTrigger(this);
+    m_volumePopup->setFactory([this] { return createVolumePopup(); });
 
     m_popupHideTimer.setInterval(1000);
     connect(this,              &VolumeButton::clicked, this, &VolumeButton::toggleVolumeSlider);
     connect(&m_popupHideTimer, &QTimer::timeout,       this, &VolumeButton::hideVolumeSlider);
+}
+
+VolumeButton::~VolumeButton() = default;
 
-    connect(m_volumePopup, &VolumePopup::mouseEntered, &m_popupHideTimer, &QTimer::stop);
-    connect(m_volumePopup, &VolumePopup::mouseLeft,    this, [this] { m_popupHideTimer.start(); } );
+VolumePopup *VolumeButton::createVolumePopup()
+{
+    VolumePopup *popup = new VolumePopup(this);
+    popup->setSliderStep(m_sliderStep);
+    popup->setDevice(m_device);
+
+    connect(popup, &VolumePopup::mouseEntered, &m_popupHideTimer, &QTimer::stop);
+    connect(popup, &VolumePopup::mouseLeft,    this, [this] { m_popupHideTimer.start(); } );
 
-    connect(m_volumePopup, &VolumePopup::launchMixer,      this, &VolumeButton::handleMixerLaunch);
-    connect(m_volumePopup, &VolumePopup::stockIconChanged, this, &VolumeButton::handleStockIconChanged);
+    connect(popup, &VolumePopup::launchMixer,  this, &VolumeButton::handleMixerLaunch);
+    return popup;
 }
 
-VolumeButton::~VolumeButton() = default;
+void VolumeButton::setDevice(AudioDevice *device)
+{
+    if (device == m_device)
+        return;
+
+    // disconnect old device
+    if (m_device)
+        disconnect(m_device, nullptr, this, nullptr);
+
+    m_device = device;
+
+    if (m_device) {
+        handleDeviceVolumeChanged(m_device->volume());
+        connect(m_device, &AudioDevice::volumeChanged, this, &VolumeButton::handleDeviceVolumeChanged);
+        connect(m_device, &AudioDevice::muteChanged,   this, &VolumeButton::updateStockIcon);
+    }
+
+    if (VolumePopup *popup = m_volumePopup->createdWidget<VolumePopup>())
+        popup->setDevice(m_device);
+}
+
+void VolumeButton::setSliderStep(int step)
+{
+    m_sliderStep = step;
+    if (VolumePopup *popup = m_volumePopup->createdWidget<VolumePopup>())
+        popup->setSliderStep(step);
+}
+
+void VolumeButton::handleDeviceVolumeChanged(int volume)
+{
+    setToolTip(QStringLiteral("%1%").arg(volume));
+    updateStockIcon();
+}
+
+void VolumeButton::updateStockIcon()
+{
+    if (m_device)
+        handleStockIconChanged(VolumePopup::stockIconName(m_device));
+}
 
 void VolumeButton::setMuteOnMiddleClick(bool state)
 {
@@ -93,14 +147,24 @@ void VolumeButton::mouseMoveEvent(QMouseEvent *event)
 
 void VolumeButton::wheelEvent(QWheelEvent *event)
 {
-    m_volumePopup->handleWheelEvent(event);
+    if (VolumePopup *popup = m_volumePopup->createdWidget<VolumePopup>()) {
+        popup->handleWheelEvent(event);
+        return;
+    }
+
+    // no need to build the popup, the same as VolumePopup::handleWheelEvent() does
+    if (!m_device)
+        return;
+    m_device->setVolume(qBound(0, m_device->volume()
+            + (event->angleDelta().y() / QWheelEvent::DefaultDeltasPerStep * m_sliderStep), 100));
+    QToolTip::showText(event->globalPosition().toPoint(), toolTip(), this);
 }
 
 void VolumeButton::mouseReleaseEvent(QMouseEvent *event)
 {
     if (event->button() == Qt::MiddleButton && m_muteOnMiddleClick) {
-        if (m_volumePopup->device()) {
-            m_volumePopup->device()->toggleMute();
+        if (m_device) {
+            m_device->toggleMute();
             return;
         }
     }
@@ -110,7 +174,8 @@ void VolumeButton::mouseReleaseEvent(QMouseEvent *event)
 
 void VolumeButton::toggleVolumeSlider()
 {
-    if (m_volumePopup->isVisible()) {
+    VolumePopup *popup = m_volumePopup->createdWidget<VolumePopup>();
+    if (popup && popup->isVisible()) {
         hideVolumeSlider();
     } else {
         showVolumeSlider();
@@ -119,24 +184,25 @@ void VolumeButton::toggleVolumeSlider()
 
 void VolumeButton::showVolumeSlider()
 {
-
-    if (m_volumePopup->isVisible())
+    VolumePopup *popup = m_volumePopup->widget<VolumePopup>();
+    if (popup->isVisible())
         return;
 
     m_popupHideTimer.stop();
-    m_volumePopup->updateGeometry();
-    m_volumePopup->adjustSize();
-    QRect pos = mPlugin->calculatePopupWindowPos(m_volumePopup->size());
-    mPlugin->willShowWindow(m_volumePopup);
-    m_volumePopup->openAt(pos.topLeft(), Qt::TopLeftCorner);
-    m_volumePopup->activateWindow();
+    popup->updateGeometry();
+    popup->adjustSize();
+    QRect pos = mPlugin->calculatePopupWindowPos(popup->size());
+    mPlugin->willShowWindow(popup);
+    popup->openAt(pos.topLeft(), Qt::TopLeftCorner);
+    popup->activateWindow();
 }
 
 void VolumeButton::hideVolumeSlider()
 {
     // qDebug() << "hideVolumeSlider";
     m_popupHideTimer.stop();
-    m_volumePopup->hide();
+    if (VolumePopup *popup = m_volumePopup->createdWidget<VolumePopup>())
+        popup->hide();
 }
 
 void VolumeButton::handleMixerLaunch()
@@ -32,7 +32,9 @@
 #include <QTimer>
 
 class VolumePopup;
+class AudioDevice;
 class ILXQtPanelPlugin;
+class LXQtPanelLazyPopup;
 
 class VolumeButton : public QToolButton
 {
@@ -44,7 +46,9 @@ public:
     void setMuteOnMiddleClick(bool state);
     void setMixerCommand(const QString &command);
 
-    VolumePopup *volumePopup() const { return m_volumePopup; }
+    AudioDevice *device() const { return m_device; }
+    void setDevice(AudioDevice *device);
+    void setSliderStep(int step);
 
 public slots:
     void hideVolumeSlider();
@@ -60,9 +64,15 @@ private slots:
     void toggleVolumeSlider();
     void handleMixerLaunch();
     void handleStockIconChanged(const QString &iconName);
+    void handleDeviceVolumeChanged(int volume);
+    void updateStockIcon();
 
 private:
-    VolumePopup *m_volumePopup;
+    VolumePopup *createVolumePopup();
+
+    LXQtPanelLazyPopup *m_volumePopup; //!< the VolumePopup, built when needed
+    AudioDevice *m_device;
+    int m_sliderStep;
     ILXQtPanelPlugin *mPlugin;
     QTimer m_popupHideTimer;
     bool m_muteOnMiddleClick;
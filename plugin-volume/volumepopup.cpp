@@ -147,7 +147,6 @@ void VolumePopup::handleDeviceVolumeChanged(int volume)
     m_volumeSlider->blockSignals(true);
     m_volumeSlider->setValue(volume);
     m_volumeSlider->setToolTip(QStringLiteral("%1%").arg(volume));
-    dynamic_cast<QWidget&>(*parent()).setToolTip(m_volumeSlider->toolTip()); //parent is the button on panel
     m_volumeSlider->blockSignals(false);
 
     // emit volumeChanged(percent);
@@ -165,19 +164,23 @@ void VolumePopup::updateStockIcon()
     if (!m_device)
         return;
 
+    m_muteToggleButton->setIcon(XdgIcon::fromTheme(stockIconName(m_device)));
+}
+
+QString VolumePopup::stockIconName(const AudioDevice *device)
+{
     QString iconName;
-    if (m_device->volume() <= 0 || m_device->mute())
+    if (device->volume() <= 0 || device->mute())
         iconName = QLatin1String("audio-volume-muted");
-    else if (m_device->volume() <= 33)
+    else if (device->volume() <= 33)
         iconName = QLatin1String("audio-volume-low");
-    else if (m_device->volume() <= 66)
+    else if (device->volume() <= 66)
         iconName = QLatin1String("audio-volume-medium");
     else
         iconName = QLatin1String("audio-volume-high");
 
     iconName.append(QLatin1String("-panel"));
-    m_muteToggleButton->setIcon(XdgIcon::fromTheme(iconName));
-    emit stockIconChanged(iconName);
+    return iconName;
 }
 
 void VolumePopup::resizeEvent(QResizeEvent *event)
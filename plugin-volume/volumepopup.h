@@ -49,6 +49,8 @@ public:
     void setDevice(AudioDevice *device);
     void setSliderStep(int step);
 
+    static QString stockIconName(const AudioDevice *device);
+
 signals:
     void mouseEntered();
     void mouseLeft();
@@ -56,7 +58,6 @@ signals:
     // void volumeChanged(int value);
     void deviceChanged();
     void launchMixer();
-    void stockIconChanged(const QString &iconName);
 
 protected:
     void resizeEvent(QResizeEvent *event) override;
@@ -27,6 +27,7 @@
  * END_COMMON_COPYRIGHT_HEADER */
 
 #include "lxqtworldclock.h"
+#include "../panel/lxqtpanellazypopup.h"
 
 #include <LXQt/Globals>
 
@@ -50,8 +51,7 @@ LXQtWorldClock::LXQtWorldClock(const ILXQtPanelPluginStartupInfo &startupInfo):
     mUpdateInterval(1),
     mAutoRotate(true),
     mShowWeekNumber(true),
-    mShowTooltip(false),
-    mPopupContent(nullptr)
+    mShowTooltip(false)
 {
     mMainWidget = new QWidget();
     mMainWidget->installEventFilter(this);
@@ -67,6 +67,25 @@ LXQtWorldClock::LXQtWorldClock(const ILXQtPanelPluginStartupInfo &startupInfo):
 
     mContent->setAlignment(Qt::AlignCenter);
 
+    // the popups are built when needed (the calendar also on hover) and released when unused
+    mCalendarPopup = new LXQtPanelLazyPopup(this);
+    mCalendarPopup->setTrigger(mMainWidget);
+    mCalendarPopup->setFactory([this] {
+        LXQtWorldClockPopup *popup = createPopup();
+        popup->setObjectName(QLatin1String("WorldClockCalendar"));
+        popup->layout()->setContentsMargins(0, 0, 0, 0);
+        popup->layout()->addWidget(new QCalendarWidget(popup));
+        return popup;
+    });
+
+    mTimeZonesPopup = new LXQtPanelLazyPopup(this);
+    mTimeZonesPopup->setFactory([this] {
+        LXQtWorldClockPopup *popup = createPopup();
+        popup->setObjectName(QLatin1String("WorldClockPopup"));
+        popup->layout()->addWidget(new QLabel(popup));
+        return popup;
+    });
+
     settingsChanged();
 
     mTimer->setTimerType(Qt::PreciseTimer);
@@ -392,18 +411,12 @@ void LXQtWorldClock::activated(ActivationReason reason)
 
     if (!mPopup)
     {
-        mPopup = new LXQtWorldClockPopup(mContent);
-        connect(mPopup, &LXQtWorldClockPopup::deactivated, this, &LXQtWorldClock::deletePopup);
-
         if (reason == ILXQtPanelPlugin::Trigger)
         {
-            mPopup->setObjectName(QLatin1String("WorldClockCalendar"));
+            mPopup = mCalendarPopup->widget<LXQtWorldClockPopup>();
 
-            mPopup->layout()->setContentsMargins(0, 0, 0, 0);
-            QCalendarWidget *calendarWidget = new QCalendarWidget(mPopup);
-            if (!mShowWeekNumber)
-                calendarWidget->setVerticalHeaderFormat(QCalendarWidget::NoVerticalHeader);
-            mPopup->layout()->addWidget(calendarWidget);
+            QCalendarWidget *calendarWidget = mPopup->findChild<QCalendarWidget *>();
+            calendarWidget->setVerticalHeaderFormat(mShowWeekNumber ? QCalendarWidget::ISOWeekNumbers : QCalendarWidget::NoVerticalHeader);
 
             QString timeZoneName = mActiveTimeZone;
             if (timeZoneName == QLatin1String("local"))
@@ -415,11 +428,8 @@ void LXQtWorldClock::activated(ActivationReason reason)
         }
         else
         {
-            mPopup->setObjectName(QLatin1String("WorldClockPopup"));
-
-            mPopupContent = new QLabel(mPopup);
-            mPopup->layout()->addWidget(mPopupContent);
-            mPopupContent->setAlignment(mContent->alignment());
+            mPopup = mTimeZonesPopup->widget<LXQtWorldClockPopup>();
+            mPopup->findChild<QLabel *>()->setAlignment(mContent->alignment());
 
             updatePopupContent();
         }
@@ -432,15 +442,15 @@ void LXQtWorldClock::activated(ActivationReason reason)
     }
     else
     {
-        deletePopup();
+        mPopup->close();
     }
 }
 
-void LXQtWorldClock::deletePopup()
+LXQtWorldClockPopup *LXQtWorldClock::createPopup()
 {
-    mPopupContent = nullptr;
-    mPopup->deleteLater();
-    mPopup = nullptr;
+    LXQtWorldClockPopup *popup = new LXQtWorldClockPopup(mContent);
+    connect(popup, &LXQtWorldClockPopup::deactivated, this, [this] { mPopup = nullptr; });
+    return popup;
 }
 
 QString LXQtWorldClock::formatDateTime(const QDateTime &datetime, const QString &timeZoneName)
@@ -452,7 +462,8 @@ QString LXQtWorldClock::formatDateTime(const QDateTime &datetime, const QString
 
 void LXQtWorldClock::updatePopupContent()
 {
-    if (mPopupContent)
+    QWidget *popup = mTimeZonesPopup->createdWidget();
+    if (QLabel *popupContent = popup ? popup->findChild<QLabel *>() : nullptr)
     {
         QDateTime now = QDateTime::currentDateTime();
         QStringList allTimeZones;
@@ -471,7 +482,7 @@ void LXQtWorldClock::updatePopupContent()
             allTimeZones.append(formatted);
         }
 
-        mPopupContent->setText(allTimeZones.join(QLatin1String("<hr/>")));
+        popupContent->setText(allTimeZones.join(QLatin1String("<hr/>")));
     }
 }
 
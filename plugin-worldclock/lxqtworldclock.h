@@ -44,6 +44,7 @@
 class ActiveLabel;
 class QTimer;
 class LXQtWorldClockPopup;
+class LXQtPanelLazyPopup;
 
 
 class LXQtWorldClock : public QObject, public ILXQtPanelPlugin
@@ -67,14 +68,15 @@ public:
 private slots:
     void timeout();
     void wheelScrolled(int);
-    void deletePopup();
     void updateTimeText();
 
 private:
     QWidget *mMainWidget;
     LXQt::RotatedWidget* mRotatedWidget;
     ActiveLabel *mContent;
-    LXQtWorldClockPopup* mPopup;
+    LXQtWorldClockPopup* mPopup; //!< the shown popup (if any)
+    LXQtPanelLazyPopup *mCalendarPopup;
+    LXQtPanelLazyPopup *mTimeZonesPopup;
 
     QTimer *mTimer;
     int mUpdateInterval;
@@ -88,12 +90,13 @@ private:
     bool mAutoRotate;
     bool mShowWeekNumber;
     bool mShowTooltip;
-    QLabel *mPopupContent;
 
     QDateTime mShownTime;
 
     void restartTimer();
 
+    LXQtWorldClockPopup *createPopup();
+
     void setTimeText();
     QString formatDateTime(const QDateTime &datetime, const QString &timeZoneName);
     void updatePopupContent();
@@ -0,0 +1,258 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt.org
+ *
+ * Copyright: 2026 LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "lxqtpanellayout.h"
+#include "pluginplaceholder.h"
+
+#include <QTest>
+#include <QWidget>
+
+namespace
+{
+constexpr int LINE_SIZE = 32;
+
+// the plugins have different lengths along the panel
+QSize itemSize(int index, bool horizontal, int variant = 0)
+{
+    const int length = LINE_SIZE + ((index + variant) % 7) * 8;
+    return horizontal ? QSize(length, LINE_SIZE) : QSize(LINE_SIZE, length);
+}
+}
+
+/*!
+ * \brief Stands for a plugin in the benchmarks, like the placeholders of the
+ * plugins being loaded, except that its size can change.
+ */
+class BenchPlaceholder : public PluginPlaceholder
+{
+public:
+    BenchPlaceholder(int index, bool horizontal, QWidget *parent)
+        : PluginPlaceholder(QStringLiteral("plugin%1").arg(index),
+                            // about a third of the plugins on the right
+                            index % 3 == 2 ? Plugin::AlignRight : Plugin::AlignLeft,
+                            itemSize(index, horizontal),
+                            parent),
+          mSize(itemSize(index, horizontal))
+    {
+        // a few taskbars and spacers, and a few plugins on a line of their own
+        setExpandable(index % 7 == 3);
+        setSeparate(index % 5 == 4);
+    }
+
+    QSize sizeHint() const override { return mSize; }
+    void setSize(const QSize &size)
+    {
+        mSize = size;
+        updateGeometry();
+    }
+
+private:
+    QSize mSize;
+};
+
+/*!
+ * \brief Benchmarks of LXQtPanelLayout, with N placeholders of plugins (left
+ * and right aligned, some expandable or separate) on 1 to 4 lines of
+ * horizontal and vertical panels.
+ *
+ * Run lxqt-panel-layout-bench, see QTest for the options (e.g. -callgrind,
+ * -iterations).
+ */
+class LayoutBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void addItems_data() { cases(); }
+    void addItems();
+    void relayoutOne_data() { cases(); }
+    void relayoutOne();
+    void rebuild_data() { cases(); }
+    void rebuild();
+    void sizeHint_data() { cases(); }
+    void sizeHint();
+    void moveItem_data() { cases(); }
+    void moveItem();
+
+private:
+    static void cases();
+    static void setUp(QWidget *panel, LXQtPanelLayout *layout, int items, int lines, bool horizontal);
+    static QRect panelGeometry(const LXQtPanelLayout *layout, int lines);
+};
+
+void LayoutBench::cases()
+{
+    QTest::addColumn<int>("items");
+    QTest::addColumn<int>("lines");
+    QTest::addColumn<bool>("horizontal");
+
+    for (const int items : {10, 50, 200})
+    {
+        for (const int lines : {1, 2, 4})
+        {
+            for (const bool horizontal : {true, false})
+            {
+                QTest::addRow("%d items, %d lines, %s", items, lines, horizontal ? "horizontal" : "vertical")
+                    << items << lines << horizontal;
+            }
+        }
+    }
+}
+
+void LayoutBench::setUp(QWidget *panel, LXQtPanelLayout *layout, int items, int lines, bool horizontal)
+{
+    layout->setPosition(horizontal ? ILXQtPanel::PositionBottom : ILXQtPanel::PositionLeft);
+    layout->setLineSize(LINE_SIZE);
+    layout->setLineCount(lines);
+    for (int i = 0; i < items; ++i)
+        layout->addPlaceholder(new BenchPlaceholder(i, horizontal, panel));
+}
+
+QRect LayoutBench::panelGeometry(const LXQtPanelLayout *layout, int lines)
+{
+    const QSize size = layout->sizeHint();
+    return layout->isHorizontal() ? QRect(0, 0, size.width(), lines * LINE_SIZE)
+                                  : QRect(0, 0, lines * LINE_SIZE, size.height());
+}
+
+// the startup: the items are added one by one, then laid out
+void LayoutBench::addItems()
+{
+    QFETCH(int, items);
+    QFETCH(int, lines);
+    QFETCH(bool, horizontal);
+
+    QBENCHMARK
+    {
+        QWidget panel;
+        LXQtPanelLayout *layout = new LXQtPanelLayout(&panel);
+        setUp(&panel, layout, items, lines, horizontal);
+        layout->setGeometry(panelGeometry(layout, lines));
+    }
+}
+
+// a plugin in the middle changes its size (e.g. a task button, a clock)
+void LayoutBench::relayoutOne()
+{
+    QFETCH(int, items);
+    QFETCH(int, lines);
+    QFETCH(bool, horizontal);
+
+    QWidget panel;
+    LXQtPanelLayout *layout = new LXQtPanelLayout(&panel);
+    setUp(&panel, layout, items, lines, horizontal);
+    layout->setGeometry(panelGeometry(layout, lines));
+
+    const int index = items / 2;
+    BenchPlaceholder *item = static_cast<BenchPlaceholder *>(layout->itemAt(index)->widget());
+    int variant = 0;
+    QBENCHMARK
+    {
+        item->setSize(itemSize(index, horizontal, ++variant));
+        layout->invalidate();
+        layout->setGeometry(panelGeometry(layout, lines));
+    }
+}
+
+// the flags of a plugin change, the grids are built again
+void LayoutBench::rebuild()
+{
+    QFETCH(int, items);
+    QFETCH(int, lines);
+    QFETCH(bool, horizontal);
+
+    QWidget panel;
+    LXQtPanelLayout *layout = new LXQtPanelLayout(&panel);
+    setUp(&panel, layout, items, lines, horizontal);
+    layout->setGeometry(panelGeometry(layout, lines));
+
+    QBENCHMARK
+    {
+        layout->rebuild();
+        layout->setGeometry(panelGeometry(layout, lines));
+    }
+}
+
+// the panel asks for the size of the layout after a change, both grids are updated
+void LayoutBench::sizeHint()
+{
+    QFETCH(int, items);
+    QFETCH(int, lines);
+    QFETCH(bool, horizontal);
+
+    QWidget panel;
+    LXQtPanelLayout *layout = new LXQtPanelLayout(&panel);
+    setUp(&panel, layout, items, lines, horizontal);
+    layout->setGeometry(panelGeometry(layout, lines));
+
+    QSize size;
+    QBENCHMARK
+    {
+        layout->invalidate();
+        size = layout->sizeHint();
+    }
+    QVERIFY(size.isValid());
+}
+
+// a plugin is dragged within its grid, then to the other one, and back
+void LayoutBench::moveItem()
+{
+    QFETCH(int, items);
+    QFETCH(int, lines);
+    QFETCH(bool, horizontal);
+
+    QWidget panel;
+    LXQtPanelLayout *layout = new LXQtPanelLayout(&panel);
+    setUp(&panel, layout, items, lines, horizontal);
+    layout->setGeometry(panelGeometry(layout, lines));
+
+    const int last = layout->count() - 1;
+    int leftCount = 0;
+    while (static_cast<PluginPlaceholder *>(layout->itemAt(leftCount)->widget())->alignment() == Plugin::AlignLeft)
+        ++leftCount;
+    QVERIFY(leftCount >= 2 && leftCount <= last);
+
+    const auto move = [layout, lines] (int from, int to) {
+        layout->moveItem(from, to);
+        layout->setGeometry(panelGeometry(layout, lines));
+    };
+
+    QBENCHMARK
+    {
+        // within the left grid, within the right one
+        move(0, leftCount - 1);
+        move(leftCount - 1, 0);
+        move(leftCount, last);
+        move(last, leftCount);
+        // from the left grid to the end of the right one, and back
+        move(0, last);
+        move(last, 0);
+    }
+    QCOMPARE(layout->count(), items);
+}
+
+QTEST_MAIN(LayoutBench)
+
+#include "layoutbench.moc"
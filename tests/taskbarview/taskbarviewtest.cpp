@@ -0,0 +1,223 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt.org
+ *
+ * Copyright: 2026 LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "lxqtpanelapplication.h"
+#include "backends/lxqttaskbarsyntheticbackend.h"
+#include "plugin-taskbar/lxqttaskbarproxymodel.h"
+#include "plugin-taskbar/lxqttaskbarview.h"
+
+#include <QApplication>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+/*!
+ * \brief Tests of the rows shown by LXQtTaskBarView when windows move between
+ * groups (their class changes) and between workspaces.
+ *
+ * It runs a panel with a private configuration: a single lightweight taskbar
+ * grouping the windows and showing only the ones of the current workspace.
+ * The windows are made with LXQtTaskBarSyntheticBackend.
+ */
+class TaskBarViewTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanup();
+    void moveBetweenGroups();
+    void moveBetweenWorkspaces();
+    void addToHiddenGroup();
+
+private:
+    bool isShown(WId window) const;
+    static void flush();
+
+    LXQtTaskBarSyntheticBackend *mBackend = nullptr;
+    LXQtTaskBarView *mView = nullptr;
+    LXQtTaskBarProxyModel *mModel = nullptr;
+};
+
+void TaskBarViewTest::initTestCase()
+{
+    auto *app = static_cast<LXQtPanelApplication *>(qApp);
+    mBackend = static_cast<LXQtTaskBarSyntheticBackend *>(app->getWMBackend());
+    mBackend->setWorkspacesCount(2);
+    mBackend->setCurrentWorkspace(1);
+
+    // the plugins are loaded from the event loop
+    const auto findView = [] () -> LXQtTaskBarView * {
+        const auto widgets = QApplication::topLevelWidgets();
+        for (QWidget *widget : widgets)
+        {
+            if (auto *view = widget->findChild<LXQtTaskBarView *>())
+                return view;
+        }
+        return nullptr;
+    };
+    QTRY_VERIFY((mView = findView()) != nullptr);
+    mModel = qobject_cast<LXQtTaskBarProxyModel *>(mView->model());
+    QVERIFY(mModel);
+}
+
+void TaskBarViewTest::cleanup()
+{
+    const auto windows = mBackend->getCurrentWindows();
+    for (const WId window : windows)
+        mBackend->removeWindow(window);
+    mBackend->setCurrentWorkspace(1);
+    flush();
+    QCOMPARE(mModel->rowCount(), 0);
+}
+
+void TaskBarViewTest::moveBetweenGroups()
+{
+    const WId a1 = mBackend->addWindow(QStringLiteral("a"), QStringLiteral("a1"));
+    const WId b1 = mBackend->addWindow(QStringLiteral("b"), QStringLiteral("b1"));
+    mBackend->setWindowOnWorkspace(b1, 2);
+    flush();
+    QVERIFY(isShown(a1));
+    QVERIFY(!isShown(b1));
+
+    // a1 joins the group of b1, which has a window on this workspace now
+    mBackend->setWindowClass(a1, QStringLiteral("b"));
+    flush();
+    QCOMPARE(mModel->rowOfWindow(a1), mModel->rowOfWindow(b1));
+    QCOMPARE(mModel->rowCount(), 1);
+    QVERIFY(isShown(b1));
+
+    // and leaves it for a new group
+    mBackend->setWindowClass(a1, QStringLiteral("a"));
+    flush();
+    QCOMPARE(mModel->rowCount(), 2);
+    QVERIFY(isShown(a1));
+    QVERIFY(!isShown(b1));
+
+    // then for an existing one, hidden too
+    const WId c1 = mBackend->addWindow(QStringLiteral("c"), QStringLiteral("c1"));
+    mBackend->setWindowOnWorkspace(c1, 2);
+    mBackend->setWindowClass(a1, QStringLiteral("b"));
+    flush();
+    QVERIFY(isShown(b1));
+    QVERIFY(!isShown(c1));
+    mBackend->setWindowClass(a1, QStringLiteral("c"));
+    flush();
+    QCOMPARE(mModel->rowCount(), 2);
+    QVERIFY(!isShown(b1));
+    QVERIFY(isShown(c1));
+}
+
+void TaskBarViewTest::moveBetweenWorkspaces()
+{
+    const WId a1 = mBackend->addWindow(QStringLiteral("a"), QStringLiteral("a1"));
+    const WId a2 = mBackend->addWindow(QStringLiteral("a"), QStringLiteral("a2"));
+    flush();
+    QCOMPARE(mModel->rowOfWindow(a1), mModel->rowOfWindow(a2));
+    QVERIFY(isShown(a1));
+
+    // shown as long as one of the windows of the group is
+    mBackend->setWindowOnWorkspace(a1, 2);
+    flush();
+    QVERIFY(isShown(a1));
+    mBackend->setWindowOnWorkspace(a2, 2);
+    flush();
+    QVERIFY(!isShown(a1));
+    mBackend->setWindowOnWorkspace(a1, 1);
+    flush();
+    QVERIFY(isShown(a1));
+
+    mBackend->setCurrentWorkspace(2);
+    flush();
+    QVERIFY(isShown(a1));
+    mBackend->setWindowOnWorkspace(a2, 1);
+    flush();
+    QVERIFY(!isShown(a1));
+}
+
+void TaskBarViewTest::addToHiddenGroup()
+{
+    const WId a1 = mBackend->addWindow(QStringLiteral("a"), QStringLiteral("a1"));
+    mBackend->setWindowOnWorkspace(a1, 2);
+    flush();
+    QVERIFY(!isShown(a1));
+
+    const WId a2 = mBackend->addWindow(QStringLiteral("a"), QStringLiteral("a2"));
+    flush();
+    QCOMPARE(mModel->rowOfWindow(a1), mModel->rowOfWindow(a2));
+    QVERIFY(isShown(a1));
+
+    mBackend->removeWindow(a2);
+    flush();
+    QVERIFY(!isShown(a1));
+}
+
+bool TaskBarViewTest::isShown(WId window) const
+{
+    const int row = mModel->rowOfWindow(window);
+    return row != -1 && !mView->isRowHidden(row);
+}
+
+void TaskBarViewTest::flush()
+{
+    // the changes of the windows are announced from the event loop
+    QCoreApplication::processEvents();
+}
+
+int main(int argc, char *argv[])
+{
+    // never the configuration of the user
+    QTemporaryDir configDir;
+    const QString configFile = configDir.filePath(QStringLiteral("panel.conf"));
+    {
+        QFile file(configFile);
+        if (!configDir.isValid() || !file.open(QIODevice::WriteOnly | QIODevice::Text))
+        {
+            qWarning("Cannot write the panel configuration %s", qPrintable(configFile));
+            return 1;
+        }
+        file.write("panels=panel1\n"
+                   "\n"
+                   "[panel1]\n"
+                   "plugins=taskbar\n"
+                   "\n"
+                   "[taskbar]\n"
+                   "type=taskbar\n"
+                   "lightweightView=true\n"
+                   "groupingEnabled=true\n"
+                   "showOnlyOneDesktopTasks=true\n");
+    }
+
+    QByteArray configArg = configFile.toLocal8Bit();
+    char configOption[] = "--config";
+    char *panelArgv[] = {argv[0], configOption, configArg.data(), nullptr};
+    int panelArgc = 3;
+    LXQtPanelApplication app(panelArgc, panelArgv);
+
+    TaskBarViewTest test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "taskbarviewtest.moc"